@@ -116,6 +116,8 @@ static const wxChar MaxFileSystemWatchers[] = wxT( "MaxFileSystemWatchers" );
 static const wxChar MinorSchematicGraphSize[] = wxT( "MinorSchematicGraphSize" );
 static const wxChar ResolveTextRecursionDepth[] = wxT( "ResolveTextRecursionDepth" );
 static const wxChar ZoneConnectionFiller[] = wxT( "ZoneConnectionFiller" );
+static const wxChar SymbolLibLazyLoadSize[] = wxT( "SymbolLibLazyLoadSize" );
+static const wxChar TiledBooleanMinVertices[] = wxT( "TiledBooleanMinVertices" );
 
 } // namespace KEYS
 
@@ -280,6 +282,10 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_ZoneConnectionFiller = false;
 
+    m_SymbolLibLazyLoadSize = 16;
+
+    m_TiledBooleanMinVertices = 0;
+
     loadFromConfigFile();
 }
 
@@ -520,6 +526,14 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneConnectionFiller,
                                                 &m_ZoneConnectionFiller, m_ZoneConnectionFiller ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::SymbolLibLazyLoadSize,
+                                                  &m_SymbolLibLazyLoadSize,
+                                                  m_SymbolLibLazyLoadSize, 0, 2147483647 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::TiledBooleanMinVertices,
+                                                  &m_TiledBooleanMinVertices,
+                                                  m_TiledBooleanMinVertices, 0, 2147483647 ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks;
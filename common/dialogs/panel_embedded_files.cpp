@@ -290,6 +290,16 @@ void PANEL_EMBEDDED_FILES::onExportFiles( wxCommandEvent& event )
         if( skip_file )
             continue;
 
+        if( !file->EnsureDecompressed() )
+        {
+            wxString msg = wxString::Format( _( "Embedded file '%s' is corrupted." ),
+                        file->name );
+
+            KIDIALOG errorDlg( m_parent, msg, _( "Error" ), wxOK | wxICON_ERROR );
+            errorDlg.ShowModal();
+            continue;
+        }
+
         wxFFile ffile( fileName.GetFullPath(), wxT( "w" ) );
 
         if( !ffile.IsOpened() )
@@ -48,6 +48,7 @@ void DSNLEXER::init()
     commentsAreTokens = false;
 
     curOffset = 0;
+    curTextIsView = false;
 }
 
 
@@ -178,7 +179,8 @@ bool DSNLEXER::SyncLineReaderWith( DSNLEXER& aLexer )
 
     // Sync these parameters is not mandatory, but could help
     // for instance in debug
-    curText = aLexer.curText;
+    curText = aLexer.CurStr();
+    curTextIsView = false;
     curOffset = aLexer.curOffset;
 
     return true;
@@ -540,6 +542,9 @@ int DSNLEXER::NextTok()
     if( cur >= limit )
     {
 L_read:
+        // The current token may be a view of the line we're about to replace
+        CurStr();
+
         // blank lines are returned as "\n" and will have a len of 1.
         // EOF will have a len of 0 and so is detectable.
         int len = readLine();
@@ -571,6 +576,7 @@ L_read:
 
                 curText.clear();
                 curText.append( start, limit );
+                curTextIsView = false;
 
                 cur     = start;        // ensure a good curOffset below
                 curTok  = DSN_COMMENT;
@@ -593,9 +599,12 @@ L_read:
     if( cur >= limit )
         goto L_read;
 
+    // Each branch below either fills curText or makes the token a view with setCurView()
+    curTextIsView = false;
+
     if( *cur == '(' )
     {
-        curText = *cur;
+        setCurView( cur, cur+1 );
         curTok = DSN_LEFT;
         head = cur+1;
         goto exit;
@@ -603,7 +612,7 @@ L_read:
 
     if( *cur == ')' )
     {
-        curText = *cur;
+        setCurView( cur, cur+1 );
         curTok = DSN_RIGHT;
         head = cur+1;
         goto exit;
@@ -611,7 +620,7 @@ L_read:
 
     if( *cur == '|' )
     {
-        curText = *cur;
+        setCurView( cur, cur+1 );
         curTok = DSN_BAR;
         head = cur+1;
         goto exit;
@@ -787,19 +796,20 @@ L_read:
         }
     }           // specctraMode
 
-    // non-quoted token, read it into curText.
-    curText.clear();
-
+    // non-quoted token; numbers are left in the line, anything else is read into curText.
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    if( isNumber( cur, head ) )
     {
+        setCurView( cur, head );
         curTok = DSN_NUMBER;
         goto exit;
     }
 
+    curText.assign( cur, head );
+
     if( specctraMode && curText == "string_quote" )
     {
         curTok = DSN_STRING_QUOTE;
@@ -841,6 +851,87 @@ wxArrayString* DSNLEXER::ReadCommentLines()
 }
 
 
+int DSNLEXER::ReadRawList( std::string& aText )
+{
+    wxASSERT( !specctraMode );
+
+    int         lineNumber = CurLineNumber();
+    const char* cur = start + curOffset;   // the list's keyword
+    int         depth = 1;
+
+    // Keep the keyword's column so offsets reported by the other lexer stay meaningful
+    aText.assign( curOffset > 0 ? curOffset - 1 : 0, ' ' );
+    aText += '(';
+
+    // The current token may be a view of a line we're about to replace
+    CurStr();
+
+    for( ;; )
+    {
+        const char* lineStart = cur;
+        bool        inString = false;
+
+        while( cur < limit && depth > 0 )
+        {
+            char cc = *cur++;
+
+            if( inString )
+            {
+                if( cc == '\\' && cur < limit )
+                    ++cur;
+                else if( cc == '"' )
+                    inString = false;
+            }
+            else if( cc == '"' )
+            {
+                inString = true;
+            }
+            else if( cc == '(' )
+            {
+                ++depth;
+            }
+            else if( cc == ')' )
+            {
+                --depth;
+            }
+        }
+
+        aText.append( lineStart, cur );
+
+        if( depth == 0 )
+            break;
+
+        if( readLine() == 0 )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unterminated list in\nfile: %s\nline: %d" ),
+                                              CurSource(), lineNumber ) );
+        }
+
+        cur = start;
+
+        const char* first = start;
+
+        while( first < limit && isSpace( *first ) )
+            ++first;
+
+        // Comment lines are copied but may contain unbalanced parentheses
+        if( first < limit && *first == '#' )
+        {
+            aText.append( start, limit );
+            cur = limit;
+        }
+    }
+
+    prevTok = curTok;
+    curTok = DSN_RIGHT;
+    setCurView( cur - 1, cur );
+    curOffset = cur - 1 - start;
+    next = cur;
+
+    return lineNumber;
+}
+
+
 double DSNLEXER::parseDouble()
 {
 #if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
@@ -875,11 +966,11 @@ double DSNLEXER::parseDouble()
 #else
     // Use std::from_chars which is designed to be locale independent and performance oriented for data interchange
 
-    const std::string& str = CurStr();
+    std::string_view str = CurView();
 
     // Offset any leading whitespace, this is one thing from_chars does not handle
     size_t woff = 0;
-    while( std::isspace( str[woff] ) && woff < str.length() )
+    while( woff < str.length() && std::isspace( str[woff] ) )
     {
         woff++;
     }
@@ -387,7 +387,8 @@ const std::map<wxString, double> EDA_PATTERN_MATCH_RELATIONAL::m_units = {
 
 EDA_COMBINED_MATCHER::EDA_COMBINED_MATCHER( const wxString& aPattern,
                                             COMBINED_MATCHER_CONTEXT aContext ) :
-        m_pattern( aPattern )
+        m_pattern( aPattern ),
+        m_literal( false )
 {
     switch( aContext )
     {
@@ -399,6 +400,11 @@ EDA_COMBINED_MATCHER::EDA_COMBINED_MATCHER( const wxString& aPattern,
         // If any of the above matchers couldn't be created because the pattern
         // syntax does not match, the substring will try its best.
         AddMatcher( aPattern, std::make_unique<EDA_PATTERN_MATCH_SUBSTR>() );
+
+        // Without regex or relational syntax, only the wildcard and substring matchers are
+        // created, and without wildcards both are a substring search.
+        m_literal = m_matchers.size() == 2
+                    && aPattern.find_first_of( wxS( "*?" ) ) == wxString::npos;
         break;
 
     case CTX_NET:
@@ -479,11 +485,7 @@ int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
 
     for( SEARCH_TERM& term : aWeightedTerms )
     {
-        if( !term.Normalized )
-        {
-            term.Text = term.Text.MakeLower().Trim( false ).Trim( true );
-            term.Normalized = true;
-        }
+        term.Normalize();
 
         int found_pos = EDA_PATTERN_NOT_FOUND;
         int matchers_fired = 0;
@@ -492,6 +494,17 @@ int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
         {
             score += 8 * term.Score;
         }
+        else if( m_literal )
+        {
+            // Same result as the matchers, without going through their (non reentrant)
+            // regular expressions
+            found_pos = term.Text.Find( m_pattern );
+
+            if( found_pos == 0 )
+                score += 2 * term.Score;
+            else if( found_pos != wxNOT_FOUND )
+                score += term.Score;
+        }
         else if( Find( term.Text, matchers_fired, found_pos ) )
         {
             if( found_pos == 0 )
@@ -513,7 +513,8 @@ EDA_TEXT::GetRenderCache( const KIFONT::FONT* aFont, const wxString& forResolved
 {
     if( aFont->IsOutline() )
     {
-        EDA_ANGLE resolvedAngle = GetDrawRotation();
+        EDA_ANGLE                   resolvedAngle = GetDrawRotation();
+        std::lock_guard<std::mutex> lock( m_render_cache_mutex );
 
         if( m_render_cache.empty()
                 || m_render_cache_font != aFont
@@ -571,6 +572,9 @@ BOX2I EDA_TEXT::GetTextBox( int aLine ) const
 {
     VECTOR2I drawPos = GetDrawPos();
 
+    // DRC providers and plotters may ask for the same text's box from several threads
+    std::lock_guard<std::mutex> lock( m_bounding_box_cache_mutex );
+
     if( m_bounding_box_cache_valid
             && m_bounding_box_cache_pos == drawPos
             && m_bounding_box_cache_line == aLine )
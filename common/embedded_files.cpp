@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 #include <zstd.h>
@@ -105,6 +106,23 @@ EMBEDDED_FILES::EMBEDDED_FILE* EMBEDDED_FILES::AddFile( const wxFileName& aName,
 }
 
 
+bool EMBEDDED_FILES::EMBEDDED_FILE::EnsureDecompressed()
+{
+    // Files are decoded on first use, which may happen from several threads at once.
+    static std::mutex decodeMutex;
+
+    std::lock_guard<std::mutex> lock( decodeMutex );
+
+    if( is_compressed_only )
+    {
+        is_compressed_only = false;
+        is_valid = DecompressAndDecode( *this ) == RETURN_CODE::OK;
+    }
+
+    return is_valid || !decompressedData.empty();
+}
+
+
 void EMBEDDED_FILES::AddFile( EMBEDDED_FILE* aFile )
 {
     m_files.insert( { aFile->name, aFile } );
@@ -324,15 +342,8 @@ void EMBEDDED_FILES_PARSER::ParseEmbedded( EMBEDDED_FILES* aFiles )
 
         if( file )
         {
-            if( !file->compressedEncodedData.empty() )
-            {
-                EMBEDDED_FILES::DecompressAndDecode( *file );
-
-                if( !file->Validate() )
-                    THROW_PARSE_ERROR( "Checksum error in embedded file " + file->name, CurSource(),
-                                        CurLine(), CurLineNumber(), CurOffset() );
-            }
-
+            // Decoded and checked against its checksum on first use.
+            file->is_compressed_only = !file->compressedEncodedData.empty();
             aFiles->AddFile( file.release() );
         }
 
@@ -432,15 +443,7 @@ void EMBEDDED_FILES_PARSER::ParseEmbedded( EMBEDDED_FILES* aFiles )
     // Add the last file in the collection
     if( file )
     {
-        if( !file->compressedEncodedData.empty() )
-        {
-            EMBEDDED_FILES::DecompressAndDecode( *file );
-
-            if( !file->Validate() )
-                THROW_PARSE_ERROR( "Checksum error in embedded file " + file->name, CurSource(),
-                                    CurLine(), CurLineNumber(), CurOffset() );
-        }
-
+        file->is_compressed_only = !file->compressedEncodedData.empty();
         aFiles->AddFile( file.release() );
     }
 }
@@ -477,6 +480,16 @@ wxFileName EMBEDDED_FILES::GetTemporaryFileName( const wxString& aName ) const
     if( cacheFile.FileExists() && cacheFile.IsFileReadable() )
         return cacheFile;
 
+    if( !it->second->EnsureDecompressed() )
+    {
+        wxLogTrace( wxT( "KICAD_EMBED" ),
+                    wxT( "%s:%s:%d\n * failed to decode embedded file '%s'" ),
+                    __FILE__, __FUNCTION__, __LINE__, aName );
+
+        cacheFile.Clear();
+        return cacheFile;
+    }
+
     wxFFileOutputStream out( cacheFile.GetFullPath() );
 
     if( !out.IsOk() )
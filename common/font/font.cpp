@@ -59,6 +59,11 @@ FONT* FONT::s_defaultFont = nullptr;
 
 std::map< std::tuple<wxString, bool, bool>, FONT*> FONT::s_fontMap;
 
+// Fonts are looked up from worker threads (when loading boards, for instance), so the lazily
+// built default font and font map are guarded.
+static std::once_flag s_defaultFontOnce;
+static std::mutex     s_fontMapMutex;
+
 class MARKUP_CACHE
 {
 public:
@@ -136,8 +141,11 @@ FONT::FONT()
 
 FONT* FONT::getDefaultFont()
 {
-    if( !s_defaultFont )
-        s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
+    std::call_once( s_defaultFontOnce,
+                    []()
+                    {
+                        s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
+                    } );
 
     return s_defaultFont;
 }
@@ -150,7 +158,8 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic, const
 
     std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
 
-    FONT* font = nullptr;
+    std::lock_guard<std::mutex> lock( s_fontMapMutex );
+    FONT*                       font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
         font = s_fontMap[key];
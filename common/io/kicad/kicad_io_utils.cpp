@@ -64,175 +64,206 @@ void FormatUuid( OUTPUTFORMATTER* aOut, const KIID& aUuid, char aSuffix )
  */
 void Prettify( std::string& aSource, char aQuoteChar )
 {
-    // Configuration
-    const char indentChar = '\t';
-    const int  indentSize = 1;
+    PRETTIFIER  prettifier( aQuoteChar );
+    std::string formatted;
 
-    // In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
-    // lists, which we allow to exist on a single line until we reach column 99.
-    const int  xySpecialCaseColumnLimit = 99;
+    formatted.reserve( aSource.length() );
 
-    // If whitespace occurs inside a list after this threshold, it will be converted into a newline
-    // and the indentation will be increased.  This is mainly used for image and group objects,
-    // which contain potentially long sets of string tokens within a single list.
-    const int  consecutiveTokenWrapThreshold = 72;
+    prettifier.Feed( aSource.data(), aSource.length(), formatted );
+    prettifier.Finish( formatted );
 
-    std::string formatted;
-    formatted.reserve( aSource.length() );
+    aSource = std::move( formatted );
+}
 
-    auto cursor = aSource.begin();
-    auto seek = cursor;
 
-    int  listDepth = 0;
-    char lastNonWhitespace = 0;
-    bool inQuote = false;
-    bool hasInsertedSpace = false;
-    bool inMultiLineList = false;
-    bool inXY = false;
-    int  column = 0;
-    int  backslashCount = 0;    // Count of successive backslash read since any other char
+// Configuration
+static const char indentChar = '\t';
+static const int  indentSize = 1;
 
-    auto isWhitespace = []( const char aChar )
-            {
-                return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
-            };
+// In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
+// lists, which we allow to exist on a single line until we reach column 99.
+static const int  xySpecialCaseColumnLimit = 99;
 
-    auto nextNonWhitespace =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+// If whitespace occurs inside a list after this threshold, it will be converted into a newline
+// and the indentation will be increased.  This is mainly used for image and group objects,
+// which contain potentially long sets of string tokens within a single list.
+static const int  consecutiveTokenWrapThreshold = 72;
 
-                while( seek != aSource.end() && isWhitespace( *seek ) )
-                    seek++;
 
-                if( seek == aSource.end() )
-                    return (char)0;
+static bool isWhitespace( const char aChar )
+{
+    return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
+}
 
-                return *seek;
-            };
 
-    auto isXY =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+PRETTIFIER::PRETTIFIER( char aQuoteChar ) :
+        m_quoteChar( aQuoteChar ),
+        m_listDepth( 0 ),
+        m_lastNonWhitespace( 0 ),
+        m_inQuote( false ),
+        m_hasInsertedSpace( false ),
+        m_inMultiLineList( false ),
+        m_inXY( false ),
+        m_column( 0 ),
+        m_backslashCount( 0 )
+{
+}
+
+
+void PRETTIFIER::Feed( const char* aSource, size_t aCount, std::string& aOut )
+{
+    if( m_pending.empty() )
+    {
+        size_t done = process( std::string_view( aSource, aCount ), false, aOut );
+        m_pending.assign( aSource + done, aCount - done );
+    }
+    else
+    {
+        m_pending.append( aSource, aCount );
+        m_pending.erase( 0, process( m_pending, false, aOut ) );
+    }
+}
 
-                if( ++seek == aSource.end() || *seek != 'x' )
-                    return false;
 
-                if( ++seek == aSource.end() || *seek != 'y' )
-                    return false;
+void PRETTIFIER::Finish( std::string& aOut )
+{
+    process( m_pending, true, aOut );
+    m_pending.clear();
+
+    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
+    aOut += '\n';
+}
 
-                if( ++seek == aSource.end() || *seek != ' ' )
-                    return false;
 
-                return true;
+size_t PRETTIFIER::process( std::string_view aInput, bool aAtEnd, std::string& aOut )
+{
+    auto newLine =
+            [&]()
+            {
+                aOut.push_back( '\n' );
+                aOut.append( m_listDepth * indentSize, indentChar );
+                m_column = m_listDepth * indentSize;
             };
 
-    while( cursor != aSource.end() )
+    const size_t count = aInput.length();
+    size_t       cursor = 0;
+
+    while( cursor < count )
     {
-        char next = nextNonWhitespace( cursor );
+        const char ch = aInput[cursor];
 
-        if( isWhitespace( *cursor ) && !inQuote )
+        if( isWhitespace( ch ) && !m_inQuote )
         {
-            if( !hasInsertedSpace           // Only permit one space between chars
-                && listDepth > 0            // Do not permit spaces in outer list
-                && lastNonWhitespace != '(' // Remove extra space after start of list
-                && next != ')'              // Remove extra space before end of list
-                && next != '(' )            // Remove extra space before newline
+            // Whether a run of whitespace becomes a space, a newline or nothing depends on
+            // the character which follows it.  Only the first whitespace of a run can be
+            // emitted, so the run is handled as a whole.
+            size_t seek = cursor;
+
+            while( seek < count && isWhitespace( aInput[seek] ) )
+                seek++;
+
+            if( seek == count && !aAtEnd )
+                break;
+
+            char next = seek < count ? aInput[seek] : 0;
+
+            if( !m_hasInsertedSpace           // Only permit one space between chars
+                && m_listDepth > 0            // Do not permit spaces in outer list
+                && m_lastNonWhitespace != '(' // Remove extra space after start of list
+                && next != ')'                // Remove extra space before end of list
+                && next != '(' )              // Remove extra space before newline
             {
-                if( inXY || column < consecutiveTokenWrapThreshold )
+                if( m_inXY || m_column < consecutiveTokenWrapThreshold )
                 {
-                    // Note that we only insert spaces here, no matter what kind of whitespace is in
-                    // the input.  Newlines will be inserted as needed by the logic below.
-                    formatted.push_back( ' ' );
-                    column++;
+                    // Note that we only insert spaces here, no matter what kind of whitespace
+                    // is in the input.  Newlines will be inserted as needed by the logic below.
+                    aOut.push_back( ' ' );
+                    m_column++;
                 }
                 else
                 {
-                    formatted += fmt::format( "\n{}",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize;
-                    inMultiLineList = true;
+                    newLine();
+                    m_inMultiLineList = true;
                 }
 
-                hasInsertedSpace = true;
+                m_hasInsertedSpace = true;
             }
+
+            cursor = seek;
+            continue;
         }
-        else
+
+        if( ch == '(' && !m_inQuote )
         {
-            hasInsertedSpace = false;
+            // The list-of-points special case needs to see the list's keyword
+            if( count - cursor < 4 && !aAtEnd )
+                break;
 
-            if( *cursor == '(' && !inQuote )
-            {
-                bool currentIsXY = isXY( cursor );
+            bool currentIsXY = count - cursor >= 4
+                                    && aInput.substr( cursor + 1, 3 ) == "xy ";
 
-                if( listDepth == 0 )
-                {
-                    formatted.push_back( '(' );
-                    column++;
-                }
-                else if( inXY && currentIsXY && column < xySpecialCaseColumnLimit )
-                {
-                    // List-of-points special case
-                    formatted += " (";
-                    column += 2;
-                    inXY = true;
-                }
-                else
-                {
-                    formatted += fmt::format( "\n{}(",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
-                }
-
-                inXY = currentIsXY;
-                listDepth++;
+            if( m_listDepth == 0 )
+            {
+                aOut.push_back( '(' );
+                m_column++;
             }
-            else if( *cursor == ')' && !inQuote )
+            else if( m_inXY && currentIsXY && m_column < xySpecialCaseColumnLimit )
             {
-                if( listDepth > 0 )
-                    listDepth--;
-
-                if( lastNonWhitespace == ')' || inMultiLineList )
-                {
-                    formatted += fmt::format( "\n{})",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
-                    inMultiLineList = false;
-                }
-                else
-                {
-                    formatted.push_back( ')' );
-                    column++;
-                }
+                // List-of-points special case
+                aOut += " (";
+                m_column += 2;
             }
             else
             {
-                // The output formatter escapes double-quotes (like \")
-                // But a corner case is a sequence like \\"
-                // therefore a '\' is attached to a '"' if a odd number of '\' is detected
-                if( *cursor == '\\' )
-                    backslashCount++;
-                else if( *cursor == aQuoteChar && ( backslashCount & 1 ) == 0 )
-                    inQuote = !inQuote;
-
-                if( *cursor != '\\' )
-                    backslashCount = 0;
-
-                formatted.push_back( *cursor );
-                column++;
+                newLine();
+                aOut.push_back( '(' );
+                m_column++;
             }
 
-            lastNonWhitespace = *cursor;
+            m_inXY = currentIsXY;
+            m_listDepth++;
         }
+        else if( ch == ')' && !m_inQuote )
+        {
+            if( m_listDepth > 0 )
+                m_listDepth--;
 
+            if( m_lastNonWhitespace == ')' || m_inMultiLineList )
+            {
+                newLine();
+                aOut.push_back( ')' );
+                m_column++;
+                m_inMultiLineList = false;
+            }
+            else
+            {
+                aOut.push_back( ')' );
+                m_column++;
+            }
+        }
+        else
+        {
+            // The output formatter escapes double-quotes (like \")
+            // But a corner case is a sequence like \\"
+            // therefore a '\' is attached to a '"' if a odd number of '\' is detected
+            if( ch == '\\' )
+                m_backslashCount++;
+            else if( ch == m_quoteChar && ( m_backslashCount & 1 ) == 0 )
+                m_inQuote = !m_inQuote;
+
+            if( ch != '\\' )
+                m_backslashCount = 0;
+
+            aOut.push_back( ch );
+            m_column++;
+        }
+
+        m_hasInsertedSpace = false;
+        m_lastNonWhitespace = ch;
         ++cursor;
     }
 
-    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
-    formatted += '\n';
-
-    aSource = std::move( formatted );
+    return cursor;
 }
 
 } // namespace KICAD_FORMAT
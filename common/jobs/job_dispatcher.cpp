@@ -41,10 +41,11 @@ void JOB_DISPATCHER::Register( const std::string&             aJobTypeName,
 
 int JOB_DISPATCHER::RunJob( JOB* job )
 {
-    if( m_jobHandlers.count( job->GetType() ) )
-    {
-        return m_jobHandlers[job->GetType()]( job );
-    }
+    // Batched jobs may be dispatched from several threads at once, so only look up here
+    auto it = m_jobHandlers.find( job->GetType() );
+
+    if( it != m_jobHandlers.end() )
+        return it->second( job );
 
     return CLI::EXIT_CODES::ERR_UNKNOWN;
 }
@@ -37,6 +37,9 @@ public:
 
     bool m_layersIncludeOnAllSet;
     bool m_useBoardPlotParams;
+
+    ///< Plot the layers concurrently.  The output files are identical either way.
+    bool m_parallelPlot;
 };
 
 #endif
\ No newline at end of file
@@ -23,12 +23,36 @@
 #include <lib_tree_model.h>
 
 #include <algorithm>
+#include <core/thread_pool.h>
 #include <eda_pattern_match.h>
 #include <lib_tree_item.h>
 #include <pgm_base.h>
 #include <string_utils.h>
 
 
+// Below this count of items to score, the thread pool overhead outweighs the matching time
+#define MIN_ITEMS_FOR_PARALLEL_SCORING 2000
+
+
+/**
+ * Append the trigrams of aText to aTrigrams, each one packing 3 code points of 21 bits.
+ */
+static void addTrigrams( const wxString& aText, std::vector<uint64_t>& aTrigrams )
+{
+    const uint64_t mask = ( uint64_t( 1 ) << 63 ) - 1;
+    uint64_t       trigram = 0;
+    size_t         count = 0;
+
+    for( wxUniChar ch : aText )
+    {
+        trigram = ( ( trigram << 21 ) | ( ch.GetValue() & 0x1FFFFF ) ) & mask;
+
+        if( ++count >= 3 )
+            aTrigrams.push_back( trigram );
+    }
+}
+
+
 
 void LIB_TREE_NODE::ResetScore()
 {
@@ -200,6 +224,9 @@ LIB_TREE_NODE_ITEM::LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
     m_Footprint = aItem->GetFootprint();
     m_PinCount = aItem->GetPinCount();
 
+    m_ScoredMatcher = nullptr;
+    m_MatcherScore = 0;
+
     aItem->GetChooserFields( m_Fields );
 
     m_SearchTerms = aItem->GetSearchTerms();
@@ -234,6 +261,9 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
 
     m_SearchTerms = aItem->GetSearchTerms();
 
+    if( m_Parent && m_Parent->m_Type == TYPE::LIBRARY )
+        static_cast<LIB_TREE_NODE_LIBRARY*>( m_Parent )->InvalidateSearchIndex();
+
     m_IsRoot = aItem->IsRoot();
     m_Children.clear();
 
@@ -248,7 +278,10 @@ void LIB_TREE_NODE_ITEM::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxSt
     // aMatcher test is additive, but if we don't match the given term at all, it nulls out
     if( aMatcher )
     {
-        int currentScore = aMatcher->ScoreTerms( m_SearchTerms );
+        int currentScore = m_ScoredMatcher == aMatcher ? m_MatcherScore
+                                                       : aMatcher->ScoreTerms( m_SearchTerms );
+
+        m_ScoredMatcher = nullptr;
 
         // This is a hack: the second phase of search in the adapter will look for a tokenized
         // LIB_ID and send the lib part down here.  While we generally want to prune ourselves
@@ -282,6 +315,7 @@ LIB_TREE_NODE_LIBRARY::LIB_TREE_NODE_LIBRARY( LIB_TREE_NODE* aParent, wxString c
     m_Desc = aDesc;
     m_Parent = aParent;
     m_LibId.SetLibNickname( aName );
+    m_searchIndexValid = false;
 
     m_SearchTerms.emplace_back( SEARCH_TERM( aName, 8 ) );
 }
@@ -291,10 +325,130 @@ LIB_TREE_NODE_ITEM& LIB_TREE_NODE_LIBRARY::AddItem( LIB_TREE_ITEM* aItem )
 {
     LIB_TREE_NODE_ITEM* item = new LIB_TREE_NODE_ITEM( this, aItem );
     m_Children.push_back( std::unique_ptr<LIB_TREE_NODE>( item ) );
+    m_searchIndexValid = false;
     return *item;
 }
 
 
+void LIB_TREE_NODE_LIBRARY::buildSearchIndex()
+{
+    std::vector<uint64_t> trigrams;
+
+    m_searchIndex.clear();
+
+    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+    {
+        if( child->m_Type != TYPE::ITEM )
+            continue;
+
+        LIB_TREE_NODE_ITEM* item = static_cast<LIB_TREE_NODE_ITEM*>( child.get() );
+
+        trigrams.clear();
+
+        for( SEARCH_TERM& term : item->m_SearchTerms )
+        {
+            term.Normalize();
+            addTrigrams( term.Text, trigrams );
+        }
+
+        std::sort( trigrams.begin(), trigrams.end() );
+        trigrams.erase( std::unique( trigrams.begin(), trigrams.end() ), trigrams.end() );
+
+        for( uint64_t trigram : trigrams )
+            m_searchIndex[trigram].push_back( item );
+    }
+
+    for( auto& [trigram, items] : m_searchIndex )
+        std::sort( items.begin(), items.end() );
+
+    m_searchIndexValid = true;
+}
+
+
+void LIB_TREE_NODE_LIBRARY::GetSearchCandidates( const EDA_COMBINED_MATCHER& aMatcher,
+                                                 std::vector<LIB_TREE_NODE_ITEM*>& aCandidates )
+{
+    std::vector<uint64_t> patternTrigrams;
+    addTrigrams( aMatcher.GetPattern(), patternTrigrams );
+
+    // A term matches a literal pattern only if it contains all the pattern trigrams
+    std::vector<LIB_TREE_NODE_ITEM*> matches;
+
+    if( !patternTrigrams.empty() )
+    {
+        if( !m_searchIndexValid )
+            buildSearchIndex();
+
+        std::sort( patternTrigrams.begin(), patternTrigrams.end() );
+        patternTrigrams.erase( std::unique( patternTrigrams.begin(), patternTrigrams.end() ),
+                               patternTrigrams.end() );
+
+        std::vector<const std::vector<LIB_TREE_NODE_ITEM*>*> lists;
+
+        for( uint64_t trigram : patternTrigrams )
+        {
+            auto it = m_searchIndex.find( trigram );
+
+            if( it == m_searchIndex.end() )
+            {
+                lists.clear();
+                break;
+            }
+
+            lists.push_back( &it->second );
+        }
+
+        // Intersect the shortest lists first
+        std::sort( lists.begin(), lists.end(),
+                   []( const std::vector<LIB_TREE_NODE_ITEM*>* a,
+                       const std::vector<LIB_TREE_NODE_ITEM*>* b )
+                   {
+                       return a->size() < b->size();
+                   } );
+
+        std::vector<LIB_TREE_NODE_ITEM*> intersection;
+
+        for( size_t ii = 0; ii < lists.size(); ++ii )
+        {
+            if( ii == 0 )
+            {
+                matches = *lists[ii];
+                continue;
+            }
+
+            intersection.clear();
+            std::set_intersection( matches.begin(), matches.end(), lists[ii]->begin(),
+                                   lists[ii]->end(), std::back_inserter( intersection ) );
+            matches.swap( intersection );
+
+            if( matches.empty() )
+                break;
+        }
+    }
+
+    // Walk the current children rather than the index, which can still hold items removed
+    // from the library since it was built
+    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+    {
+        if( child->m_Type != TYPE::ITEM )
+            continue;
+
+        LIB_TREE_NODE_ITEM* item = static_cast<LIB_TREE_NODE_ITEM*>( child.get() );
+
+        if( patternTrigrams.empty()
+                || std::binary_search( matches.begin(), matches.end(), item ) )
+        {
+            aCandidates.push_back( item );
+        }
+        else
+        {
+            item->m_ScoredMatcher = &aMatcher;
+            item->m_MatcherScore = 0;
+        }
+    }
+}
+
+
 void LIB_TREE_NODE_LIBRARY::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                                          std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
@@ -358,6 +512,39 @@ LIB_TREE_NODE_LIBRARY& LIB_TREE_NODE_ROOT::AddLib( wxString const& aName, wxStri
 void LIB_TREE_NODE_ROOT::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
+    // Regular expression matchers are not reentrant, so only literal patterns are scored
+    // ahead of the tree walk
+    if( aMatcher && aMatcher->IsLiteral() )
+    {
+        std::vector<LIB_TREE_NODE_ITEM*> candidates;
+
+        for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+        {
+            if( child->m_Type == TYPE::LIBRARY )
+            {
+                static_cast<LIB_TREE_NODE_LIBRARY*>( child.get() )->GetSearchCandidates( *aMatcher,
+                                                                                      candidates );
+            }
+        }
+
+        auto scoreItems =
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                    {
+                        LIB_TREE_NODE_ITEM* item = candidates[ii];
+
+                        item->m_MatcherScore = aMatcher->ScoreTerms( item->m_SearchTerms );
+                        item->m_ScoredMatcher = aMatcher;
+                    }
+                };
+
+        if( candidates.size() < MIN_ITEMS_FOR_PARALLEL_SCORING )
+            scoreItems( 0, candidates.size() );
+        else
+            GetKiCadThreadPool().parallelize_loop( candidates.size(), scoreItems ).wait();
+    }
+
     for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
         child->UpdateScore( aMatcher, aLib, aFilter );
 }
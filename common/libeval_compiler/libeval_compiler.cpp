@@ -201,6 +201,84 @@ wxString UCODE::Dump() const
 };
 
 
+void UCODE::Optimize( const std::function<void( const wxString& aMessage,
+                                                 int aOffset )>& aErrorCallback )
+{
+    auto isNumericConstant =
+            []( const UOP* aOp )
+            {
+                return aOp->GetOp() == TR_UOP_PUSH_VALUE && aOp->GetValue()
+                        && aOp->GetValue()->GetType() == VT_NUMERIC;
+            };
+
+    std::vector<UOP*> folded;
+    folded.reserve( m_ucode.size() );
+
+    for( UOP* op : m_ucode )
+    {
+        int arity = 0;
+
+        if( op->GetOp() & TR_OP_BINARY_MASK )
+            arity = 2;
+        else if( op->GetOp() & TR_OP_UNARY_MASK )
+            arity = 1;
+
+        // In postfix form an operator's operands are the values pushed immediately before it,
+        // so if those are all numeric constants the operator can be evaluated right now.
+        if( arity == 0 || (int) folded.size() < arity
+                || !std::all_of( folded.end() - arity, folded.end(), isNumericConstant ) )
+        {
+            folded.push_back( op );
+            continue;
+        }
+
+        CONTEXT ctx;
+        bool    failed = false;
+
+        ctx.SetErrorCallback(
+                [&]( const wxString& aMessage, int aOffset )
+                {
+                    failed = true;
+
+                    if( aErrorCallback )
+                        aErrorCallback( aMessage, aOffset );
+                } );
+
+        try
+        {
+            for( auto it = folded.end() - arity; it != folded.end(); ++it )
+                ( *it )->Exec( &ctx );
+
+            op->Exec( &ctx );
+        }
+        catch( ... )
+        {
+            failed = true;
+        }
+
+        // Keep the operator so that the error is raised again when the expression is run
+        if( failed )
+        {
+            folded.push_back( op );
+            continue;
+        }
+
+        std::unique_ptr<VALUE> result = std::make_unique<VALUE>( ctx.Pop()->AsDouble() );
+
+        for( int ii = 0; ii < arity; ++ii )
+        {
+            delete folded.back();
+            folded.pop_back();
+        }
+
+        delete op;
+        folded.push_back( new UOP( TR_UOP_PUSH_VALUE, std::move( result ) ) );
+    }
+
+    m_ucode = std::move( folded );
+}
+
+
 wxString TOKENIZER::GetString()
 {
     wxString rv;
@@ -1121,7 +1199,7 @@ void UOP::Exec( CONTEXT* ctx )
         VALUE* value = nullptr;
 
         if( m_ref )
-            value = ctx->StoreValue( m_ref->GetValue( ctx ) );
+            value = m_ref->GetValue( ctx );
         else
             value = ctx->AllocValue();
 
@@ -30,6 +30,7 @@
 #include <trigo.h>
 #include <wx/log.h>
 #include <cstdio>
+#include <charconv>
 
 #include <build_version.h>
 
@@ -64,6 +65,9 @@
 #define GBR_MACRO_FOR_CUSTOM_PAD_MAX_CORNER_COUNT 4990
 #define AM_FREEPOLY_BASENAME "FreePoly"
 
+// Size of the stdio buffers of the work file and of the final Gerber file
+#define GBR_FILE_BUFFER_SIZE ( 256 * 1024 )
+
 
 // A helper function to compare 2 polygons: polygons are similar if they have the same
 // number of vertices and each vertex coordinate are similar, i.e. if the difference
@@ -76,7 +80,7 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
     if( aTestPolygon.size() != aPolygon.size() )
         return false;
 
-    const int margin = 2;
+    const int margin = GBR_POLY_INDEX::MARGIN;
 
     for( size_t jj = 0; jj < aPolygon.size(); jj++ )
     {
@@ -89,6 +93,35 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
 }
 
 
+// Degrees of aRotation, with -0.0 mapped to 0.0 because EDA_ANGLE compares degrees and
+// both values must have the same hash
+static double rotationHashValue( const EDA_ANGLE& aRotation )
+{
+    double degrees = aRotation.AsDegrees();
+
+    return degrees == 0.0 ? 0.0 : degrees;
+}
+
+
+// Key of an aperture in GERBER_PLOTTER::m_apertureSizeIndex
+static size_t apertureSizeKey( APERTURE::APERTURE_TYPE aType, const VECTOR2I& aSize, int aRadius,
+                               const EDA_ANGLE& aRotation, int aApertureAttribute )
+{
+    return hash_val( static_cast<int>( aType ), aSize.x, aSize.y, aRadius,
+                     rotationHashValue( aRotation ), aApertureAttribute );
+}
+
+
+// Key of an aperture in GERBER_PLOTTER::m_apertureCornerIndex (the corners themselves are
+// handled by GBR_POLY_INDEX)
+static size_t apertureCornerKey( APERTURE::APERTURE_TYPE aType, const EDA_ANGLE& aRotation,
+                                 int aApertureAttribute )
+{
+    return hash_val( static_cast<int>( aType ), rotationHashValue( aRotation ),
+                     aApertureAttribute );
+}
+
+
 GERBER_PLOTTER::GERBER_PLOTTER()
 {
     workFile  = nullptr;
@@ -141,6 +174,29 @@ void GERBER_PLOTTER::SetViewport( const VECTOR2I& aOffset, double aIusPerDecimil
 }
 
 
+GERBER_PLOTTER::~GERBER_PLOTTER()
+{
+    // Emergency cleanup, if EndPlot() was not called: the files must be closed before
+    // their buffers are freed.
+    if( workFile )
+    {
+        if( m_outputFile == workFile )
+            m_outputFile = nullptr;
+
+        fclose( workFile );
+        ::wxRemoveFile( m_workFilename );
+    }
+
+    if( finalFile )
+    {
+        if( m_outputFile == finalFile )
+            m_outputFile = nullptr;
+
+        fclose( finalFile );
+    }
+}
+
+
 void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInches )
 {
     m_gerberUnitInch = aUseInches;
@@ -155,7 +211,40 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 
 void GERBER_PLOTTER::emitDcode( const VECTOR2D& pt, int dcode )
 {
-    fprintf( m_outputFile, "X%dY%dD%02d*\n", KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    // This is the most frequent record of a Gerber file: format it by hand rather than
+    // with fprintf( "X%dY%dD%02d*\n" ).
+    char  buf[64];
+    char* end = buf + sizeof( buf );
+    char* p = buf;
+
+    *p++ = 'X';
+    p = std::to_chars( p, end, KiROUND( pt.x ) ).ptr;
+    *p++ = 'Y';
+    p = std::to_chars( p, end, KiROUND( pt.y ) ).ptr;
+    *p++ = 'D';
+
+    if( dcode >= 0 && dcode < 10 )
+        *p++ = '0';
+
+    p = std::to_chars( p, end, dcode ).ptr;
+    *p++ = '*';
+    *p++ = '\n';
+
+    fwrite( buf, 1, p - buf, m_outputFile );
+}
+
+
+void GERBER_PLOTTER::emitApertureSelection( int aDCode )
+{
+    char  buf[32];
+    char* p = buf;
+
+    *p++ = 'D';
+    p = std::to_chars( p, buf + sizeof( buf ), aDCode ).ptr;
+    *p++ = '*';
+    *p++ = '\n';
+
+    fwrite( buf, 1, p - buf, m_outputFile );
 }
 
 void GERBER_PLOTTER::ClearAllAttributes()
@@ -248,6 +337,10 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
 
     finalFile = m_outputFile;     // the actual gerber file will be created later
 
+    // No data was written to finalFile yet, so its buffer can still be changed
+    m_finalFileBuffer.resize( GBR_FILE_BUFFER_SIZE );
+    setvbuf( finalFile, m_finalFileBuffer.data(), _IOFBF, m_finalFileBuffer.size() );
+
     // Create a temp file in system temp to avoid potential network share buffer issues for
     // the final read and save.
     m_workFilename = wxFileName::CreateTempFileName( "" );
@@ -258,6 +351,9 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
     if( m_outputFile == nullptr )
         return false;
 
+    m_workFileBuffer.resize( GBR_FILE_BUFFER_SIZE );
+    setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -329,6 +425,9 @@ bool GERBER_PLOTTER::EndPlot()
     wxASSERT( workFile );
     m_outputFile = finalFile;
 
+    if( workFile )
+        setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
     // Placement of apertures in RS274X
     while( fgets( line, 1024, workFile ) )
     {
@@ -389,6 +488,8 @@ bool GERBER_PLOTTER::EndPlot()
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
     m_outputFile = nullptr;
+    workFile = nullptr;
+    finalFile = nullptr;
 
     return true;
 }
@@ -416,18 +517,23 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
-
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
+    auto it = m_apertureSizeIndex.find( apertureSizeKey( aType, aSize, aRadius, aRotation,
+                                                         aApertureAttribute ) );
+
+    if( it != m_apertureSizeIndex.end() )
     {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+        // Indices are stored in increasing order, so the first match is also the first
+        // one in m_apertures
+        for( int idx : it->second )
+        {
+            const APERTURE& tool = m_apertures[idx];
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_Radius == aRadius) && (tool->m_Rotation == aRotation) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return idx;
+            if( (tool.m_Type == aType) && (tool.m_Size == aSize) &&
+                (tool.m_Radius == aRadius) && (tool.m_Rotation == aRotation) &&
+                (tool.m_ApertureAttribute == aApertureAttribute) )
+                return idx;
+        }
     }
 
     // Allocate a new aperture
@@ -436,12 +542,9 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = aRadius;
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
-    m_apertures.push_back( new_tool );
-
-    return m_apertures.size() - 1;
+    return addAperture( new_tool );
 }
 
 
@@ -449,8 +552,6 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
-
     // For APERTURE::AM_FREE_POLYGON aperture macros, we need to create the macro
     // on the fly, because due to the fact the vertex count is not a constant we
     // cannot create a static definition.
@@ -463,24 +564,21 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     }
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-
-       last_D_code = tool->m_DCode;
+    int found = m_apertureCornerIndex.Find(
+            apertureCornerKey( aType, aRotation, aApertureAttribute ), aCorners,
+            [&]( int idx )
+            {
+                const APERTURE& tool = m_apertures[idx];
 
-        if( (tool->m_Type == aType) &&
-            (tool->m_Corners.size() == aCorners.size() ) &&
-            (tool->m_Rotation == aRotation) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-        {
-            // A candidate is found. the corner lists must be similar
-            bool is_same = polyCompare( tool->m_Corners, aCorners );
+                // A candidate is found. the corner lists must be similar
+                return (tool.m_Type == aType) &&
+                       (tool.m_Rotation == aRotation) &&
+                       (tool.m_ApertureAttribute == aApertureAttribute) &&
+                       polyCompare( tool.m_Corners, aCorners );
+            } );
 
-            if( is_same )
-                return idx;
-        }
-    }
+    if( found >= 0 )
+        return found;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -490,12 +588,32 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = 0;             // Not used
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
-    m_apertures.push_back( new_tool );
+    return addAperture( new_tool );
+}
+
+
+int GERBER_PLOTTER::addAperture( APERTURE& aAperture )
+{
+    int idx = (int) m_apertures.size();
+
+    aAperture.m_DCode = m_apertures.empty() ? FIRST_DCODE_VALUE
+                                            : m_apertures.back().m_DCode + 1;
 
-    return m_apertures.size() - 1;
+    // Every aperture is in both indexes, as both GetOrCreateAperture() versions can match
+    // any aperture
+    m_apertureSizeIndex[ apertureSizeKey( aAperture.m_Type, aAperture.m_Size,
+                                          aAperture.m_Radius, aAperture.m_Rotation,
+                                          aAperture.m_ApertureAttribute ) ].push_back( idx );
+
+    m_apertureCornerIndex.Add( apertureCornerKey( aAperture.m_Type, aAperture.m_Rotation,
+                                                  aAperture.m_ApertureAttribute ),
+                               aAperture.m_Corners, idx );
+
+    m_apertures.push_back( std::move( aAperture ) );
+
+    return idx;
 }
 
 
@@ -516,7 +634,7 @@ void GERBER_PLOTTER::selectAperture( const VECTOR2I& aSize, int aRadius, const E
         // Pick an existing aperture or create a new one
         m_currentApertureIdx = GetOrCreateAperture( aSize, aRadius, aRotation, aType,
                                                     aApertureAttribute );
-        fprintf( m_outputFile, "D%d*\n", m_apertures[m_currentApertureIdx].m_DCode );
+        emitApertureSelection( m_apertures[m_currentApertureIdx].m_DCode );
     }
 }
 
@@ -550,7 +668,7 @@ void GERBER_PLOTTER::selectAperture( const std::vector<VECTOR2I>& aCorners,
         // Pick an existing aperture or create a new one
         m_currentApertureIdx = GetOrCreateAperture( aCorners, aRotation, aType,
                                                     aApertureAttribute );
-        fprintf( m_outputFile, "D%d*\n", m_apertures[m_currentApertureIdx].m_DCode );
+        emitApertureSelection( m_apertures[m_currentApertureIdx].m_DCode );
     }
 }
 
@@ -2061,17 +2179,16 @@ void APER_MACRO_FREEPOLY_LIST::Format( FILE * aOutput, double aIu2GbrMacroUnit )
 
 void APER_MACRO_FREEPOLY_LIST::Append( const std::vector<VECTOR2I>& aPolygon )
 {
+    m_index.Add( 0, aPolygon, AmCount() );
     m_AMList.emplace_back( aPolygon, AmCount() );
 }
 
 
 int APER_MACRO_FREEPOLY_LIST::FindAm( const std::vector<VECTOR2I>& aPolygon ) const
 {
-    for( int idx = 0; idx < AmCount(); idx++ )
-    {
-        if( m_AMList[idx].IsSamePoly( aPolygon ) )
-            return idx;
-    }
-
-    return -1;
+    return m_index.Find( 0, aPolygon,
+                         [&]( int idx )
+                         {
+                             return m_AMList[idx].IsSamePoly( aPolygon );
+                         } );
 }
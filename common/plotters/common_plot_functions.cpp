@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <mutex>
+
 #include <eda_item.h>
 #include <font/font.h>
 #include <plotters/plotter_dxf.h>
@@ -65,6 +67,11 @@ void PlotDrawingSheet( PLOTTER* plotter, const PROJECT* aProject, const TITLE_BL
     if( plotColor == COLOR4D::UNSPECIFIED )
         plotColor = COLOR4D( RED );
 
+    // Building the draw list recreates the draw items held by the (global) drawing sheet
+    // model, so only one sheet may be plotted at a time
+    static std::mutex           s_drawingSheetMutex;
+    std::lock_guard<std::mutex> lock( s_drawingSheetMutex );
+
     DS_DRAW_ITEM_LIST drawList( unityScale );
 
     // Print only a short filename, if aFilename is the full filename
@@ -23,7 +23,9 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
@@ -241,6 +243,14 @@ long int FILE_LINE_READER::CurPos()
 }
 
 
+std::string_view LINE_READER::ReadLineView()
+{
+    char* line = ReadLine();
+
+    return line ? std::string_view( line, m_length ) : std::string_view();
+}
+
+
 char* FILE_LINE_READER::ReadLine()
 {
     m_length = 0;
@@ -298,6 +308,102 @@ STRING_LINE_READER::STRING_LINE_READER( const STRING_LINE_READER& aStartingPoint
 }
 
 
+STRING_LINE_READER::STRING_LINE_READER( std::string&& aString, const wxString& aSource,
+                                        unsigned aFirstLine ) :
+    LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
+    m_lines( std::move( aString ) ), m_ndx( 0 )
+{
+    m_source  = aSource;
+    m_lineNum = aFirstLine > 0 ? aFirstLine - 1 : 0;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ), m_data( nullptr ), m_size( 0 ), m_pos( 0 )
+{
+    if( !KIPLATFORM::IO::MapFile( aFileName, m_data, m_size ) )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_source = aFileName;
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    KIPLATFORM::IO::UnmapFile( m_data, m_size );
+}
+
+
+std::string_view MAPPED_FILE_LINE_READER::ReadLineView()
+{
+    // An empty file isn't mapped at all
+    if( m_pos == m_size )
+    {
+        m_length = 0;
+        ++m_lineNum;
+        return std::string_view();
+    }
+
+    size_t remaining = m_size - m_pos;
+    size_t length = remaining;
+
+    if( const void* nl = memchr( m_data + m_pos, '\n', remaining ) )
+        length = static_cast<const char*>( nl ) - ( m_data + m_pos ) + 1;
+
+    if( length >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    std::string_view line( m_data + m_pos, length );
+
+    m_pos += length;
+    m_length = length;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return line;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    std::string_view line = ReadLineView();
+
+    if( line.size() + 1 > m_capacity )   // +1 for terminating nul
+    {
+        m_length = 0;                    // nothing to preserve from the previous line
+        expandCapacity( line.size() + 1 );
+        m_length = line.size();
+    }
+
+    memcpy( m_line, line.data(), line.size() );
+    m_line[line.size()] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+unsigned MAPPED_FILE_LINE_READER::CountLines() const
+{
+    if( !m_size )
+        return 0;
+
+    unsigned count = std::count( m_data, m_data + m_size, '\n' );
+
+    // A final line need not be terminated
+    if( m_data[m_size - 1] != '\n' )
+        ++count;
+
+    return count;
+}
+
+
 char* STRING_LINE_READER::ReadLine()
 {
     size_t  nlOffset = m_lines.find( '\n', m_ndx );
@@ -586,12 +692,15 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 PRETTIFIED_FILE_OUTPUTFORMATTER::PRETTIFIED_FILE_OUTPUTFORMATTER( const wxString& aFileName,
                                                                   const wxChar* aMode,
                                                                   char aQuoteChar ) :
-        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar )
+        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+        m_prettifier( aQuoteChar )
 {
     m_fp = wxFopen( aFileName, aMode );
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.reserve( PRETTIFIED_FILE_CHUNK + OUTPUTFMTBUFZ );
 }
 
 
@@ -611,10 +720,8 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
     if( !m_fp )
         return false;
 
-    KICAD_FORMAT::Prettify( m_buf );
-
-    if( fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
-        THROW_IO_ERROR( strerror( errno ) );
+    m_prettifier.Finish( m_buf );
+    flush();
 
     fclose( m_fp );
     m_fp = nullptr;
@@ -623,7 +730,19 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
 }
 
 
+void PRETTIFIED_FILE_OUTPUTFORMATTER::flush()
+{
+    if( !m_buf.empty() && fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
+        THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.clear();
+}
+
+
 void PRETTIFIED_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
-    m_buf.append( aOutBuf, aCount );
+    m_prettifier.Feed( aOutBuf, aCount, m_buf );
+
+    if( m_buf.length() >= PRETTIFIED_FILE_CHUNK )
+        flush();
 }
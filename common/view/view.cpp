@@ -422,6 +422,20 @@ void VIEW::Remove( VIEW_ITEM* aItem )
 }
 
 
+void VIEW::BeginBulkLoad()
+{
+    for( VIEW_LAYER& layer : m_layers )
+        layer.items->BeginBulkLoad();
+}
+
+
+void VIEW::EndBulkLoad()
+{
+    for( VIEW_LAYER& layer : m_layers )
+        layer.items->EndBulkLoad();
+}
+
+
 void VIEW::SetRequired( int aLayerId, int aRequiredId, bool aRequired )
 {
     wxCHECK( (unsigned) aLayerId < m_layers.size(), /*void*/ );
@@ -20,6 +20,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <list>
 #include <future>
 #include <vector>
@@ -734,90 +735,70 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     m_sheetList = aSheetList;
     std::set<SCH_ITEM*> dirty_items;
 
-    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    // Sheets sharing a screen share their items, so they are updated one after the other by
+    // the same task.  Different screens have no items in common and are updated concurrently.
+    std::vector<SHEET_CONNECTIVITY>         sheetResults( aSheetList.size() );
+    std::vector<std::vector<size_t>>        screenSheets;
+    std::unordered_map<SCH_SCREEN*, size_t> screenIndex;
+
+    for( size_t ii = 0; ii < aSheetList.size(); ++ii )
     {
-        std::vector<SCH_ITEM*> items;
+        auto [it, added] = screenIndex.emplace( aSheetList[ii].LastScreen(), screenSheets.size() );
 
-        // Store current unit value, to replace it after calculations
-        std::vector<std::pair<SCH_SYMBOL*, int>> symbolsChanged;
+        if( added )
+            screenSheets.emplace_back();
 
-        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
-        {
-            if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
-            {
-                wxLogTrace( ConnTrace, wxT( "Adding item %s to connectivity graph update" ),
-                            item->GetTypeDesc() );
-                items.push_back( item );
-                dirty_items.insert( item );
-
-                // Add any symbol dirty pins to the dirty_items list
-                if( item->Type() == SCH_SYMBOL_T )
-                {
-                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+        screenSheets[it->second].push_back( ii );
+    }
 
-                    for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
-                    {
-                        if( pin->IsConnectivityDirty() )
-                        {
-                            dirty_items.insert( pin );
-                        }
-                    }
-                }
-            }
-            // If the symbol isn't dirty, look at the pins
-            // TODO: remove symbols from connectivity graph and only use pins
-            else if( item->Type() == SCH_SYMBOL_T )
+    auto updateScreens =
+            [&]( const int a, const int b )
             {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
-
-                for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
+                for( int ii = a; ii < b; ++ii )
                 {
-                    if( pin->IsConnectivityDirty() )
+                    for( size_t sheetIdx : screenSheets[ii] )
                     {
-                        items.push_back( pin );
-                        dirty_items.insert( pin );
+                        updateSheetConnectivity( aSheetList[sheetIdx], aUnconditional,
+                                                 aChangedItemHandler != nullptr,
+                                                 sheetResults[sheetIdx] );
                     }
                 }
-            }
-            else if( item->Type() == SCH_SHEET_T )
-            {
-                SCH_SHEET* sheetItem = static_cast<SCH_SHEET*>( item );
+            };
 
-                for( SCH_SHEET_PIN* pin : sheetItem->GetPins() )
-                {
-                    if( pin->IsConnectivityDirty() )
-                    {
-                        items.push_back( pin );
-                        dirty_items.insert( pin );
-                    }
-                }
-            }
+    if( screenSheets.size() > 1 )
+        GetKiCadThreadPool().parallelize_loop( screenSheets.size(), updateScreens ).wait();
+    else
+        updateScreens( 0, screenSheets.size() );
 
-            // Ensure the hierarchy info stored in the SCH_SCREEN (such as symbol units) reflects
-            // the current SCH_SHEET_PATH
-            if( item->Type() == SCH_SYMBOL_T )
-            {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
-                int new_unit = symbol->GetUnitSelection( &sheet );
+    // Merge the results in sheet order so that the graph doesn't depend on the scheduling
+    size_t itemCount = m_items.size();
 
-                // Store the initial unit value so we can restore it after calculations
-                if( symbol->GetUnit() != new_unit )
-                    symbolsChanged.push_back( { symbol, symbol->GetUnit() } );
+    for( const SHEET_CONNECTIVITY& result : sheetResults )
+        itemCount += result.items.size();
 
-                symbol->SetUnit( new_unit );
-            }
-        }
+    m_items.reserve( itemCount );
 
-        m_items.reserve( m_items.size() + items.size() );
+    for( size_t ii = 0; ii < aSheetList.size(); ++ii )
+    {
+        const SCH_SHEET_PATH&     sheet = aSheetList[ii];
+        const SHEET_CONNECTIVITY& result = sheetResults[ii];
 
-        updateItemConnectivity( sheet, items );
+        m_items.insert( m_items.end(), result.items.begin(), result.items.end() );
+        dirty_items.insert( result.dirtyItems.begin(), result.dirtyItems.end() );
 
-        // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+        // The net name of a power pin comes from the symbol value, and resolving text isn't
+        // thread safe.  The power pins are post-processed later.
+        for( const auto& [pin, conn] : result.globalPowerPins )
+        {
+            conn->SetName( pin->GetDefaultNetName( sheet ) );
+            m_global_power_pins.emplace_back( std::make_pair( sheet, pin ) );
+        }
 
-        // Restore the m_unit member variables where we had to change them
-        for( const auto& [ symbol, originalUnit ] : symbolsChanged )
-            symbol->SetUnit( originalUnit );
+        if( aChangedItemHandler )
+        {
+            for( SCH_ITEM* item : result.changedItems )
+                ( *aChangedItemHandler )( item );
+        }
     }
 
     // Restore the danlging states of items in the current SCH_SCREEN to match the current
@@ -1129,8 +1110,99 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
 }
 
 
+void CONNECTION_GRAPH::updateSheetConnectivity( const SCH_SHEET_PATH& aSheet, bool aUnconditional,
+                                                bool aRecordChanges, SHEET_CONNECTIVITY& aResult )
+{
+    std::function<void( SCH_ITEM* )> recordChange =
+            [&]( SCH_ITEM* aChangedItem )
+            {
+                aResult.changedItems.push_back( aChangedItem );
+            };
+
+    std::vector<SCH_ITEM*> items;
+
+    // Store current unit value, to replace it after calculations
+    std::vector<std::pair<SCH_SYMBOL*, int>> symbolsChanged;
+
+    for( SCH_ITEM* item : aSheet.LastScreen()->Items() )
+    {
+        if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
+        {
+            wxLogTrace( ConnTrace, wxT( "Adding item %s to connectivity graph update" ),
+                        item->GetTypeDesc() );
+            items.push_back( item );
+            aResult.dirtyItems.push_back( item );
+
+            // Add any symbol dirty pins to the dirty items list
+            if( item->Type() == SCH_SYMBOL_T )
+            {
+                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+                for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
+                {
+                    if( pin->IsConnectivityDirty() )
+                        aResult.dirtyItems.push_back( pin );
+                }
+            }
+        }
+        // If the symbol isn't dirty, look at the pins
+        // TODO: remove symbols from connectivity graph and only use pins
+        else if( item->Type() == SCH_SYMBOL_T )
+        {
+            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+            for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
+            {
+                if( pin->IsConnectivityDirty() )
+                {
+                    items.push_back( pin );
+                    aResult.dirtyItems.push_back( pin );
+                }
+            }
+        }
+        else if( item->Type() == SCH_SHEET_T )
+        {
+            SCH_SHEET* sheetItem = static_cast<SCH_SHEET*>( item );
+
+            for( SCH_SHEET_PIN* pin : sheetItem->GetPins() )
+            {
+                if( pin->IsConnectivityDirty() )
+                {
+                    items.push_back( pin );
+                    aResult.dirtyItems.push_back( pin );
+                }
+            }
+        }
+
+        // Ensure the hierarchy info stored in the SCH_SCREEN (such as symbol units) reflects
+        // the current SCH_SHEET_PATH
+        if( item->Type() == SCH_SYMBOL_T )
+        {
+            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+            int new_unit = symbol->GetUnitSelection( &aSheet );
+
+            // Store the initial unit value so we can restore it after calculations
+            if( symbol->GetUnit() != new_unit )
+                symbolsChanged.push_back( { symbol, symbol->GetUnit() } );
+
+            symbol->SetUnit( new_unit );
+        }
+    }
+
+    updateItemConnectivity( aSheet, items, aResult );
+
+    // UpdateDanglingState() also adds connected items for SCH_TEXT
+    aSheet.LastScreen()->TestDanglingEnds( &aSheet, aRecordChanges ? &recordChange : nullptr );
+
+    // Restore the m_unit member variables where we had to change them
+    for( const auto& [ symbol, originalUnit ] : symbolsChanged )
+        symbol->SetUnit( originalUnit );
+}
+
+
 void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                               const std::vector<SCH_ITEM*>& aItemList )
+                                               const std::vector<SCH_ITEM*>& aItemList,
+                                               SHEET_CONNECTIVITY& aResult )
 {
     wxLogTrace( wxT( "Updating connectivity for sheet %s with %zu items" ),
                 aSheet.Last()->GetFileName(), aItemList.size() );
@@ -1139,17 +1211,14 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
     auto updatePin = [&]( SCH_PIN* aPin, SCH_CONNECTION* aConn )
     {
         aConn->SetType( CONNECTION_TYPE::NET );
-
-        // because calling the first time is not thread-safe
-        wxString name = aPin->GetDefaultNetName( aSheet );
         aPin->ClearConnectedItems( aSheet );
 
-        // power symbol pins need to be post-processed later
+        // power symbol pins need to be post-processed later, and are named when the results
+        // are merged
         if( aPin->IsGlobalPower() )
-        {
-            aConn->SetName( name );
-            m_global_power_pins.emplace_back( std::make_pair( aSheet, aPin ) );
-        }
+            aResult.globalPowerPins.emplace_back( aPin, aConn );
+        else
+            aPin->GetDefaultNetName( aSheet );  // because calling the first time is not thread-safe
     };
 
     for( SCH_ITEM* item : aItemList )
@@ -1166,7 +1235,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 pin->ClearConnectedItems( aSheet );
 
                 connection_map[ pin->GetTextPos() ].push_back( pin );
-                m_items.emplace_back( pin );
+                aResult.items.emplace_back( pin );
             }
         }
         else if( item->Type() == SCH_SYMBOL_T )
@@ -1175,7 +1244,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
             {
-                m_items.emplace_back( pin );
+                aResult.items.emplace_back( pin );
                 SCH_CONNECTION* conn = pin->InitializeConnection( aSheet, this );
                 updatePin( pin, conn );
                 connection_map[ pin->GetPosition() ].push_back( pin );
@@ -1183,7 +1252,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         }
         else
         {
-            m_items.emplace_back( item );
+            aResult.items.emplace_back( item );
             SCH_CONNECTION* conn = item->InitializeConnection( aSheet, this );
 
             // Set bus/net property here so that the propagation code uses it
@@ -1234,8 +1303,6 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         // Pre-scan to see if we have a bus at this location
         SCH_LINE* busLine = aSheet.LastScreen()->GetBus( it.first );
 
-        std::mutex update_mutex;
-
         auto update_lambda = [&]( SCH_ITEM* connected_item ) -> size_t
         {
             // Bus entries are special: they can have connection points in the
@@ -1274,7 +1341,6 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                         else
                             bus_entry->m_connected_bus_items[1] = busLine;
 
-                        std::lock_guard<std::mutex> lock( update_mutex );
                         bus_entry->AddConnectionTo( aSheet, busLine );
                         busLine->AddConnectionTo( aSheet, bus_entry );
                     }
@@ -1344,15 +1410,10 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
             return 1;
         };
 
-        thread_pool& tp = GetKiCadThreadPool();
-
-        tp.push_loop( connection_vec.size(),
-                [&]( const int a, const int b)
-                {
-                    for( int ii = a; ii < b; ++ii )
-                        update_lambda( connection_vec[ii] );
-                });
-        tp.wait_for_tasks();
+        // This runs on the thread pool for each screen, so the few items at each point are
+        // updated in turn.
+        for( SCH_ITEM* connected_item : connection_vec )
+            update_lambda( connected_item );
     }
 }
 
@@ -1370,80 +1431,166 @@ void CONNECTION_GRAPH::buildItemSubGraphs()
             m_bus_alias_cache[alias->GetName()] = alias;
     }
 
-    // Build subgraphs from items (on a per-sheet basis)
-    for( SCH_ITEM* item : m_items )
+    // Items are only connected to items of the same screen, so the subgraphs of each screen
+    // are built on the thread pool.  A subgraph is started by the first of its items in
+    // m_items, and the subgraphs are numbered in that order once all screens are done.
+    struct SCREEN_SUBGRAPHS
     {
-        for( const auto& it : item->m_connection_map )
-        {
-            const SCH_SHEET_PATH& sheet = it.first;
-            SCH_CONNECTION*       connection = it.second;
+        std::vector<size_t>                                  items;
+        std::vector<std::pair<size_t, CONNECTION_SUBGRAPH*>> subgraphs;
+        std::unordered_map<SCH_ITEM*, CONNECTION_SUBGRAPH*>  itemToSubgraph;
+    };
 
-            if( connection->SubgraphCode() == 0 )
-            {
-                CONNECTION_SUBGRAPH* subgraph = new CONNECTION_SUBGRAPH( this );
+    std::vector<SCREEN_SUBGRAPHS>               screenSubgraphs;
+    std::unordered_map<const EDA_ITEM*, size_t> screenIndex;
 
-                subgraph->m_code = m_last_subgraph_code++;
-                subgraph->m_sheet = sheet;
+    for( size_t ii = 0; ii < m_items.size(); ++ii )
+    {
+        const EDA_ITEM* screen = m_items[ii]->GetParent();
 
-                subgraph->AddItem( item );
+        while( screen && screen->Type() != SCH_SCREEN_T )
+            screen = screen->GetParent();
 
-                connection->SetSubgraphCode( subgraph->m_code );
-                m_item_to_subgraph_map[item] = subgraph;
+        auto [it, added] = screenIndex.emplace( screen, screenSubgraphs.size() );
 
-                std::list<SCH_ITEM*> memberlist;
+        if( added )
+            screenSubgraphs.emplace_back();
 
-                auto get_items =
-                        [&]( SCH_ITEM* aItem ) -> bool
-                        {
-                            SCH_CONNECTION* conn = aItem->GetOrInitConnection( sheet, this );
-                            bool unique = !( aItem->GetFlags() & CANDIDATE );
+        screenSubgraphs[it->second].items.push_back( ii );
+    }
 
-                            if( conn && !conn->SubgraphCode() )
-                                aItem->SetFlags( CANDIDATE );
+    auto buildScreenSubgraphs =
+            [&]( SCREEN_SUBGRAPHS& aScreen )
+            {
+                for( size_t itemIdx : aScreen.items )
+                {
+                    SCH_ITEM* item = m_items[itemIdx];
 
-                            return ( unique && conn && ( conn->SubgraphCode() == 0 ) );
-                        };
+                    for( const auto& it : item->m_connection_map )
+                    {
+                        const SCH_SHEET_PATH& sheet = it.first;
+                        SCH_CONNECTION*       connection = it.second;
 
-                std::copy_if( item->ConnectedItems( sheet ).begin(),
-                              item->ConnectedItems( sheet ).end(),
-                              std::back_inserter( memberlist ), get_items );
+                        if( connection->SubgraphCode() != 0 )
+                            continue;
 
-                for( SCH_ITEM* connected_item : memberlist )
-                {
-                    if( connected_item->Type() == SCH_NO_CONNECT_T )
-                        subgraph->m_no_connect = connected_item;
+                        // The subgraph is given its code once all screens are done.  Until
+                        // then any non-zero code marks the items already in a subgraph.
+                        CONNECTION_SUBGRAPH* subgraph = new CONNECTION_SUBGRAPH( this );
 
-                    SCH_CONNECTION* connected_conn = connected_item->Connection( &sheet );
+                        subgraph->m_sheet = sheet;
 
-                    wxASSERT( connected_conn );
+                        subgraph->AddItem( item );
 
-                    if( connected_conn->SubgraphCode() == 0 )
-                    {
-                        connected_conn->SetSubgraphCode( subgraph->m_code );
-                        m_item_to_subgraph_map[connected_item] = subgraph;
-                        subgraph->AddItem( connected_item );
-                        const SCH_ITEM_VEC& citemset = connected_item->ConnectedItems( sheet );
+                        connection->SetSubgraphCode( -1 );
+                        aScreen.itemToSubgraph[item] = subgraph;
+
+                        std::list<SCH_ITEM*> memberlist;
+
+                        auto get_items =
+                                [&]( SCH_ITEM* aItem ) -> bool
+                                {
+                                    SCH_CONNECTION* conn = aItem->GetOrInitConnection( sheet,
+                                                                                       this );
+                                    bool unique = !( aItem->GetFlags() & CANDIDATE );
 
-                        for( SCH_ITEM* citem : citemset )
+                                    if( conn && !conn->SubgraphCode() )
+                                        aItem->SetFlags( CANDIDATE );
+
+                                    return ( unique && conn && ( conn->SubgraphCode() == 0 ) );
+                                };
+
+                        std::copy_if( item->ConnectedItems( sheet ).begin(),
+                                      item->ConnectedItems( sheet ).end(),
+                                      std::back_inserter( memberlist ), get_items );
+
+                        for( SCH_ITEM* connected_item : memberlist )
                         {
-                            if( citem->HasFlag( CANDIDATE ) )
-                                continue;
+                            if( connected_item->Type() == SCH_NO_CONNECT_T )
+                                subgraph->m_no_connect = connected_item;
+
+                            SCH_CONNECTION* connected_conn = connected_item->Connection( &sheet );
 
-                            if( get_items( citem ) )
-                                memberlist.push_back( citem );
+                            wxASSERT( connected_conn );
+
+                            if( connected_conn->SubgraphCode() == 0 )
+                            {
+                                connected_conn->SetSubgraphCode( -1 );
+                                aScreen.itemToSubgraph[connected_item] = subgraph;
+                                subgraph->AddItem( connected_item );
+                                for( SCH_ITEM* citem : connected_item->ConnectedItems( sheet ) )
+                                {
+                                    if( citem->HasFlag( CANDIDATE ) )
+                                        continue;
+
+                                    if( get_items( citem ) )
+                                        memberlist.push_back( citem );
+                                }
+                            }
                         }
+
+                        for( SCH_ITEM* connected_item : memberlist )
+                            connected_item->ClearFlags( CANDIDATE );
+
+                        subgraph->m_dirty = true;
+                        aScreen.subgraphs.emplace_back( itemIdx, subgraph );
                     }
                 }
+            };
 
-                for( SCH_ITEM* connected_item : memberlist )
-                    connected_item->ClearFlags( CANDIDATE );
+    if( screenSubgraphs.size() > 1 )
+    {
+        GetKiCadThreadPool().parallelize_loop( screenSubgraphs.size(),
+                [&]( const int a, const int b )
+                {
+                    for( int ii = a; ii < b; ++ii )
+                        buildScreenSubgraphs( screenSubgraphs[ii] );
+                } ).wait();
+    }
+    else
+    {
+        for( SCREEN_SUBGRAPHS& screen : screenSubgraphs )
+            buildScreenSubgraphs( screen );
+    }
 
-                subgraph->m_dirty = true;
-                m_subgraphs.push_back( subgraph );
-            }
-        }
+    // Each screen's subgraphs are already in m_items order, and a stable sort keeps the
+    // subgraphs started by the same item in the order they were started.
+    std::vector<std::pair<size_t, CONNECTION_SUBGRAPH*>> newSubgraphs;
+
+    for( SCREEN_SUBGRAPHS& screen : screenSubgraphs )
+    {
+        newSubgraphs.insert( newSubgraphs.end(), screen.subgraphs.begin(),
+                             screen.subgraphs.end() );
+
+        for( const auto& [item, subgraph] : screen.itemToSubgraph )
+            m_item_to_subgraph_map[item] = subgraph;
     }
 
+    std::stable_sort( newSubgraphs.begin(), newSubgraphs.end(),
+                      []( const auto& a, const auto& b )
+                      {
+                          return a.first < b.first;
+                      } );
+
+    m_subgraphs.reserve( m_subgraphs.size() + newSubgraphs.size() );
+
+    for( const auto& [itemIdx, subgraph] : newSubgraphs )
+    {
+        subgraph->m_code = m_last_subgraph_code++;
+        m_subgraphs.push_back( subgraph );
+    }
+
+    GetKiCadThreadPool().parallelize_loop( newSubgraphs.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    CONNECTION_SUBGRAPH* subgraph = newSubgraphs[ii].second;
+
+                    for( SCH_ITEM* item : subgraph->m_items )
+                        item->Connection( &subgraph->m_sheet )->SetSubgraphCode( subgraph->m_code );
+                }
+            } ).wait();
 }
 
 void CONNECTION_GRAPH::resolveAllDrivers()
@@ -485,6 +485,32 @@ public:
     }
 
 private:
+    /**
+     * The results of updating the connectivity of one sheet which have to be merged into the
+     * graph once all sheets are done.
+     */
+    struct SHEET_CONNECTIVITY
+    {
+        std::vector<SCH_ITEM*>                            items;
+        std::vector<SCH_ITEM*>                            dirtyItems;
+        std::vector<std::pair<SCH_PIN*, SCH_CONNECTION*>> globalPowerPins;
+        std::vector<SCH_ITEM*>                            changedItems;
+    };
+
+    /**
+     * Collect the items of a sheet which need a connectivity update, and update them.
+     *
+     * This only touches items of the sheet's screen, so sheets of different screens can be
+     * updated concurrently.
+     *
+     * @param aSheet is the sheet to update.
+     * @param aUnconditional is true to update all connectable items, not just the dirty ones.
+     * @param aRecordChanges is true to record the items whose dangling state changed.
+     * @param aResult receives what has to be merged into the graph.
+     */
+    void updateSheetConnectivity( const SCH_SHEET_PATH& aSheet, bool aUnconditional,
+                                  bool aRecordChanges, SHEET_CONNECTIVITY& aResult );
+
     /**
      * Update the graphical connectivity between items (i.e. where they touch)
      * The items passed in must be on the same sheet.
@@ -507,13 +533,15 @@ private:
      * checks to ensure that the items should actually connect, the items are
      * linked together using ConnectedItems().
      *
-     * As a side effect, items are loaded into m_items for BuildConnectionGraph().
+     * As a side effect, items are loaded into aResult for BuildConnectionGraph().
      *
      * @param aSheet is the path to the sheet of all items in the list.
      * @param aItemList is a list of items to consider.
+     * @param aResult receives the items and global power pins to add to the graph.
      */
     void updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                 const std::vector<SCH_ITEM*>& aItemList );
+                                 const std::vector<SCH_ITEM*>& aItemList,
+                                 SHEET_CONNECTIVITY& aResult );
 
     /**
      * Generate the connection graph (after all item connectivity has been updated).
@@ -536,6 +564,10 @@ private:
 
     /**
      * Generate individual item subgraphs on a per-sheet basis.
+     *
+     * Items of different screens are never connected, so the subgraphs of each screen are
+     * built on the thread pool.  They are numbered in the same order as if they had been built
+     * one after the other.
      */
     void buildItemSubGraphs();
 
@@ -24,12 +24,16 @@
  */
 
 #include <algorithm>
+#include <deque>
+#include <functional>
+#include <future>
 #include <numeric>
 
 #include "connection_graph.h"
 #include "kiface_ids.h"
 #include <advanced_config.h>
 #include <common.h>     // for ExpandEnvVarSubstitutions
+#include <core/thread_pool.h>
 #include <erc/erc.h>
 #include <erc/erc_sch_pin_context.h>
 #include <gal/graphics_abstraction_layer.h>
@@ -48,6 +52,7 @@
 #include <sch_textbox.h>
 #include <sch_line.h>
 #include <schematic.h>
+#include <scoped_set_reset.h>
 #include <drawing_sheet/ds_draw_item.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
 #include <wx/ffile.h>
@@ -135,6 +140,20 @@ const std::set<ELECTRICAL_PINTYPE> DrivenPinTypes =
 extern void CheckDuplicatePins( LIB_SYMBOL* aSymbol, std::vector<wxString>& aMessages,
                                 UNITS_PROVIDER* aUnitsProvider );
 
+/// When set, the markers found by the test running on this thread are kept here instead of
+/// being added to their screen.  See ERC_TESTER::RunTests().
+static thread_local ERC_TESTER::MARKER_LIST* t_deferredMarkers = nullptr;
+
+
+static void addMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( t_deferredMarkers )
+        t_deferredMarkers->emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
+
 int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
 {
     int err_count = 0;
@@ -165,7 +184,7 @@ int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
                         ercItem->SetItems( sheet, test_item );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, sheet->GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     err_count++;
@@ -205,7 +224,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( warningExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 if( errorExpr.Matches( text ) )
@@ -217,7 +236,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( errorExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
             };
 
@@ -251,7 +270,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -279,7 +298,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    addMarker( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textItem->GetText() );
@@ -299,7 +318,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    addMarker( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textboxItem->GetText() );
@@ -317,7 +336,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -336,7 +355,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -354,7 +373,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        screen->Append( marker );
+                        addMarker( screen, marker );
                     }
                 }
             }
@@ -367,7 +386,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, text->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 testAssertion( text, sheet, screen, text->GetText() );
@@ -381,7 +400,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, textBox->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
 
                 testAssertion( textBox, sheet, screen, textBox->GetText() );
@@ -399,7 +418,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     erc->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( erc, text->GetPosition() );
-                    screen->Append( marker );
+                    addMarker( screen, marker );
                 }
             }
         }
@@ -438,7 +457,7 @@ int ERC_TESTER::TestConflictingBusAliases()
                     ercItem->SetErrorMessage( msg );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, VECTOR2I() );
-                    test->GetParent()->Append( marker );
+                    addMarker( test->GetParent(), marker );
 
                     ++err_count;
                 }
@@ -502,7 +521,7 @@ int ERC_TESTER::TestMultiunitFootprints()
                 ercItem->SetItems( unit, secondUnit );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, secondUnit->GetPosition() );
-                secondRef.GetSheetPath().LastScreen()->Append( marker );
+                addMarker( secondRef.GetSheetPath().LastScreen(), marker );
 
                 ++errors;
             }
@@ -563,7 +582,7 @@ int ERC_TESTER::TestMissingUnits()
                     ercItem->SetItems( unit );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, unit->GetPosition() );
-                    base_ref.GetSheetPath().LastScreen()->Append( marker );
+                    addMarker( base_ref.GetSheetPath().LastScreen(), marker );
 
                     ++errors;
                 };
@@ -666,7 +685,7 @@ int ERC_TESTER::TestMissingNetclasses()
                                                             netclass ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             };
 
     for( const SCH_SHEET_PATH& sheet : m_sheetList )
@@ -747,7 +766,7 @@ int ERC_TESTER::TestLabelMultipleWires()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -801,7 +820,7 @@ int ERC_TESTER::TestFourWayJunction()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -870,7 +889,7 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                addMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -881,147 +900,174 @@ int ERC_TESTER::TestNoConnectPins()
 
 int ERC_TESTER::TestPinToPin()
 {
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
+
+    for( const auto& [key, subgraphs] : m_nets )
+        nets.push_back( &subgraphs );
+
+    // Nets are tested concurrently, each into its own list, and the markers are then added
+    // in the order of the nets.
+    std::vector<MARKER_LIST> netMarkers( nets.size() );
+
+    auto testNets =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                for( size_t ii = aFirst; ii < aLast; ++ii )
+                    testPinToPinNet( *nets[ii], netMarkers[ii] );
+            };
+
+    GetKiCadThreadPool().parallelize_loop( nets.size(), testNets ).wait();
+
     int errors = 0;
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    for( const MARKER_LIST& markers : netMarkers )
     {
-        std::vector<ERC_SCH_PIN_CONTEXT>           pins;
-        std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
-        bool has_noconnect = false;
-
-        for( CONNECTION_SUBGRAPH* subgraph: net.second )
+        for( const auto& [screen, marker] : markers )
         {
-            if( subgraph->GetNoConnect() )
-                has_noconnect = true;
+            addMarker( screen, marker );
+            errors++;
+        }
+    }
 
-            for( SCH_ITEM* item : subgraph->GetItems() )
+    return errors;
+}
+
+
+void ERC_TESTER::testPinToPinNet( const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs,
+                                  MARKER_LIST& aMarkers )
+{
+    std::vector<ERC_SCH_PIN_CONTEXT>           pins;
+    std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
+    bool has_noconnect = false;
+
+    for( CONNECTION_SUBGRAPH* subgraph: aSubgraphs )
+    {
+        if( subgraph->GetNoConnect() )
+            has_noconnect = true;
+
+        for( SCH_ITEM* item : subgraph->GetItems() )
+        {
+            if( item->Type() == SCH_PIN_T )
             {
-                if( item->Type() == SCH_PIN_T )
-                {
-                    pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
-                    pinToScreenMap[item] = subgraph->GetSheet().LastScreen();
-                }
+                pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
+                pinToScreenMap[item] = subgraph->GetSheet().LastScreen();
             }
         }
+    }
 
-        std::sort( pins.begin(), pins.end(),
-                   []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
-                   {
-                       int ret = StrNumCmp( lhs.Pin()->GetParentSymbol()->GetRef( &lhs.Sheet() ),
-                                            rhs.Pin()->GetParentSymbol()->GetRef( &rhs.Sheet() ) );
+    std::sort( pins.begin(), pins.end(),
+               []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
+               {
+                   int ret = StrNumCmp( lhs.Pin()->GetParentSymbol()->GetRef( &lhs.Sheet() ),
+                                        rhs.Pin()->GetParentSymbol()->GetRef( &rhs.Sheet() ) );
 
-                       if( ret == 0 )
-                           ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
+                   if( ret == 0 )
+                       ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
 
-                       if( ret == 0 )
-                           ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
+                   if( ret == 0 )
+                       ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
 
-                       return ret < 0;
-                   } );
+                   return ret < 0;
+               } );
 
-        ERC_SCH_PIN_CONTEXT needsDriver;
-        ELECTRICAL_PINTYPE  needsDriverType = ELECTRICAL_PINTYPE::PT_UNSPECIFIED;
-        bool                hasDriver = false;
+    ERC_SCH_PIN_CONTEXT needsDriver;
+    ELECTRICAL_PINTYPE  needsDriverType = ELECTRICAL_PINTYPE::PT_UNSPECIFIED;
+    bool                hasDriver = false;
 
-        // We need different drivers for power nets and normal nets.
-        // A power net has at least one pin having the ELECTRICAL_PINTYPE::PT_POWER_IN
-        // and power nets can be driven only by ELECTRICAL_PINTYPE::PT_POWER_OUT pins
-        bool     ispowerNet  = false;
+    // We need different drivers for power nets and normal nets.
+    // A power net has at least one pin having the ELECTRICAL_PINTYPE::PT_POWER_IN
+    // and power nets can be driven only by ELECTRICAL_PINTYPE::PT_POWER_OUT pins
+    bool     ispowerNet  = false;
 
-        for( ERC_SCH_PIN_CONTEXT& refPin : pins )
+    for( ERC_SCH_PIN_CONTEXT& refPin : pins )
+    {
+        if( refPin.Pin()->GetType() == ELECTRICAL_PINTYPE::PT_POWER_IN )
         {
-            if( refPin.Pin()->GetType() == ELECTRICAL_PINTYPE::PT_POWER_IN )
-            {
-                ispowerNet = true;
-                break;
-            }
+            ispowerNet = true;
+            break;
         }
+    }
 
-        for( auto refIt = pins.begin(); refIt != pins.end(); ++refIt )
-        {
-            ERC_SCH_PIN_CONTEXT& refPin = *refIt;
-            ELECTRICAL_PINTYPE refType = refPin.Pin()->GetType();
+    for( auto refIt = pins.begin(); refIt != pins.end(); ++refIt )
+    {
+        ERC_SCH_PIN_CONTEXT& refPin = *refIt;
+        ELECTRICAL_PINTYPE refType = refPin.Pin()->GetType();
 
-            if( DrivenPinTypes.contains( refType ) )
+        if( DrivenPinTypes.contains( refType ) )
+        {
+            // needsDriver will be the pin shown in the error report eventually, so try to
+            // upgrade to a "better" pin if possible: something visible and only a power symbol
+            // if this net needs a power driver
+            if( !needsDriver.Pin()
+                || ( !needsDriver.Pin()->IsVisible() && refPin.Pin()->IsVisible() )
+                || ( ispowerNet != ( needsDriverType == ELECTRICAL_PINTYPE::PT_POWER_IN )
+                     && ispowerNet == ( refType == ELECTRICAL_PINTYPE::PT_POWER_IN ) ) )
             {
-                // needsDriver will be the pin shown in the error report eventually, so try to
-                // upgrade to a "better" pin if possible: something visible and only a power symbol
-                // if this net needs a power driver
-                if( !needsDriver.Pin()
-                    || ( !needsDriver.Pin()->IsVisible() && refPin.Pin()->IsVisible() )
-                    || ( ispowerNet != ( needsDriverType == ELECTRICAL_PINTYPE::PT_POWER_IN )
-                         && ispowerNet == ( refType == ELECTRICAL_PINTYPE::PT_POWER_IN ) ) )
-                {
-                    needsDriver = refPin;
-                    needsDriverType = needsDriver.Pin()->GetType();
-                }
+                needsDriver = refPin;
+                needsDriverType = needsDriver.Pin()->GetType();
             }
+        }
 
-            if( ispowerNet )
-                hasDriver |= ( DrivingPowerPinTypes.count( refType ) != 0 );
-            else
-                hasDriver |= ( DrivingPinTypes.count( refType ) != 0 );
+        if( ispowerNet )
+            hasDriver |= ( DrivingPowerPinTypes.count( refType ) != 0 );
+        else
+            hasDriver |= ( DrivingPinTypes.count( refType ) != 0 );
 
-            for( auto testIt = refIt + 1; testIt != pins.end(); ++testIt )
-            {
-                ERC_SCH_PIN_CONTEXT& testPin = *testIt;
+        for( auto testIt = refIt + 1; testIt != pins.end(); ++testIt )
+        {
+            ERC_SCH_PIN_CONTEXT& testPin = *testIt;
 
-                // Multiple pins in the same symbol that share a type,
-                // name and position are considered
-                // "stacked" and shouldn't trigger ERC errors
-                if( refPin.Pin()->IsStacked( testPin.Pin() ) && refPin.Sheet() == testPin.Sheet() )
-                    continue;
+            // Multiple pins in the same symbol that share a type,
+            // name and position are considered
+            // "stacked" and shouldn't trigger ERC errors
+            if( refPin.Pin()->IsStacked( testPin.Pin() ) && refPin.Sheet() == testPin.Sheet() )
+                continue;
 
-                ELECTRICAL_PINTYPE testType = testPin.Pin()->GetType();
+            ELECTRICAL_PINTYPE testType = testPin.Pin()->GetType();
 
-                if( ispowerNet )
-                    hasDriver |= DrivingPowerPinTypes.contains( testType );
-                else
-                    hasDriver |= DrivingPinTypes.contains( testType );
+            if( ispowerNet )
+                hasDriver |= DrivingPowerPinTypes.contains( testType );
+            else
+                hasDriver |= DrivingPinTypes.contains( testType );
 
-                PIN_ERROR erc = m_settings.GetPinMapValue( refType, testType );
+            PIN_ERROR erc = m_settings.GetPinMapValue( refType, testType );
 
-                if( erc != PIN_ERROR::OK && m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_WARNING ) )
-                {
-                    std::shared_ptr<ERC_ITEM> ercItem =
-                            ERC_ITEM::Create( erc == PIN_ERROR::WARNING ? ERCE_PIN_TO_PIN_WARNING :
-                                                                          ERCE_PIN_TO_PIN_ERROR );
-                    ercItem->SetItems( refPin.Pin(), testPin.Pin() );
-                    ercItem->SetSheetSpecificPath( refPin.Sheet() );
-                    ercItem->SetItemsSheetPaths( refPin.Sheet(), testPin.Sheet() );
-
-                    ercItem->SetErrorMessage(
-                            wxString::Format( _( "Pins of type %s and %s are connected" ),
-                                              ElectricalPinTypeGetText( refType ),
-                                              ElectricalPinTypeGetText( testType ) ) );
-
-                    SCH_MARKER* marker = new SCH_MARKER( ercItem, refPin.Pin()->GetPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
-                    errors++;
-                }
+            if( erc != PIN_ERROR::OK && m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_WARNING ) )
+            {
+                std::shared_ptr<ERC_ITEM> ercItem =
+                        ERC_ITEM::Create( erc == PIN_ERROR::WARNING ? ERCE_PIN_TO_PIN_WARNING :
+                                                                      ERCE_PIN_TO_PIN_ERROR );
+                ercItem->SetItems( refPin.Pin(), testPin.Pin() );
+                ercItem->SetSheetSpecificPath( refPin.Sheet() );
+                ercItem->SetItemsSheetPaths( refPin.Sheet(), testPin.Sheet() );
+
+                ercItem->SetErrorMessage(
+                        wxString::Format( _( "Pins of type %s and %s are connected" ),
+                                          ElectricalPinTypeGetText( refType ),
+                                          ElectricalPinTypeGetText( testType ) ) );
+
+                SCH_MARKER* marker = new SCH_MARKER( ercItem, refPin.Pin()->GetPosition() );
+                aMarkers.emplace_back( pinToScreenMap[refPin.Pin()], marker );
             }
         }
+    }
 
-        if( needsDriver.Pin() && !hasDriver && !has_noconnect )
-        {
-            int err_code = ispowerNet ? ERCE_POWERPIN_NOT_DRIVEN : ERCE_PIN_NOT_DRIVEN;
+    if( needsDriver.Pin() && !hasDriver && !has_noconnect )
+    {
+        int err_code = ispowerNet ? ERCE_POWERPIN_NOT_DRIVEN : ERCE_PIN_NOT_DRIVEN;
 
-            if( m_settings.IsTestEnabled( err_code ) )
-            {
-                std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( err_code );
+        if( m_settings.IsTestEnabled( err_code ) )
+        {
+            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( err_code );
 
-                ercItem->SetItems( needsDriver.Pin() );
-                ercItem->SetSheetSpecificPath( needsDriver.Sheet() );
-                ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
+            ercItem->SetItems( needsDriver.Pin() );
+            ercItem->SetSheetSpecificPath( needsDriver.Sheet() );
+            ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
-                errors++;
-            }
+            SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
+            aMarkers.emplace_back( pinToScreenMap[needsDriver.Pin()], marker );
         }
     }
-
-    return errors;
 }
 
 
@@ -1070,7 +1116,7 @@ int ERC_TESTER::TestMultUnitPinConflicts()
                         ercItem->SetItemsSheetPaths( sheet, sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        sheet.LastScreen()->Append( marker );
+                        addMarker( sheet.LastScreen(), marker );
                         errors += 1;
                     }
                 }
@@ -1126,7 +1172,7 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
                 ercItem->SetItemsSheetPaths( globalItem.second, localItem.second );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, globalItem.first->GetPosition() );
-                globalItem.second.LastScreen()->Append( marker );
+                addMarker( globalItem.second.LastScreen(), marker );
 
                 errCount++;
             }
@@ -1169,7 +1215,7 @@ int ERC_TESTER::TestSimilarLabels()
         ercItem->SetItemsSheetPaths( sheet, otherSheet );
 
         SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-        sheet.LastScreen()->Append( marker );
+        addMarker( sheet.LastScreen(), marker );
     };
 
     for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
@@ -1353,7 +1399,7 @@ int ERC_TESTER::TestLibSymbolIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            addMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1433,7 +1479,7 @@ int ERC_TESTER::TestFootprintLinkIssues( KIFACE* aCvPcb, PROJECT* aProject )
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            addMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1447,8 +1493,11 @@ int ERC_TESTER::TestOffGridEndpoints()
     const int gridSize = m_schematic->Settings().m_ConnectionGridSize;
     int       err_count = 0;
 
-    for( SCH_SCREEN* screen = m_screens.GetFirst(); screen; screen = m_screens.GetNext() )
+    // Don't use m_screens.GetFirst()/GetNext(): other tests may be walking it concurrently.
+    for( size_t ii = 0; ii < m_screens.GetCount(); ++ii )
     {
+        SCH_SCREEN* screen = m_screens.GetScreen( ii );
+
         std::vector<SCH_MARKER*> markers;
 
         for( SCH_ITEM* item : screen->Items() )
@@ -1496,7 +1545,7 @@ int ERC_TESTER::TestOffGridEndpoints()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            addMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1549,7 +1598,7 @@ int ERC_TESTER::TestSimModelIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            addMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1596,6 +1645,55 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
 
     m_schematic->ConnectionGraph()->RunERC();
 
+    // The remaining tests only read the schematic.  Those which don't resolve text variables,
+    // which isn't thread safe, run on the thread pool while the others run here.  Each test
+    // keeps its markers aside until all of them are done, and they are then added in the order
+    // the tests were started so that the results don't depend on the scheduling.
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::deque<MARKER_LIST>        testMarkers;
+    std::vector<std::future<void>> concurrentTests;
+    bool                           markersAdded = false;
+
+    // If a test throws, the tests still running on the thread pool use the state of this
+    // frame: wait for them before unwinding, and free the markers which won't be added.
+    SCOPED_EXECUTION<std::function<void()>> waitForTests(
+            []() {},
+            [&]()
+            {
+                for( std::future<void>& test : concurrentTests )
+                {
+                    if( test.valid() )
+                        test.wait();
+                }
+
+                if( !markersAdded )
+                {
+                    for( const MARKER_LIST& markers : testMarkers )
+                    {
+                        for( const auto& [screen, marker] : markers )
+                            delete marker;
+                    }
+                }
+            } );
+
+    auto runTest =
+            [&]( bool aConcurrent, const std::function<void()>& aTest )
+            {
+                MARKER_LIST* markers = &testMarkers.emplace_back();
+
+                auto task =
+                        [markers, aTest]()
+                        {
+                            SCOPED_SET_RESET<MARKER_LIST*> deferred( t_deferredMarkers, markers );
+                            aTest();
+                        };
+
+                if( aConcurrent )
+                    concurrentTests.push_back( tp.submit( task ) );
+                else
+                    task();
+            };
+
     if( aProgressReporter )
         aProgressReporter->AdvancePhase( _( "Checking units..." ) );
 
@@ -1605,7 +1703,7 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking footprints..." ) );
 
-        TestMultiunitFootprints();
+        runTest( true, [&]() { TestMultiunitFootprints(); } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_MISSING_UNIT )
@@ -1613,21 +1711,54 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         || m_settings.IsTestEnabled( ERCE_MISSING_POWER_INPUT_PIN )
         || m_settings.IsTestEnabled( ERCE_MISSING_BIDI_PIN ) )
     {
-        TestMissingUnits();
+        runTest( true, [&]() { TestMissingUnits(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
+    {
+        if( aProgressReporter )
+            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
+
+        runTest( true, [&]() { TestNoConnectPins(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
+    {
+        if( aProgressReporter )
+            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
+
+        runTest( true, [&]() { TestOffGridEndpoints(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
+    {
+        if( aProgressReporter )
+            aProgressReporter->AdvancePhase( _( "Checking for four way junctions..." ) );
+
+        runTest( true, [&]() { TestFourWayJunction(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
+    {
+        if( aProgressReporter )
+            aProgressReporter->AdvancePhase( _( "Checking for labels on more than one wire..." ) );
+
+        runTest( true, [&]() { TestLabelMultipleWires(); } );
     }
 
     if( aProgressReporter )
         aProgressReporter->AdvancePhase( _( "Checking pins..." ) );
 
     if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ) )
-        TestMultUnitPinConflicts();
+        runTest( false, [&]() { TestMultUnitPinConflicts(); } );
 
-    // Test pins on each net against the pin connection table
+    // Test pins on each net against the pin connection table.  The nets are tested on the
+    // thread pool.
     if( m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
         || m_settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
         || m_settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ) )
     {
-        TestPinToPin();
+        runTest( false, [&]() { TestPinToPin(); } );
     }
 
     // Test similar labels (i;e. labels which are identical when
@@ -1640,8 +1771,12 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking labels..." ) );
 
-        TestSimilarLabels();
-        TestSameLocalGlobalLabel();
+        runTest( false,
+                 [&]()
+                 {
+                     TestSimilarLabels();
+                     TestSameLocalGlobalLabel();
+                 } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
@@ -1649,7 +1784,7 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking for unresolved variables..." ) );
 
-        TestTextVars( aDrawingSheet );
+        runTest( false, [&]() { TestTextVars( aDrawingSheet ); } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_SIMULATION_MODEL ) )
@@ -1657,15 +1792,7 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking SPICE models..." ) );
 
-        TestSimModelIssues();
-    }
-
-    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
-
-        TestNoConnectPins();
+        runTest( false, [&]() { TestSimModelIssues(); } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES )
@@ -1674,7 +1801,7 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking for library symbol issues..." ) );
 
-        TestLibSymbolIssues();
+        runTest( false, [&]() { TestLibSymbolIssues(); } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_LINK_ISSUES ) && aCvPcb )
@@ -1682,40 +1809,35 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         if( aProgressReporter )
             aProgressReporter->AdvancePhase( _( "Checking for footprint link issues..." ) );
 
-        TestFootprintLinkIssues( aCvPcb, aProject );
+        runTest( false, [&]() { TestFootprintLinkIssues( aCvPcb, aProject ); } );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
+    if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
     {
         if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
+            aProgressReporter->AdvancePhase( _( "Checking for undefined netclasses..." ) );
 
-        TestOffGridEndpoints();
+        runTest( false, [&]() { TestMissingNetclasses(); } );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
+    for( std::future<void>& test : concurrentTests )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for four way junctions..." ) );
+        while( test.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready )
+        {
+            if( aProgressReporter )
+                aProgressReporter->KeepRefreshing();
+        }
 
-        TestFourWayJunction();
+        test.get();
     }
 
-    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
+    for( const MARKER_LIST& markers : testMarkers )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for labels on more than one wire..." ) );
-
-        TestLabelMultipleWires();
+        for( const auto& [screen, marker] : markers )
+            screen->Append( marker );
     }
 
-    if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for undefined netclasses..." ) );
-
-        TestMissingNetclasses();
-    }
+    markersAdded = true;
 
     m_schematic->ResolveERCExclusionsPostUpdate();
 }
@@ -42,6 +42,7 @@ class PROGRESS_REPORTER;
 struct KIFACE;
 class PROJECT;
 class SCH_RULE_AREA;
+class SCH_MARKER;
 
 
 extern const wxString CommentERC_H[];
@@ -51,6 +52,8 @@ extern const wxString CommentERC_V[];
 class ERC_TESTER
 {
 public:
+    /// Markers with the screen they belong to, in the order they were found.
+    typedef std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> MARKER_LIST;
 
     ERC_TESTER( SCHEMATIC* aSchematic ) :
             m_schematic( aSchematic ),
@@ -173,10 +176,22 @@ public:
      */
     int RunRuleAreaERC();
 
+    /**
+     * Run all the enabled tests.
+     *
+     * The tests which only read the schematic run concurrently.  Their markers are added to
+     * the screens once all tests are done, in a fixed order.
+     */
     void RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aEditFrame,
                    KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter );
 
 private:
+    /**
+     * Test the pins of a single net for #TestPinToPin, adding the markers to \a aMarkers.
+     */
+    void testPinToPinNet( const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs,
+                          MARKER_LIST& aMarkers );
+
     SCHEMATIC*                   m_schematic;
     ERC_SETTINGS&                m_settings;
     SCH_SHEET_LIST               m_sheetList;
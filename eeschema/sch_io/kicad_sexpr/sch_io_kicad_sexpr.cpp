@@ -1615,7 +1615,15 @@ void SCH_IO_KICAD_SEXPR::cacheLib( const wxString& aLibraryFileName,
         m_cache = new SCH_IO_KICAD_SEXPR_LIB_CACHE( aLibraryFileName );
 
         if( !isBuffering( aProperties ) )
+        {
+            // Large libraries are only indexed, their symbols being parsed when requested.
+            long long lazySize = ADVANCED_CFG::GetCfg().m_SymbolLibLazyLoadSize;
+            wxFileName fn( aLibraryFileName );
+
+            m_cache->SetLazyLoading( lazySize > 0 && fn.FileExists()
+                                     && fn.GetSize() >= wxULongLong( lazySize * 1024 * 1024 ) );
             m_cache->Load();
+        }
     }
 }
 
@@ -1647,13 +1655,7 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
-    {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolNameList.Add( it->first );
-    }
+    m_cache->GetSymbolNames( aSymbolNameList, powerSymbolsOnly );
 }
 
 
@@ -1667,6 +1669,7 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
     cacheLib( aLibraryPath, aProperties );
+    m_cache->LoadAllSymbols();
 
     const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
 
@@ -1686,23 +1689,20 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
 
     cacheLib( aLibraryPath, aProperties );
 
-    LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
+    LIB_SYMBOL* symbol = m_cache->GetSymbol( aSymbolName );
 
     // We no longer escape '/' in symbol names, but we used to.
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( '/' ) )
-        it = m_cache->m_symbols.find( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
+    if( !symbol && aSymbolName.Contains( '/' ) )
+        symbol = m_cache->GetSymbol( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
 
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( wxT( "{slash}" ) ) )
+    if( !symbol && aSymbolName.Contains( wxT( "{slash}" ) ) )
     {
         wxString unescaped = aSymbolName;
         unescaped.Replace( wxT( "{slash}" ), wxT( "/" ) );
-        it = m_cache->m_symbols.find( unescaped );
+        symbol = m_cache->GetSymbol( unescaped );
     }
 
-    if( it == m_cache->m_symbols.end() )
-        return nullptr;
-
-    return it->second;
+    return symbol;
 }
 
 
@@ -1812,6 +1812,8 @@ void SCH_IO_KICAD_SEXPR::GetAvailableSymbolFields( std::vector<wxString>& aNames
     if( !m_cache )
         return;
 
+    m_cache->LoadAllSymbols();
+
     const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
 
     std::set<wxString> fieldNames;
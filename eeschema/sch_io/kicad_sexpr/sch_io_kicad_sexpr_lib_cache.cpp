@@ -22,6 +22,8 @@
 #include <wx/log.h>
 #include <base_units.h>
 #include <build_version.h>
+#include <dsnlexer.h>
+#include <kiplatform/io.h>
 #include <sch_shape.h>
 #include <lib_symbol.h>
 #include <sch_textbox.h>
@@ -39,6 +41,98 @@ SCH_IO_KICAD_SEXPR_LIB_CACHE::SCH_IO_KICAD_SEXPR_LIB_CACHE( const wxString& aFul
     SCH_IO_LIB_CACHE( aFullPathAndFileName )
 {
     m_fileFormatVersionAtLoad = 0;
+    m_lazyLoading = false;
+}
+
+
+/**
+ * A library file mapped in memory for the time it is lazily read.
+ */
+class MAPPED_LIB_FILE
+{
+public:
+    MAPPED_LIB_FILE( const wxString& aFileName ) :
+            m_data( nullptr ),
+            m_size( 0 )
+    {
+        if( !KIPLATFORM::IO::MapFile( aFileName, m_data, m_size ) )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open %s for reading." ),
+                                              aFileName ) );
+        }
+    }
+
+    ~MAPPED_LIB_FILE()
+    {
+        KIPLATFORM::IO::UnmapFile( m_data, m_size );
+    }
+
+    const char* m_data;
+    size_t      m_size;
+};
+
+
+/**
+ * Return the text of the s-expression token at \a aPos in \a aData, or an empty string if
+ * there is none on the same line.  A quoted token is returned with its quotes.
+ *
+ * @param aPos is the position to read from, and is moved after the token.
+ */
+static std::string sexprTokenAt( const char* aData, size_t aSize, size_t& aPos )
+{
+    auto isSep =
+            []( char c )
+            {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\0' || c == '('
+                       || c == ')' || c == '|';
+            };
+
+    while( aPos < aSize && ( aData[aPos] == ' ' || aData[aPos] == '\t' ) )
+        ++aPos;
+
+    size_t end = aPos;
+
+    if( end < aSize && aData[end] == '"' )
+    {
+        for( ++end; end < aSize && aData[end] != '"' && aData[end] != '\n'; ++end )
+        {
+            if( aData[end] == '\\' && end + 1 < aSize && aData[end + 1] != '\n' )
+                ++end;
+        }
+
+        if( end >= aSize || aData[end] != '"' )
+            return std::string();
+
+        ++end;
+    }
+    else
+    {
+        while( end < aSize && !isSep( aData[end] ) )
+            ++end;
+    }
+
+    std::string token( aData + aPos, end - aPos );
+
+    aPos = end;
+    return token;
+}
+
+
+/**
+ * Return the symbol name \a aToken, read by the s-expression lexer, as the symbol parser
+ * does it.
+ */
+static wxString lexSymbolName( const std::string& aToken )
+{
+    DSNLEXER lexer( aToken );
+
+    if( lexer.NextTok() != DSN_SYMBOL && lexer.CurTok() != DSN_STRING )
+        return wxEmptyString;
+
+    wxString name = lexer.FromUTF8();
+
+    name.Replace( wxS( "{slash}" ), wxT( "/" ) );
+    return name;
 }
 
 
@@ -66,17 +160,333 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    bool indexed = false;
 
-    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+    if( m_lazyLoading )
+    {
+        std::lock_guard<std::recursive_mutex> lock( m_lazyMutex );
+        MAPPED_LIB_FILE                       file( m_libFileName.GetFullPath() );
+
+        m_lazyFileName = m_libFileName.GetFullPath();
+        indexed = loadIndex( file.m_data, file.m_size );
+    }
+
+    if( !indexed )
+    {
+        FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+
+        SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+
+        parser.ParseLib( m_symbols );
+        SetFileFormatVersionAtLoad( parser.GetParsedRequiredVersion() );
+    }
 
-    parser.ParseLib( m_symbols );
     IncrementModifyHash();
 
     // Remember the file modification time of library file when the cache snapshot was made,
     // so that in a networked environment we will reload the cache as needed.
     m_fileModTime = GetLibModificationTime();
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_CACHE::loadIndex( const char* aData, size_t aSize )
+{
+    struct ENTRY
+    {
+        LAZY_SYMBOL m_symbol;
+        std::string m_name;
+    };
+
+    std::vector<ENTRY> entries;
+    bool               inSymbol = false;
+    bool               inString = false;
+    bool               atLineStart = true;
+    int                depth = 0;
+    unsigned           line = 1;
+    size_t             lineOffset = 0;
+
+    // A single pass over the file finding the (symbol ...) lists of the library.  The
+    // lexer rules that matter here are that strings cannot span lines, and that a line
+    // starting with '#' is a comment.
+    for( size_t ii = 0; ii < aSize; ++ii )
+    {
+        char c = aData[ii];
+
+        if( c == '\n' )
+        {
+            ++line;
+            lineOffset = ii + 1;
+            inString = false;
+            atLineStart = true;
+            continue;
+        }
+
+        if( inString )
+        {
+            if( c == '\\' && ii + 1 < aSize && aData[ii + 1] != '\n' )
+                ++ii;
+            else if( c == '"' )
+                inString = false;
+
+            continue;
+        }
+
+        if( atLineStart )
+        {
+            if( c == ' ' || c == '\t' || c == '\r' )
+                continue;
+
+            atLineStart = false;
+
+            if( c == '#' )
+            {
+                while( ii + 1 < aSize && aData[ii + 1] != '\n' )
+                    ++ii;
+
+                continue;
+            }
+        }
+
+        if( c == '"' )
+        {
+            inString = true;
+        }
+        else if( c == '(' )
+        {
+            ++depth;
+
+            if( depth == 2 || ( depth == 3 && inSymbol ) )
+            {
+                size_t      pos = ii + 1;
+                std::string keyword = sexprTokenAt( aData, aSize, pos );
+
+                if( depth == 2 && keyword == "symbol" )
+                {
+                    ENTRY& entry = entries.emplace_back();
+                    entry.m_symbol.m_offset = ii;
+                    entry.m_symbol.m_line = line;
+                    entry.m_symbol.m_column = static_cast<unsigned>( ii - lineOffset );
+                    entry.m_symbol.m_isPower = false;
+                    entry.m_name = sexprTokenAt( aData, aSize, pos );
+                    inSymbol = true;
+                }
+                else if( depth == 2 && !entries.empty() )
+                {
+                    // Something else than symbols after the first one: not worth indexing.
+                    return false;
+                }
+                else if( depth == 3 && keyword == "power" )
+                {
+                    entries.back().m_symbol.m_isPower = true;
+                }
+                else if( depth == 3 && keyword == "extends" )
+                {
+                    wxString parent = lexSymbolName( sexprTokenAt( aData, aSize, pos ) );
+
+                    if( parent.IsEmpty() )
+                        return false;
+
+                    entries.back().m_symbol.m_parent = parent;
+                }
+            }
+        }
+        else if( c == ')' )
+        {
+            if( depth == 2 && inSymbol )
+            {
+                entries.back().m_symbol.m_length = ii + 1 - entries.back().m_symbol.m_offset;
+                inSymbol = false;
+            }
+
+            if( --depth < 0 )
+                return false;
+        }
+    }
+
+    if( entries.empty() || inSymbol || inString || depth != 0 )
+        return false;
+
+    // The map keys are the names the parser gives the symbols.
+    std::map<wxString, LAZY_SYMBOL, LibSymbolMapSort> index;
+    wxString                                          firstName;
+
+    for( ENTRY& entry : entries )
+    {
+        wxString name = lexSymbolName( entry.m_name );
+        LIB_ID   id;
+
+        if( name.IsEmpty() || id.Parse( name ) >= 0 )
+            return false;
+
+        name = id.GetLibItemName().wx_str();
+
+        if( firstName.IsEmpty() )
+            firstName = name;
+        else if( name == firstName || !index.emplace( name, entry.m_symbol ).second )
+            return false;
+    }
+
+    for( const auto& [name, symbol] : index )
+    {
+        if( !symbol.m_parent.IsEmpty() && symbol.m_parent != firstName
+          && index.find( symbol.m_parent ) == index.end() )
+        {
+            return false;
+        }
+    }
+
+    // Parse the header and the first symbol, which checks the file version.
+    std::string header( aData, entries[0].m_symbol.m_offset + entries[0].m_symbol.m_length );
+
+    header += "\n)\n";
+
+    STRING_LINE_READER        reader( std::move( header ), m_lazyFileName, 1 );
+    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+
+    parser.ParseLib( m_symbols );
     SetFileFormatVersionAtLoad( parser.GetParsedRequiredVersion() );
+
+    m_lazySymbols = std::move( index );
+
+    wxLogTrace( traceSchLegacyPlugin, "Indexed %zu symbols of library file '%s'",
+                m_lazySymbols.size(), m_lazyFileName );
+
+    return true;
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_LIB_CACHE::parseLazySymbol( const wxString& aName,
+                                                           const char* aData, size_t aSize )
+{
+    auto it = m_lazySymbols.find( aName );
+
+    if( it == m_lazySymbols.end() )
+        return SCH_IO_LIB_CACHE::GetSymbol( aName );
+
+    // Removed while parsing so that a broken library cannot recurse forever, and put back if
+    // the parsing fails so that the next request reports the same error.
+    LAZY_SYMBOL lazy = it->second;
+    m_lazySymbols.erase( it );
+
+    try
+    {
+        if( !lazy.m_parent.IsEmpty() )
+            parseLazySymbol( lazy.m_parent, aData, aSize );
+
+        if( lazy.m_offset + lazy.m_length > aSize )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Library file '%s' changed while being read." ),
+                                              m_lazyFileName ) );
+        }
+
+        // Pad the first line so that parse errors report the columns of the file.
+        std::string text( lazy.m_column, ' ' );
+
+        text.append( aData + lazy.m_offset, lazy.m_length );
+        text += '\n';
+
+        STRING_LINE_READER        reader( std::move( text ), m_lazyFileName, lazy.m_line );
+        SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+        LIB_SYMBOL*               symbol = parser.ParseLibSymbol( m_symbols,
+                                                                  m_fileFormatVersionAtLoad );
+
+        m_symbols[symbol->GetName()] = symbol;
+
+        return symbol;
+    }
+    catch( ... )
+    {
+        m_lazySymbols.emplace( aName, lazy );
+        throw;
+    }
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_CACHE::isLazyPower( const LAZY_SYMBOL& aSymbol, int aDepth ) const
+{
+    // Derived symbols are power symbols when their root symbol is, as in LIB_SYMBOL::IsPower().
+    if( aSymbol.m_parent.IsEmpty() )
+        return aSymbol.m_isPower;
+
+    if( aDepth > static_cast<int>( m_lazySymbols.size() ) )
+        return false;
+
+    auto lazyIt = m_lazySymbols.find( aSymbol.m_parent );
+
+    if( lazyIt != m_lazySymbols.end() )
+        return isLazyPower( lazyIt->second, aDepth + 1 );
+
+    auto it = m_symbols.find( aSymbol.m_parent );
+
+    return it != m_symbols.end() && it->second->IsPower();
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbol( const wxString& aName )
+{
+    std::lock_guard<std::recursive_mutex> lock( m_lazyMutex );
+
+    if( m_lazySymbols.find( aName ) == m_lazySymbols.end() )
+        return SCH_IO_LIB_CACHE::GetSymbol( aName );
+
+    LOCALE_IO       toggle;
+    MAPPED_LIB_FILE file( m_lazyFileName );
+
+    return parseLazySymbol( aName, file.m_data, file.m_size );
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly )
+{
+    std::lock_guard<std::recursive_mutex> lock( m_lazyMutex );
+
+    LibSymbolMapSort less;
+    auto             parsed = m_symbols.begin();
+    auto             lazy = m_lazySymbols.begin();
+
+    // Both maps use the same ordering and never share a name.
+    while( parsed != m_symbols.end() || lazy != m_lazySymbols.end() )
+    {
+        if( lazy == m_lazySymbols.end()
+          || ( parsed != m_symbols.end() && less( parsed->first, lazy->first ) ) )
+        {
+            if( !aPowerSymbolsOnly || parsed->second->IsPower() )
+                aNames.Add( parsed->first );
+
+            ++parsed;
+        }
+        else
+        {
+            if( !aPowerSymbolsOnly || isLazyPower( lazy->second ) )
+                aNames.Add( lazy->first );
+
+            ++lazy;
+        }
+    }
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::LoadAllSymbols()
+{
+    std::lock_guard<std::recursive_mutex> lock( m_lazyMutex );
+
+    if( m_lazySymbols.empty() )
+        return;
+
+    LOCALE_IO       toggle;
+    MAPPED_LIB_FILE file( m_lazyFileName );
+
+    while( !m_lazySymbols.empty() )
+        parseLazySymbol( m_lazySymbols.begin()->first, file.m_data, file.m_size );
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::AddSymbol( const LIB_SYMBOL* aSymbol )
+{
+    // The new symbol may replace, or derive from, a symbol not parsed yet.
+    LoadAllSymbols();
+
+    SCH_IO_LIB_CACHE::AddSymbol( aSymbol );
 }
 
 
@@ -85,6 +495,8 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
     if( !m_isModified )
         return;
 
+    LoadAllSymbols();
+
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
     // Write through symlinks, don't replace them.
@@ -542,6 +954,9 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::saveTextBox( SCH_TEXTBOX* aTextBox, OUTPUTFOR
 
 void SCH_IO_KICAD_SEXPR_LIB_CACHE::DeleteSymbol( const wxString& aSymbolName )
 {
+    // Deleting a root symbol deletes the symbols derived from it too.
+    LoadAllSymbols();
+
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( aSymbolName );
 
     if( it == m_symbols.end() )
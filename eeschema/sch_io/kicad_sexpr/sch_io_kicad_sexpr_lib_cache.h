@@ -22,6 +22,9 @@
 #ifndef SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 #define SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 
+#include <map>
+#include <mutex>
+
 #include "sch_io/sch_io_lib_cache.h"
 
 class FILE_LINE_READER;
@@ -49,8 +52,37 @@ public:
 
     void Load() override;
 
+    void AddSymbol( const LIB_SYMBOL* aSymbol ) override;
+
     void DeleteSymbol( const wxString& aName ) override;
 
+    /**
+     * Return the symbol \a aName, parsing it first when the library was loaded lazily and
+     * the symbol has not been requested yet.
+     */
+    LIB_SYMBOL* GetSymbol( const wxString& aName ) override;
+
+    /**
+     * Add the names of the library symbols to \a aNames, in the order of #LibSymbolMapSort
+     * like #GetSymbolMap, without parsing the symbols which have not been loaded yet.
+     */
+    void GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly );
+
+    /**
+     * Only index the symbols of the library file in #Load, each symbol being parsed the first
+     * time it is requested with #GetSymbol.
+     *
+     * This only pays off for large libraries of which few symbols are used.  Anything needing
+     * the whole library, such as saving it, parses the remaining symbols first.
+     */
+    void SetLazyLoading( bool aLazy ) { m_lazyLoading = aLazy; }
+
+    /**
+     * Parse the symbols of a lazily loaded library which have not been requested yet, so
+     * that #GetSymbolMap holds the whole library.
+     */
+    void LoadAllSymbols();
+
     static void SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter, int aNestLevel = 0,
                             const wxString& aLibName = wxEmptyString, bool aIncludeData = true );
 
@@ -60,8 +92,42 @@ public:
 private:
     friend SCH_IO_KICAD_SEXPR;
 
+    /// Location in the library file of a symbol not parsed yet.
+    struct LAZY_SYMBOL
+    {
+        size_t   m_offset;     ///< Offset of the opening parenthesis of the symbol.
+        size_t   m_length;
+        unsigned m_line;       ///< Line number of the opening parenthesis.
+        unsigned m_column;     ///< Offset of the opening parenthesis in its line.
+        bool     m_isPower;    ///< The symbol has a (power) token.
+        wxString m_parent;     ///< Name of the parent symbol of a derived symbol.
+    };
+
+    /**
+     * Index the symbols of the library file \a aData and parse its header and first symbol.
+     *
+     * @return false if the file should be parsed in full instead, because it is not laid out
+     *         the way the symbol library writer does it.
+     */
+    bool loadIndex( const char* aData, size_t aSize );
+
+    /**
+     * Parse the lazily loaded symbol \a aName, and its parent first if needed, from the
+     * library file \a aData into m_symbols.
+     *
+     * @throw IO_ERROR if the symbol cannot be parsed, in which case it stays in the index.
+     */
+    LIB_SYMBOL* parseLazySymbol( const wxString& aName, const char* aData, size_t aSize );
+
+    bool isLazyPower( const LAZY_SYMBOL& aSymbol, int aDepth = 0 ) const;
+
     int m_fileFormatVersionAtLoad;
 
+    bool                                               m_lazyLoading;
+    wxString                                           m_lazyFileName;
+    std::map<wxString, LAZY_SYMBOL, LibSymbolMapSort>  m_lazySymbols;
+    std::recursive_mutex                               m_lazyMutex;
+
     static void saveSymbolDrawItem( SCH_ITEM* aItem, OUTPUTFORMATTER& aFormatter,
                                     int aNestLevel );
     static void saveField( SCH_FIELD* aField, OUTPUTFORMATTER& aFormatter, int aNestLevel );
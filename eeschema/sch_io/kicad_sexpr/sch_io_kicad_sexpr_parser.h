@@ -82,6 +82,17 @@ public:
 
     void ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap );
 
+    /**
+     * Parse a single symbol of a symbol library file the way #ParseLib does, without the
+     * library header.
+     *
+     * The parent of a derived symbol must already be in \a aSymbolLibMap.  The parsed symbol
+     * is returned but not added to \a aSymbolLibMap.
+     *
+     * @param aFileVersion The version of the library file the symbol is read from.
+     */
+    LIB_SYMBOL* ParseLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap, int aFileVersion );
+
     /**
      * Parse internal #LINE_READER object into symbols and return all found.
      */
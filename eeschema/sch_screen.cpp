@@ -1504,6 +1504,7 @@ void SCH_SCREEN::FixupEmbeddedData()
                 embeddedFile->decompressedData = file->decompressedData;
                 embeddedFile->data_sha = file->data_sha;
                 embeddedFile->is_valid = file->is_valid;
+                embeddedFile->is_compressed_only = file->is_compressed_only;
             }
         }
     }
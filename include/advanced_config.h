@@ -635,6 +635,29 @@ public:
      */
     bool m_ZoneConnectionFiller;
 
+    /**
+     * Size, in MiB, from which a .kicad_sym library is only indexed when it is loaded, its
+     * symbols being parsed the first time they are requested.  0 disables lazy loading.
+     *
+     * Setting name: "SymbolLibLazyLoadSize"
+     * Valid values: 0 to 2147483647
+     * Default value: 16
+     */
+    int m_SymbolLibLazyLoadSize;
+
+    /**
+     * Minimum number of vertices in the inputs of a polygon boolean operation for it to be cut
+     * into tiles which are processed on the thread pool.  0 disables tiling.
+     *
+     * Tiled results may differ from untiled ones by rounding along the tile seams, and their
+     * polygons may come out in a different order, so tiling is off by default.
+     *
+     * Setting name: "TiledBooleanMinVertices"
+     * Valid values: 0 to 2147483647
+     * Default value: 0
+     */
+    int m_TiledBooleanMinVertices;
+
 ///@}
 
 private:
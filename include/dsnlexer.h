@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <hashtables.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <richio.h>
@@ -316,6 +317,21 @@ public:
      */
     wxArrayString* ReadCommentLines();
 
+    /**
+     * Copy the raw text of the list whose keyword is the current token, through its closing
+     * #DSN_RIGHT, without tokenizing it.
+     *
+     * The text is prefixed with the list's opening parenthesis (at the keyword's column) so it
+     * can be handed whole to another lexer.  Quoted strings and comment lines are honored when
+     * matching parentheses.  Upon return the closing #DSN_RIGHT is the current token.  Only
+     * available in non-specctraMode.
+     *
+     * @param aText receives the text of the list.
+     * @return the line number of the first line of the list.
+     * @throw IO_ERROR if the end of the input is reached before the list is closed.
+     */
+    int ReadRawList( std::string& aText );
+
     /**
      * Test a token to see if it is a symbol.
      *
@@ -406,7 +422,7 @@ public:
      */
     const char* CurText() const
     {
-        return curText.c_str();
+        return CurStr().c_str();
     }
 
     /**
@@ -414,16 +430,33 @@ public:
      */
     const std::string& CurStr() const
     {
+        if( curTextIsView )
+        {
+            curText.assign( curView );
+            curTextIsView = false;
+        }
+
         return curText;
     }
 
+    /**
+     * Return the current token's text without copying it.  Numbers and delimiters are
+     * returned as a view of the reader's line.  The view is valid until the next NextTok().
+     */
+    std::string_view CurView() const
+    {
+        return curTextIsView ? curView : std::string_view( curText );
+    }
+
     /**
      * Return the current token text as a wxString, assuming that the input byte stream
      * is UTF8 encoded.
      */
     wxString FromUTF8() const
     {
-        return wxString::FromUTF8( curText.c_str() );
+        std::string_view text = CurView();
+
+        return wxString::FromUTF8( text.data(), text.size() );
     }
 
     /**
@@ -439,7 +472,9 @@ public:
      */
     const char* CurLine() const
     {
-        return (const char*)(*reader);
+        // The line may be a view into a mapped file, which isn't nul terminated
+        curLine.assign( start, limit );
+        return curLine.c_str();
     }
 
     /**
@@ -471,22 +506,30 @@ protected:
     {
         if( reader )
         {
-            reader->ReadLine();
-
-            unsigned len = reader->Length();
+            std::string_view line = reader->ReadLineView();
 
-            // start may have changed in ReadLine(), which can resize and
-            // relocate reader's line buffer.
-            start = reader->Line();
+            // start may have changed in ReadLineView(), which can resize and
+            // relocate reader's line buffer, or may point into a mapped file.
+            start = line.empty() ? reader->Line() : line.data();
 
             next  = start;
-            limit = next + len;
+            limit = next + line.size();
 
-            return len;
+            return line.size();
         }
         return 0;
     }
 
+    /**
+     * Make the current token a view of [\a aBegin, \a aEnd) in the current line, to be copied
+     * into curText only if it is asked for.
+     */
+    void setCurView( const char* aBegin, const char* aEnd )
+    {
+        curView = std::string_view( aBegin, aEnd - aBegin );
+        curTextIsView = true;
+    }
+
     /**
      * Take @a aToken string and looks up the string in the keywords table.
      *
@@ -556,7 +599,10 @@ protected:
     int                 curOffset;              ///< offset within current line of the current token
 
     int                 curTok;                 ///< the current token obtained on last NextTok()
-    std::string         curText;                ///< the text of the current token
+    mutable std::string curText;                ///< the text of the current token
+    std::string_view    curView;                ///< the current token in the line, if curTextIsView
+    mutable bool        curTextIsView;          ///< curText is stale, the token is in curView
+    mutable std::string curLine;                ///< storage for CurLine()
 
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
@@ -52,6 +52,18 @@ struct KICOMMON_API SEARCH_TERM
             Normalized( false )
     {}
 
+    /**
+     * Convert Text to the lower case, trimmed form used for matching (once).
+     */
+    void Normalize()
+    {
+        if( !Normalized )
+        {
+            Text = Text.MakeLower().Trim( false ).Trim( true );
+            Normalized = true;
+        }
+    }
+
     wxString Text;
     int      Score;
     bool     Normalized;
@@ -243,14 +255,27 @@ public:
 
     const wxString& GetPattern() const;
 
+    /**
+     * Score aWeightedTerms against the pattern.
+     *
+     * For a literal pattern this only reads the matcher, so it can be called for different
+     * term lists from several threads.
+     */
     int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms );
 
+    /**
+     * @return true if all the matchers reduce to a plain substring search of the pattern,
+     *         i.e. if a term can only match if it contains the pattern.
+     */
+    bool IsLiteral() const { return m_literal; }
+
 private:
     // Add matcher if it can compile the pattern.
     void AddMatcher( const wxString& aPattern, std::unique_ptr<EDA_PATTERN_MATCH> aMatcher );
 
     std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_matchers;
     wxString m_pattern;
+    bool     m_literal;
 };
 
 #endif  // EDA_PATTERN_MATCH_H
@@ -26,6 +26,7 @@
 #define EDA_TEXT_H_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <outline_mode.h>
@@ -423,11 +424,13 @@ private:
     mutable EDA_ANGLE                                   m_render_cache_angle;
     mutable VECTOR2I                                    m_render_cache_offset;
     mutable std::vector<std::unique_ptr<KIFONT::GLYPH>> m_render_cache;
+    mutable std::mutex                                  m_render_cache_mutex;
 
-    mutable bool     m_bounding_box_cache_valid;
-    mutable VECTOR2I m_bounding_box_cache_pos;
-    mutable int      m_bounding_box_cache_line;
-    mutable BOX2I    m_bounding_box_cache;
+    mutable bool       m_bounding_box_cache_valid;
+    mutable VECTOR2I   m_bounding_box_cache_pos;
+    mutable int        m_bounding_box_cache_line;
+    mutable BOX2I      m_bounding_box_cache;
+    mutable std::mutex m_bounding_box_cache_mutex;
 
     TEXT_ATTRIBUTES  m_attributes;
     VECTOR2I         m_pos;
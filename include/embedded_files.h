@@ -46,7 +46,8 @@ public:
 
         EMBEDDED_FILE() :
                 type( FILE_TYPE::OTHER ),
-                is_valid( false )
+                is_valid( false ),
+                is_compressed_only( false )
         {}
 
         bool Validate()
@@ -58,6 +59,14 @@ public:
             return is_valid;
         }
 
+        /**
+         * Decode #compressedEncodedData into #decompressedData if this was deferred when the
+         * file was loaded, checking the result against #data_sha.
+         *
+         * @return true if #decompressedData holds the file contents.
+         */
+        bool EnsureDecompressed();
+
         wxString GetLink() const
         {
             return wxString::Format( "%s://%s", FILEEXT::KiCadUriPrefix, name );
@@ -66,6 +75,7 @@ public:
         wxString          name;
         FILE_TYPE         type;
         bool              is_valid;
+        bool              is_compressed_only;    // decompressedData not decoded yet
         std::string       compressedEncodedData;
         std::vector<char> decompressedData;
         std::string       data_sha;
@@ -170,7 +180,8 @@ public:
      * Takes data from the #compressedEncodedData buffer and Base64 decodes it.
      * The data is then decompressed using ZSTD and stored in the #decompressedData buffer.
      *
-     * This call is used when loading the embedded files using the parsers.
+     * The parsers defer this call to the first use of the data, see
+     * EMBEDDED_FILE::EnsureDecompressed().
     */
     static RETURN_CODE  DecompressAndDecode( EMBEDDED_FILE& aFile );
 
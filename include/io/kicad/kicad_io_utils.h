@@ -20,6 +20,10 @@
 #ifndef KICAD_IO_UTILS_H
 #define KICAD_IO_UTILS_H
 
+#include <string>
+#include <string_view>
+
+#include <kicommon.h>
 #include <wx/string.h>
 
 class OUTPUTFORMATTER;
@@ -43,6 +47,49 @@ KICOMMON_API void FormatUuid( OUTPUTFORMATTER* aOut, const KIID& aUuid, char aSu
 
 KICOMMON_API void Prettify( std::string& aSource, char aQuoteChar = '"' );
 
+/**
+ * Applies the Prettify() formatting rules incrementally, as s-expression text is produced, so
+ * the unformatted text never has to be held in memory as a whole.
+ */
+class KICOMMON_API PRETTIFIER
+{
+public:
+    PRETTIFIER( char aQuoteChar = '"' );
+
+    /**
+     * Format @a aCount bytes of @a aSource, appending the result to @a aOut.
+     *
+     * The rules need a few bytes of lookahead, so the tail of @a aSource may be held back
+     * until the next call.
+     */
+    void Feed( const char* aSource, size_t aCount, std::string& aOut );
+
+    /**
+     * Format anything held back and end the output with a newline.
+     */
+    void Finish( std::string& aOut );
+
+private:
+    /**
+     * Format as much of @a aInput as the available lookahead allows.
+     *
+     * @return the number of bytes of @a aInput consumed.
+     */
+    size_t process( std::string_view aInput, bool aAtEnd, std::string& aOut );
+
+    char        m_quoteChar;
+    std::string m_pending;            ///< input not yet formatted, for lack of lookahead
+
+    int         m_listDepth;
+    char        m_lastNonWhitespace;
+    bool        m_inQuote;
+    bool        m_hasInsertedSpace;
+    bool        m_inMultiLineList;
+    bool        m_inXY;
+    int         m_column;
+    int         m_backslashCount;     ///< count of successive backslashes read
+};
+
 } // namespace KICAD_FORMAT
 
 #endif //KICAD_IO_UTILS_H
@@ -26,6 +26,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <wx/string.h>
 #include <eda_pattern_match.h>
 #include <lib_tree_item.h>
@@ -218,6 +219,11 @@ public:
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
 
+    /// Score of m_SearchTerms for m_ScoredMatcher, computed ahead of UpdateScore() by
+    /// LIB_TREE_NODE_ROOT.  Used and reset by the next UpdateScore() with that matcher.
+    const EDA_COMBINED_MATCHER* m_ScoredMatcher;
+    int                         m_MatcherScore;
+
 protected:
     /**
      * Add a new unit to the component and return it.
@@ -259,6 +265,29 @@ public:
 
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
+
+    /**
+     * Collect the items which can match the literal pattern of aMatcher, i.e. the items having
+     * all the trigrams of the pattern in their search terms.  The other items are given a
+     * null score for aMatcher.
+     *
+     * @param aMatcher is a literal matcher (see EDA_COMBINED_MATCHER::IsLiteral()).
+     * @param aCandidates receives the candidate items.
+     */
+    void GetSearchCandidates( const EDA_COMBINED_MATCHER& aMatcher,
+                              std::vector<LIB_TREE_NODE_ITEM*>& aCandidates );
+
+    /**
+     * Force a rebuild of the search index at the next search, after a change of the items.
+     */
+    void InvalidateSearchIndex() { m_searchIndexValid = false; }
+
+private:
+    void buildSearchIndex();
+
+    /// Trigrams of the item search terms -> items having this trigram, sorted by address
+    std::unordered_map<uint64_t, std::vector<LIB_TREE_NODE_ITEM*>> m_searchIndex;
+    bool                                                          m_searchIndexValid;
 };
 
 
@@ -285,6 +314,10 @@ public:
      */
     LIB_TREE_NODE_LIBRARY& AddLib( wxString const& aName, wxString const& aDesc );
 
+    /**
+     * When aMatcher is literal, narrow the items to the candidates found in the library search
+     * indexes and score them on the thread pool before updating the tree scores.
+     */
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
 };
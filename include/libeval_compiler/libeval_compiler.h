@@ -24,8 +24,11 @@
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <new>
 #include <string>
 #include <stack>
+#include <type_traits>
+#include <vector>
 
 #include <kicommon.h>
 #include <base_units.h>
@@ -297,6 +300,11 @@ public:
     virtual ~VAR_REF() {};
 
     virtual VAR_TYPE_T GetType() const = 0;
+
+    /**
+     * @return the value of the variable, created with CONTEXT::AllocValue() so that it is owned
+     *         by \a aCtx.
+     */
     virtual VALUE* GetValue( CONTEXT* aCtx ) = 0;
 };
 
@@ -306,29 +314,53 @@ class KICOMMON_API CONTEXT
 public:
     CONTEXT() :
         m_stack(),
-        m_stackPtr( 0 )
+        m_stackPtr( 0 ),
+        m_pooledValues( 0 ),
+        m_poolUsed( 0 )
     {
         m_ownedValues.reserve( 20 );
     }
 
+    CONTEXT( const CONTEXT& ) = delete;
+    CONTEXT& operator=( const CONTEXT& ) = delete;
+
     virtual ~CONTEXT()
     {
+        for( int ii = 0; ii < m_pooledValues; ++ii )
+            m_pooled[ii]->~VALUE();
+
         for( VALUE* v : m_ownedValues )
         {
             delete v;
         }
     }
 
-    VALUE* AllocValue()
+    /**
+     * Allocate a temporary value owned by the context: a plain #VALUE for operator results, or
+     * a type derived from it for the values of variable references.  Values come from an inline
+     * pool until it runs out, and from the heap after that.
+     */
+    template <typename T = VALUE, typename... ARGS>
+    T* AllocValue( ARGS&&... aArgs )
     {
-        m_ownedValues.emplace_back( new VALUE );
-        return m_ownedValues.back();
-    }
+        static_assert( std::is_base_of_v<VALUE, T> && alignof( T ) <= alignof( VALUE ) );
 
-    VALUE* StoreValue( VALUE* aValue )
-    {
-        m_ownedValues.emplace_back( aValue );
-        return m_ownedValues.back();
+        // Keep the next value aligned
+        constexpr size_t size = ( sizeof( T ) + alignof( VALUE ) - 1 ) & ~( alignof( VALUE ) - 1 );
+
+        if( m_pooledValues < VALUE_POOL_SIZE && m_poolUsed + size <= sizeof( m_valuePool ) )
+        {
+            T* value = new( &m_valuePool[ m_poolUsed ] ) T( std::forward<ARGS>( aArgs )... );
+
+            m_poolUsed += size;
+            m_pooled[ m_pooledValues++ ] = value;
+            return value;
+        }
+
+        T* value = new T( std::forward<ARGS>( aArgs )... );
+
+        m_ownedValues.emplace_back( value );
+        return value;
     }
 
     void Push( VALUE* v )
@@ -362,10 +394,17 @@ public:
     void ReportError( const wxString& aErrorMsg );
 
 private:
+    static constexpr int VALUE_POOL_SIZE = 16;
+
     std::vector<VALUE*> m_ownedValues;
     VALUE*              m_stack[100];       // std::stack not performant enough
     int                 m_stackPtr;
 
+    alignas( VALUE ) unsigned char m_valuePool[ VALUE_POOL_SIZE * sizeof( VALUE ) ];
+    VALUE*                         m_pooled[ VALUE_POOL_SIZE ];
+    int                            m_pooledValues;
+    size_t                         m_poolUsed;
+
     std::function<void( const wxString& aMessage, int aOffset )> m_errorCallback;
 };
 
@@ -383,6 +422,18 @@ public:
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
 
+    /**
+     * Fold operators whose operands are all numeric constants (such as unit arithmetic in
+     * "1.5mm + 0.1mm") into a single constant push.  Must be called after compilation and
+     * before the first Run().
+     *
+     * @param aErrorCallback receives the errors raised while evaluating a constant operator
+     *                       (usually the compiler's error callback).  Operators which raise an
+     *                       error are left as they are.
+     */
+    void Optimize( const std::function<void( const wxString& aMessage,
+                                             int aOffset )>& aErrorCallback = nullptr );
+
     virtual std::unique_ptr<VAR_REF> CreateVarRef( const wxString& var, const wxString& field )
     {
         return nullptr;
@@ -429,6 +480,9 @@ public:
 
     wxString Format() const;
 
+    int GetOp() const { return m_op; }
+    const VALUE* GetValue() const { return m_value.get(); }
+
 private:
     int                      m_op;
 
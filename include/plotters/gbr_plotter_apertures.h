@@ -26,6 +26,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <hash.h>
+
 
 /* Class to handle a D_CODE when plotting a board using Standard Aperture Templates
  * (complex apertures need aperture macros to be flashed)
@@ -142,6 +147,100 @@ public:
 };
 
 
+/**
+ * A hash index to find a polygon similar to a candidate without comparing it to every
+ * known polygon.
+ *
+ * Polygons are similar when they have the same vertex count and each vertex coordinate
+ * differs by no more than MARGIN.  Entries are bucketed on a caller supplied key, the vertex
+ * count and the grid cell of the first vertex; a lookup probes every cell reachable within
+ * MARGIN, so it finds the same entries a linear scan would.
+ */
+class GBR_POLY_INDEX
+{
+public:
+    static constexpr int MARGIN = 2;        ///< Max coordinate difference of similar polygons
+    static constexpr int CELL_SIZE = 8;     ///< Grid size, must be larger than 2 * MARGIN
+
+    void Clear() { m_buckets.clear(); }
+
+    /**
+     * Add the entry aIdx, of polygon aPolygon, to the index.
+     */
+    void Add( size_t aKey, const std::vector<VECTOR2I>& aPolygon, int aIdx )
+    {
+        if( aPolygon.empty() )
+        {
+            m_buckets[ hash_val( aKey, 0 ) ].push_back( aIdx );
+            return;
+        }
+
+        m_buckets[ bucketKey( aKey, aPolygon.size(), cell( aPolygon[0].x ),
+                              cell( aPolygon[0].y ) ) ].push_back( aIdx );
+    }
+
+    /**
+     * @return the smallest index added with aKey for which aMatch( index ) returns true
+     * and whose first vertex is close enough to the first vertex of aPolygon, or -1.
+     * aMatch must perform the full comparison: the index only narrows the candidates.
+     */
+    template <typename MATCH>
+    int Find( size_t aKey, const std::vector<VECTOR2I>& aPolygon, MATCH aMatch ) const
+    {
+        int found = -1;
+
+        auto probe =
+                [&]( size_t aBucketKey )
+                {
+                    auto it = m_buckets.find( aBucketKey );
+
+                    if( it == m_buckets.end() )
+                        return;
+
+                    for( int idx : it->second )
+                    {
+                        if( ( found < 0 || idx < found ) && aMatch( idx ) )
+                            found = idx;
+                    }
+                };
+
+        if( aPolygon.empty() )
+        {
+            probe( hash_val( aKey, 0 ) );
+            return found;
+        }
+
+        const VECTOR2I& first = aPolygon[0];
+
+        const int64_t   x = first.x;
+        const int64_t   y = first.y;
+
+        for( int cx = cell( x - MARGIN ); cx <= cell( x + MARGIN ); ++cx )
+        {
+            for( int cy = cell( y - MARGIN ); cy <= cell( y + MARGIN ); ++cy )
+                probe( bucketKey( aKey, aPolygon.size(), cx, cy ) );
+        }
+
+        return found;
+    }
+
+private:
+    static int cell( int64_t aCoord )
+    {
+        // Floor division, also for negative coordinates
+        return static_cast<int>( ( aCoord < 0 ? aCoord - ( CELL_SIZE - 1 ) : aCoord )
+                                 / CELL_SIZE );
+    }
+
+    static size_t bucketKey( size_t aKey, size_t aCount, int aCellX, int aCellY )
+    {
+        return hash_val( aKey, aCount, aCellX, aCellY );
+    }
+
+    std::unordered_map<size_t, std::vector<int>> m_buckets;
+};
+
+
 /** A class to define an aperture macros based on a free polygon, i.e. using a
  * primitive 4 to describe a free polygon with a rotation.
  * the aperture macro has only one parameter: rotation and is defined on the fly
@@ -183,7 +282,11 @@ class APER_MACRO_FREEPOLY_LIST
 public:
     APER_MACRO_FREEPOLY_LIST() {}
 
-    void ClearList() { m_AMList.clear(); }
+    void ClearList()
+    {
+        m_AMList.clear();
+        m_index.Clear();
+    }
 
     int AmCount() const { return (int)m_AMList.size(); }
 
@@ -208,4 +311,7 @@ public:
     void Format( FILE * aOutput, double aIu2GbrMacroUnit );
 
     std::vector<APER_MACRO_FREEPOLY> m_AMList;
+
+private:
+    GBR_POLY_INDEX m_index;     ///< Index of m_AMList polygons, to speed up FindAm()
 };
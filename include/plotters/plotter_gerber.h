@@ -30,6 +30,7 @@ class GERBER_PLOTTER : public PLOTTER
 {
 public:
     GERBER_PLOTTER();
+    ~GERBER_PLOTTER();
 
     virtual PLOT_FORMAT GetPlotterType() const override
     {
@@ -331,6 +332,18 @@ protected:
      */
     void emitDcode( const VECTOR2D& pt, int dcode );
 
+    /**
+     * Write a "D<n>*" aperture selection record.
+     */
+    void emitApertureSelection( int aDCode );
+
+    /**
+     * Append aAperture to m_apertures with the next free D-Code, and index it.
+     *
+     * @return the index of the new aperture in m_apertures.
+     */
+    int addAperture( APERTURE& aAperture );
+
     /**
      * Print a Gerber net attribute object record.
      *
@@ -371,6 +384,16 @@ protected:
     void writeApertureList();
 
     std::vector<APERTURE> m_apertures;  // The list of available apertures
+
+    // Indexes of m_apertures, by size/radius and by corner list, to avoid a linear search
+    // of the aperture list each time an aperture is selected
+    std::unordered_map<size_t, std::vector<int>> m_apertureSizeIndex;
+    GBR_POLY_INDEX                               m_apertureCornerIndex;
+
+    // stdio buffers of workFile and finalFile: Gerber files are written as many short records
+    std::vector<char> m_workFileBuffer;
+    std::vector<char> m_finalFileBuffer;
+
     int     m_currentApertureIdx;       // The index of the current aperture in m_apertures
     bool    m_hasApertureRoundRect;     // true is at least one round rect aperture is in use
     bool    m_hasApertureRotOval;       // true is at least one oval rotated aperture is in use
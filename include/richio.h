@@ -29,6 +29,7 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -40,6 +41,7 @@
 
 #include <ki_exception.h>
 #include <kicommon.h>
+#include <io/kicad/kicad_io_utils.h>
 
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
@@ -112,6 +114,18 @@ public:
      */
     virtual char* ReadLine() = 0;
 
+    /**
+     * Read a line of text and increment the line number counter, like ReadLine(), but without
+     * requiring the line to be copied into a nul terminated buffer.
+     *
+     * Readers which hold their whole input in memory may return a view of it directly.  The
+     * view is valid until the next read, and Line() may not reflect it.
+     *
+     * @return the line including its end of line character(s), or an empty view if EOF.
+     * @throw IO_ERROR when a line is too long.
+     */
+    virtual std::string_view ReadLineView();
+
     /**
      * Returns the name of the source of the lines in an abstract sense.
      *
@@ -246,6 +260,58 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that reads from a file mapped into memory.
+ *
+ * ReadLineView() returns lines straight from the mapping, so DSNLEXER can tokenize a file
+ * without copying it.  ReadLine() still provides nul terminated copies for other users.
+ *
+ * @warning The mapping is read unprotected: if the file is truncated by another process while
+ *          it is mapped, reading past its new end raises SIGBUS (or an access violation) rather
+ *          than an IO_ERROR.  Use a #FILE_LINE_READER for files which may change under the
+ *          reader, such as those on network shares.
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * Map @a aFileName read-only.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened or mapped.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    std::string_view ReadLineView() override;
+
+    /**
+     * Rewind to the start of the file and reset the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * Return the number of lines in the file, without disturbing the read position.
+     */
+    unsigned CountLines() const;
+
+    long int FileLength() const { return (long int) m_size; }
+    long int CurPos() const { return (long int) m_pos; }
+
+protected:
+    const char* m_data;    ///< start of the mapped file
+    size_t      m_size;    ///< length of the mapped file
+    size_t      m_pos;     ///< offset of the next line to read
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -276,6 +342,15 @@ public:
      */
     STRING_LINE_READER( const STRING_LINE_READER& aStartingPoint );
 
+    /**
+     * Construct a string line reader over a fragment of a larger source.
+     *
+     * @param aString is the fragment, which is taken over rather than copied.
+     * @param aSource describes the larger source for error reporting purposes.
+     * @param aFirstLine is the line number of the fragment's first line within that source.
+     */
+    STRING_LINE_READER( std::string&& aString, const wxString& aSource, unsigned aFirstLine );
+
     char* ReadLine() override;
 };
 
@@ -302,6 +377,7 @@ protected:
 
 
 #define OUTPUTFMTBUFZ    500        ///< default buffer size for any OUTPUT_FORMATTER
+#define PRETTIFIED_FILE_CHUNK   65536   ///< bytes buffered by PRETTIFIED_FILE_OUTPUTFORMATTER
 
 /**
  * An interface used to output 8 bit text in a convenient way.
@@ -496,6 +572,10 @@ protected:
 };
 
 
+/**
+ * An #OUTPUTFORMATTER which prettifies its output as it is produced and writes it to a file
+ * in chunks of #PRETTIFIED_FILE_CHUNK bytes.
+ */
 class KICOMMON_API PRETTIFIED_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
 {
 public:
@@ -505,7 +585,7 @@ public:
     ~PRETTIFIED_FILE_OUTPUTFORMATTER();
 
     /**
-     * Performs prettification and writes the stored buffer to the file.
+     * Prettifies and writes whatever is still buffered, then closes the file.
      * @return true if the write succeeded.
      */
     bool Finish() override;
@@ -514,8 +594,12 @@ protected:
     void write( const char* aOutBuf, int aCount ) override;
 
 private:
-    FILE* m_fp;
-    std::string m_buf;
+    /// Write the prettified text buffered so far.
+    void flush();
+
+    FILE*                    m_fp;
+    std::string              m_buf;          ///< prettified text not yet written
+    KICAD_FORMAT::PRETTIFIER m_prettifier;
 };
 
 
@@ -104,6 +104,18 @@ public:
      */
     virtual void Remove( VIEW_ITEM* aItem );
 
+    /**
+     * Defer spatial indexing of added items until EndBulkLoad().
+     *
+     * Use this around loops adding many items at once (e.g. when loading a document): the
+     * layer R-trees are then packed in a single pass instead of being grown item by item.
+     */
+    void BeginBulkLoad();
+
+    /**
+     * Index the items added since BeginBulkLoad().
+     */
+    void EndBulkLoad();
 
     /**
      * Find all visible items that touch or are within the rectangle \a aRect.
@@ -31,6 +31,9 @@
 
 #include <geometry/rtree.h>
 
+#include <utility>
+#include <vector>
+
 namespace KIGFX
 {
 typedef RTree<VIEW_ITEM*, int, 2, double> VIEW_RTREE_BASE;
@@ -51,9 +54,41 @@ public:
         const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
         const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
 
+        if( m_bulkLoading )
+        {
+            m_pending.push_back( { { { mmin[0], mmin[1] }, { mmax[0], mmax[1] } }, aItem } );
+            return;
+        }
+
         VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Start collecting inserted items instead of adding them to the tree one at a time.
+     */
+    void BeginBulkLoad()
+    {
+        m_bulkLoading = true;
+    }
+
+    /**
+     * Pack the items collected since BeginBulkLoad() into the tree in a single pass.
+     */
+    void EndBulkLoad()
+    {
+        m_bulkLoading = false;
+        flushPending();
+    }
+
+    /**
+     * Remove all items from the tree, including any not yet bulk-loaded.
+     */
+    void RemoveAll()
+    {
+        m_pending.clear();
+        VIEW_RTREE_BASE::RemoveAll();
+    }
+
     /**
      * Remove an item from the tree.
      *
@@ -63,6 +98,8 @@ public:
     {
         // const BOX2I&    bbox    = aItem->ViewBBox();
 
+        flushPending();
+
         if( aBbox )
         {
             const int mmin[2] = { aBbox->GetX(), aBbox->GetY() };
@@ -101,10 +138,53 @@ public:
             mmax[0] = mmax[1] = INT_MAX;
         }
 
-        VIEW_RTREE_BASE::Search( mmin, mmax, aVisitor );
+        if( m_pending.empty() )
+        {
+            VIEW_RTREE_BASE::Search( mmin, mmax, aVisitor );
+            return;
+        }
+
+        // Items collected during a bulk load aren't in the tree yet; visit them separately
+        bool aborted = false;
+
+        auto visit =
+                [&]( VIEW_ITEM* aItem ) -> bool
+                {
+                    if( aVisitor( aItem ) )
+                        return true;
+
+                    aborted = true;
+                    return false;
+                };
+
+        VIEW_RTREE_BASE::Search( mmin, mmax, visit );
+
+        for( const std::pair<Rect, VIEW_ITEM*>& entry : m_pending )
+        {
+            if( aborted )
+                break;
+
+            if( entry.first.m_min[0] <= mmax[0] && entry.first.m_max[0] >= mmin[0]
+                    && entry.first.m_min[1] <= mmax[1] && entry.first.m_max[1] >= mmin[1] )
+            {
+                aborted = !aVisitor( entry.second );
+            }
+        }
     }
 
 private:
+    void flushPending()
+    {
+        if( m_pending.empty() )
+            return;
+
+        BulkLoad( m_pending );
+        m_pending.clear();
+        m_pending.shrink_to_fit();
+    }
+
+    bool                                     m_bulkLoading = false;
+    std::vector<std::pair<Rect, VIEW_ITEM*>> m_pending;
 };
 } // namespace KIGFX
 
@@ -20,6 +20,7 @@
 
 #include "command.h"
 #include <cli/exit_codes.h>
+#include <jobs/job.h>
 #include <wx/crt.h>
 #include <macros.h>
 #include <string_utils.h>
@@ -34,8 +35,8 @@ CLI::COMMAND::COMMAND( const std::string& aName ) :
         m_hasOutputArg( false ),
         m_hasDrawingSheetArg( false ),
         m_hasDefineArg( false ),
-        m_outputArgExpectsDir( false )
-
+        m_outputArgExpectsDir( false ),
+        m_jobCollector( nullptr )
 {
     m_argParser.add_argument( ARG_HELP_SHORT, ARG_HELP )
                 .default_value( false )
@@ -103,6 +104,18 @@ int CLI::COMMAND::Perform( KIWAY& aKiway )
 }
 
 
+int CLI::COMMAND::processJob( KIWAY& aKiway, KIWAY::FACE_T aFace, std::unique_ptr<JOB> aJob )
+{
+    if( m_jobCollector )
+    {
+        m_jobCollector->push_back( std::move( aJob ) );
+        return EXIT_CODES::OK;
+    }
+
+    return aKiway.ProcessJob( aFace, aJob.get() );
+}
+
+
 int CLI::COMMAND::doPerform( KIWAY& aKiway )
 {
     // default case if we aren't overloaded, just print the help
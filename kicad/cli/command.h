@@ -23,6 +23,10 @@
 
 #include <argparse/argparse.hpp>
 #include <kiway.h>
+#include <memory>
+#include <vector>
+
+class JOB;
 
 #define UTF8STDSTR( s ) ( std::string( s.utf8_str() ) )
 
@@ -61,6 +65,16 @@ public:
 
     void PrintHelp();
 
+    /**
+     * Collect the job the command builds instead of running it, so a batch can run it later.
+     *
+     * @param aCollector receives the job; nullptr runs jobs immediately again.
+     */
+    void SetJobCollector( std::vector<std::unique_ptr<JOB>>* aCollector )
+    {
+        m_jobCollector = aCollector;
+    }
+
 protected:
     /**
      * Set up the most common of args used across cli
@@ -84,6 +98,11 @@ protected:
      */
     void addDefineArg();
 
+    /**
+     * Run a job on a kiface, or hand it over to the job collector if one is set.
+     */
+    int processJob( KIWAY& aKiway, KIWAY::FACE_T aFace, std::unique_ptr<JOB> aJob );
+
     /**
      * The internal handler that should be overloaded to implement command specific
      * processing and work.
@@ -143,6 +162,11 @@ protected:
      * Value of the drawing sheet arg if configured
      */
     std::map<wxString, wxString>    m_argDefineVars;
+
+    /**
+     * Receives the built jobs instead of running them, if set
+     */
+    std::vector<std::unique_ptr<JOB>>* m_jobCollector;
 };
 
 }
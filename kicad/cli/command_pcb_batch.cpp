@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_batch.h"
+#include "command_pcb_drc.h"
+#include "command_pcb_render.h"
+#include "command_pcb_export_3d.h"
+#include "command_pcb_export_drill.h"
+#include "command_pcb_export_dxf.h"
+#include "command_pcb_export_gerber.h"
+#include "command_pcb_export_gerbers.h"
+#include "command_pcb_export_ipc2581.h"
+#include "command_pcb_export_pdf.h"
+#include "command_pcb_export_pos.h"
+#include "command_pcb_export_svg.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_batch.h"
+#include <locale_io.h>
+#include <macros.h>
+#include <string_utils.h>
+#include <wx/cmdline.h>
+#include <wx/crt.h>
+#include <wx/textfile.h>
+
+#include <functional>
+
+#define ARG_JOBS "--jobs"
+#define ARG_SEQUENTIAL "--sequential"
+
+
+CLI::PCB_BATCH_COMMAND::PCB_BATCH_COMMAND() : COMMAND( "batch" )
+{
+    addCommonArgs( true, false, false, false );
+    addDefineArg();
+
+    m_argParser.add_description( UTF8STDSTR( _( "Runs several pcb commands on a board, loading "
+                                                "it only once" ) ) );
+
+    m_argParser.add_argument( ARG_JOBS )
+            .required()
+            .help( UTF8STDSTR( _( "File listing one pcb command per line, without the input "
+                                  "file, e.g. 'export gerbers --output gerbers/'" ) ) )
+            .metavar( "JOBS_FILE" );
+
+    m_argParser.add_argument( ARG_SEQUENTIAL )
+            .help( UTF8STDSTR( _( "Run the commands one after the other instead of running "
+                                  "independent exports concurrently" ) ) )
+            .flag();
+}
+
+
+int CLI::PCB_BATCH_COMMAND::doPerform( KIWAY& aKiway )
+{
+    // Each line gets a fresh command: argparse can't parse the same parser twice
+    static const std::map<wxString, std::function<COMMAND*()>> commandFactories = {
+        { wxS( "drc" ),            [] { return new PCB_DRC_COMMAND(); } },
+        { wxS( "render" ),         [] { return new PCB_RENDER_COMMAND(); } },
+        { wxS( "export drill" ),   [] { return new PCB_EXPORT_DRILL_COMMAND(); } },
+        { wxS( "export dxf" ),     [] { return new PCB_EXPORT_DXF_COMMAND(); } },
+        { wxS( "export gerber" ),  [] { return new PCB_EXPORT_GERBER_COMMAND(); } },
+        { wxS( "export gerbers" ), [] { return new PCB_EXPORT_GERBERS_COMMAND(); } },
+        { wxS( "export ipc2581" ), [] { return new PCB_EXPORT_IPC2581_COMMAND(); } },
+        { wxS( "export pdf" ),     [] { return new PCB_EXPORT_PDF_COMMAND(); } },
+        { wxS( "export pos" ),     [] { return new PCB_EXPORT_POS_COMMAND(); } },
+        { wxS( "export svg" ),     [] { return new PCB_EXPORT_SVG_COMMAND(); } },
+        { wxS( "export step" ),
+          [] { return new PCB_EXPORT_3D_COMMAND( "step", "", JOB_EXPORT_PCB_3D::FORMAT::STEP ); } },
+        { wxS( "export glb" ),
+          [] { return new PCB_EXPORT_3D_COMMAND( "glb", "", JOB_EXPORT_PCB_3D::FORMAT::GLB ); } },
+        { wxS( "export vrml" ),
+          [] { return new PCB_EXPORT_3D_COMMAND( "vrml", "", JOB_EXPORT_PCB_3D::FORMAT::VRML ); } }
+    };
+
+    wxString   jobsFile = From_UTF8( m_argParser.get<std::string>( ARG_JOBS ).c_str() );
+    wxTextFile file;
+
+    if( !wxFileExists( jobsFile ) || !file.Open( jobsFile ) )
+    {
+        wxFprintf( stderr, _( "Unable to open jobs file '%s'\n" ), jobsFile );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    std::vector<std::unique_ptr<JOB>> jobs;
+
+    for( size_t lineIdx = 0; lineIdx < file.GetLineCount(); ++lineIdx )
+    {
+        wxString line = file.GetLine( lineIdx );
+        line.Trim( true ).Trim( false );
+
+        if( line.IsEmpty() || line.StartsWith( wxS( "#" ) ) )
+            continue;
+
+        wxArrayString args = wxCmdLineParser::ConvertStringToArgs( line );
+        wxString      name = args[0];
+        size_t        firstArg = 1;
+
+        if( name == wxS( "export" ) && args.size() > 1 )
+        {
+            name += wxS( " " ) + args[1];
+            firstArg = 2;
+        }
+
+        auto factory = commandFactories.find( name );
+
+        if( factory == commandFactories.end() )
+        {
+            wxFprintf( stderr, _( "%s line %d: unknown command '%s'\n" ), jobsFile,
+                       (int) lineIdx + 1, name );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        std::unique_ptr<COMMAND> command( factory->second() );
+        std::vector<std::string> argv = { command->GetName() };
+
+        for( size_t ii = firstArg; ii < args.size(); ++ii )
+            argv.push_back( TO_UTF8( args[ii] ) );
+
+        argv.push_back( TO_UTF8( m_argInput ) );
+
+        try
+        {
+            command->GetArgParser().parse_args( argv );
+        }
+        catch( const std::runtime_error& err )
+        {
+            wxFprintf( stderr, _( "%s line %d: %s\n" ), jobsFile, (int) lineIdx + 1,
+                       From_UTF8( err.what() ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        command->SetJobCollector( &jobs );
+
+        int exitCode = command->Perform( aKiway );
+
+        if( exitCode != EXIT_CODES::OK )
+            return exitCode;
+    }
+
+    JOB_PCB_BATCH batchJob( true );
+
+    batchJob.m_filename = m_argInput;
+    batchJob.m_concurrent = !m_argParser.get<bool>( ARG_SEQUENTIAL );
+    batchJob.SetVarOverrides( m_argDefineVars );
+
+    for( const std::unique_ptr<JOB>& job : jobs )
+        batchJob.m_jobs.push_back( job.get() );
+
+    LOCALE_IO dummy;
+    return aKiway.ProcessJob( KIWAY::FACE_PCB, &batchJob );
+}
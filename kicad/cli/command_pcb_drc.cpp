@@ -164,7 +164,7 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
 
     drcJob->m_parity = m_argParser.get<bool>( ARG_PARITY );
 
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, drcJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( drcJob ) );
 
     return exitCode;
 }
@@ -361,7 +361,7 @@ int CLI::PCB_EXPORT_3D_COMMAND::doPerform( KIWAY& aKiway )
         }
     }
 
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, step.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( step ) );
 
     return exitCode;
 }
@@ -248,7 +248,7 @@ int CLI::PCB_EXPORT_DRILL_COMMAND::doPerform( KIWAY& aKiway )
         return EXIT_CODES::ERR_ARGS;
     }
 
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, drillJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( drillJob ) );
 
     return exitCode;
 }
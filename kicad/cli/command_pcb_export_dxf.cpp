@@ -114,7 +114,7 @@ int CLI::PCB_EXPORT_DXF_COMMAND::doPerform( KIWAY& aKiway )
     dxfJob->m_printMaskLayer = m_selectedLayers;
 
     LOCALE_IO dummy;    // Switch to "C" locale
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, dxfJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( dxfJob ) );
 
     return exitCode;
 }
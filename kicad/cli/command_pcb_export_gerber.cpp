@@ -140,7 +140,7 @@ int CLI::PCB_EXPORT_GERBER_COMMAND::doPerform( KIWAY& aKiway )
         return exitCode;
 
     LOCALE_IO dummy;
-    exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, gerberJob.get() );
+    exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( gerberJob ) );
 
     return exitCode;
 }
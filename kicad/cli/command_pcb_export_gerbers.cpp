@@ -33,6 +33,7 @@
 
 #define ARG_COMMON_LAYERS "--common-layers"
 #define ARG_USE_BOARD_PLOT_PARAMS "--board-plot-params"
+#define ARG_SEQUENTIAL "--sequential"
 
 
 CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
@@ -55,6 +56,11 @@ CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
             .help( UTF8STDSTR( _( "Use the Gerber plot settings already configured in the "
                                   "board file" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_SEQUENTIAL )
+            .help( UTF8STDSTR( _( "Plot the layers one after the other instead of "
+                                  "concurrently" ) ) )
+            .flag();
 }
 
 
@@ -76,9 +82,10 @@ int CLI::PCB_EXPORT_GERBERS_COMMAND::doPerform( KIWAY& aKiway )
     gerberJob->m_layersIncludeOnAll =
             convertLayerStringList( layers, gerberJob->m_layersIncludeOnAllSet );
     gerberJob->m_useBoardPlotParams = m_argParser.get<bool>( ARG_USE_BOARD_PLOT_PARAMS );
+    gerberJob->m_parallelPlot = !m_argParser.get<bool>( ARG_SEQUENTIAL );
 
     LOCALE_IO dummy;
-    exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, gerberJob.get() );
+    exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( gerberJob ) );
 
     return exitCode;
 }
@@ -146,7 +146,7 @@ int CLI::PCB_EXPORT_IPC2581_COMMAND::doPerform( KIWAY& aKiway )
             From_UTF8( m_argParser.get<std::string>( ARG_BOM_COL_DIST ).c_str() );
 
     LOCALE_IO dummy;
-    exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, ipc2581Job.get() );
+    exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( ipc2581Job ) );
 
     return exitCode;
 }
@@ -113,7 +113,7 @@ int CLI::PCB_EXPORT_PDF_COMMAND::doPerform( KIWAY& aKiway )
     pdfJob->m_printMaskLayer = m_selectedLayers;
 
     LOCALE_IO dummy;    // Switch to "C" locale
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, pdfJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( pdfJob ) );
 
     return exitCode;
 }
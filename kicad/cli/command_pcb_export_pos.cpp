@@ -177,7 +177,7 @@ int CLI::PCB_EXPORT_POS_COMMAND::doPerform( KIWAY& aKiway )
 
 
     LOCALE_IO dummy;
-    int       exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, aPosJob.get() );
+    int       exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( aPosJob ) );
 
     return exitCode;
 }
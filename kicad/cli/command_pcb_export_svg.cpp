@@ -112,7 +112,7 @@ int CLI::PCB_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
 
     svgJob->m_printMaskLayer = m_selectedLayers;
 
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, svgJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( svgJob ) );
 
     return exitCode;
 }
@@ -296,7 +296,7 @@ int CLI::PCB_RENDER_COMMAND::doPerform( KIWAY& aKiway )
         return EXIT_CODES::ERR_ARGS;
     }
 
-    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, renderJob.get() );
+    int exitCode = processJob( aKiway, KIWAY::FACE_PCB, std::move( renderJob ) );
 
     return exitCode;
 }
@@ -47,6 +47,7 @@
 #include <locale_io.h>
 
 #include "cli/command_pcb.h"
+#include "cli/command_pcb_batch.h"
 #include "cli/command_pcb_export.h"
 #include "cli/command_pcb_drc.h"
 #include "cli/command_pcb_render.h"
@@ -106,6 +107,7 @@ struct COMMAND_ENTRY
 };
 
 static CLI::PCB_COMMAND                  pcbCmd{};
+static CLI::PCB_BATCH_COMMAND            pcbBatchCmd{};
 static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
 static CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
 static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
@@ -162,6 +164,9 @@ static std::vector<COMMAND_ENTRY> commandStack = {
     {
         &pcbCmd,
         {
+            {
+                &pcbBatchCmd
+            },
             {
                 &pcbDrcCmd
             },
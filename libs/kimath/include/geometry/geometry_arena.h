@@ -0,0 +1,66 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <memory_resource>
+
+/**
+ * A scoped memory pool for the short-lived containers of the geometry code.
+ *
+ * While an arena is alive, the containers which support it (the vertices of a VERTEX_SET and
+ * its derived classes, such as POLYGON_TRIANGULATION) take their memory from it rather than
+ * from the heap.  The arena hands out memory from a few growing chunks and ignores frees, so
+ * allocating is cheap and never contends with other threads; the chunks go back to the heap at
+ * once when the arena is destroyed.  It is meant for the scratch memory of a bounded amount of
+ * work, not for long-running loops.
+ *
+ * Arenas are per thread: one is typically created at the top of a zone fill or DRC task, and
+ * arenas nest.  The containers keep the arena they were created with, so they must be destroyed
+ * before it; objects which outlive the task must not be created within its scope.
+ *
+ * SHAPE_LINE_CHAIN and SHAPE_POLY_SET don't use arenas: their std::vector storage is handed out
+ * by reference throughout the code, so scratch polygons such as a zone's knockouts still come
+ * from the heap.
+ */
+class GEOMETRY_ARENA
+{
+public:
+    GEOMETRY_ARENA();
+    ~GEOMETRY_ARENA();
+
+    GEOMETRY_ARENA( const GEOMETRY_ARENA& ) = delete;
+    GEOMETRY_ARENA& operator=( const GEOMETRY_ARENA& ) = delete;
+
+    /**
+     * @return the innermost arena of the calling thread, or the default heap resource if there
+     *         is none.
+     */
+    static std::pmr::memory_resource* Current();
+
+private:
+    std::pmr::monotonic_buffer_resource m_buffer;
+    std::pmr::memory_resource*          m_previous;
+};
+
+#endif // GEOMETRY_ARENA_H
@@ -49,6 +49,8 @@
 #include <algorithm>
 #include <deque>
 #include <cmath>
+#include <set>
+#include <vector>
 
 #include <advanced_config.h>
 #include <clipper.hpp>
@@ -463,7 +465,8 @@ private:
             }
         };
 
-        std::set<std::pair<VERTEX*,double>, VertexComparator> longest;
+        std::pmr::set<std::pair<VERTEX*,double>, VertexComparator> longest(
+                m_vertices.get_allocator().resource() );
         double avg = 0.0;
 
         do
@@ -526,7 +529,7 @@ private:
         // need to create a new segment to disconnect the two loops.
         do
         {
-            std::vector<VERTEX*> overlapPoints;
+            std::pmr::vector<VERTEX*> overlapPoints( m_vertices.get_allocator().resource() );
             VERTEX* z_pt = origPoly;
 
             while ( z_pt->prevZ && *z_pt->prevZ == *origPoly )
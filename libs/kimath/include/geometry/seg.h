@@ -398,6 +398,26 @@ inline SEG::ecoord SEG::TCoef( const VECTOR2I& aP ) const
     return d.Dot( aP - A);
 }
 
+// Inlined for performance reasons; this is the innermost test of the line chain and polygon
+// distance queries.
+inline SEG::ecoord SEG::SquaredDistance( const VECTOR2I& aP ) const
+{
+    VECTOR2L ab = VECTOR2L( B.x - A.x, B.y - A.y );
+    VECTOR2L ap = VECTOR2L( aP.x - A.x, aP.y - A.y );
+
+    ecoord e = ap.Dot( ab );
+
+    if( e <= 0 )
+        return ap.SquaredEuclideanNorm();
+
+    ecoord f = ab.SquaredEuclideanNorm();
+
+    if( e >= f )
+        return VECTOR2L( aP.x - B.x, aP.y - B.y ).SquaredEuclideanNorm();
+
+    return KiROUND<double, ecoord>( ap.SquaredEuclideanNorm() - ( double( e ) * e ) / f );
+}
+
 inline std::ostream& operator<<( std::ostream& aStream, const SEG& aSeg )
 {
     aStream << "[ " << aSeg.A << " - " << aSeg.B << " ]";
@@ -0,0 +1,62 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file seg_batch.h
+ * @brief Tests of one point against a run of segments, for the inner loops of the line chain
+ * and polygon queries.
+ *
+ * The segments are given as a sequence of \a aPointCount points, where segment i joins
+ * aPts[i] to aPts[i + 1], and the last segment (i = aPointCount - 1) closes the sequence back
+ * to aPts[0].  The results are exactly those of testing each segment with the SEG methods.
+ */
+
+#ifndef SEG_BATCH_H
+#define SEG_BATCH_H
+
+#include <geometry/seg.h>
+#include <math/vector2d.h>
+
+/**
+ * Count the segments \a aFirst to \a aLast - 1 crossed by the ray going from \a aP in the
+ * positive x direction, using the same rules as SHAPE_LINE_CHAIN_BASE::PointInside().
+ *
+ * The segments which don't span aP.y are filtered out with SIMD compares where the CPU
+ * supports them.
+ */
+int CountRayCrossings( const VECTOR2I& aP, const VECTOR2I* aPts, int aPointCount, int aFirst,
+                       int aLast );
+
+/**
+ * @return the smallest SEG::SquaredDistance() from \a aP to the segments \a aFirst to
+ *         \a aLast - 1, or VECTOR2I::ECOORD_MAX if there are none.
+ * @param aNearest if not null, receives the index of the first segment at that distance.
+ *
+ * Segments whose bounding box is further than the best distance so far are skipped, with the
+ * box distances computed by SIMD code where the CPU supports it.  The others are measured
+ * with SEG::SquaredDistance().
+ */
+SEG::ecoord MinSegmentSquaredDistance( const VECTOR2I& aP, const VECTOR2I* aPts,
+                                       int aPointCount, int aFirst, int aLast,
+                                       int* aNearest = nullptr );
+
+#endif // SEG_BATCH_H
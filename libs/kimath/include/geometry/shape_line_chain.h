@@ -29,12 +29,15 @@
 
 #include <clipper.hpp>
 #include <clipper2/clipper.h>
+#include <core/spinlock.h>
 #include <geometry/seg.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
 #include <geometry/corner_strategy.h>
 #include <math/vector2d.h>
 
+#include <memory>
+
 /**
  * Holds information on each point of a SHAPE_LINE_CHAIN that is retrievable
  * after an operation with ClipperLib
@@ -217,6 +220,13 @@ public:
     virtual bool Collide( const SEG& aSeg, int aClearance = 0, int* aActual = nullptr,
                           VECTOR2I* aLocation = nullptr ) const override;
 
+    /// @copydoc SHAPE_LINE_CHAIN_BASE::PointInside()
+    bool PointInside( const VECTOR2I& aPt, int aAccuracy = 0,
+                      bool aUseBBoxCache = false ) const override;
+
+    /// @copydoc SHAPE_LINE_CHAIN_BASE::SquaredDistance()
+    SEG::ecoord SquaredDistance( const VECTOR2I& aP, bool aOutlineOnly = false ) const override;
+
     /**
      * Finds closest points between this and the other line chain. Doesn't test segments or arcs.
      *
@@ -260,6 +270,7 @@ public:
      */
     void Clear()
     {
+        invalidateSegmentIndex();
         m_points.clear();
         m_arcs.clear();
         m_shapes.clear();
@@ -274,6 +285,7 @@ public:
      */
     void SetClosed( bool aClosed )
     {
+        invalidateSegmentIndex();
         m_closed = aClosed;
         mergeFirstLastPointIfNeeded();
     }
@@ -523,6 +535,7 @@ public:
 
         if( m_points.size() == 0 || aAllowDuplication || CPoint( -1 ) != aP )
         {
+            invalidateSegmentIndex();
             m_points.push_back( aP );
             m_shapes.push_back( SHAPES_ARE_PT );
             m_bbox.Merge( aP );
@@ -746,6 +759,8 @@ public:
 
     void Move( const VECTOR2I& aVector ) override
     {
+        invalidateSegmentIndex();
+
         for( auto& pt : m_points )
             pt += aVector;
 
@@ -942,6 +957,51 @@ protected:
     void mergeFirstLastPointIfNeeded();
 
 private:
+    /// Bounding volume hierarchy over the segments of a long chain, defined in the .cpp file.
+    class SEGMENT_INDEX;
+
+    /**
+     * Holder for the lazily built #SEGMENT_INDEX.
+     *
+     * Copies start out empty: the source may be building its index on another thread, and the
+     * copy builds its own the first time it is queried.  The lock is only held to read or
+     * replace the pointer, never while building.
+     */
+    struct SEGMENT_INDEX_CACHE
+    {
+        SEGMENT_INDEX_CACHE() = default;
+
+        SEGMENT_INDEX_CACHE( const SEGMENT_INDEX_CACHE& )
+        {}
+
+        SEGMENT_INDEX_CACHE& operator=( const SEGMENT_INDEX_CACHE& )
+        {
+            m_index.reset();
+            return *this;
+        }
+
+        std::shared_ptr<const SEGMENT_INDEX> m_index;
+
+        /// guards m_index when several threads query the chain at once
+        KISPINLOCK                           m_lock;
+    };
+
+    /**
+     * Return the segment index, building it if needed.
+     *
+     * @return the index, or nullptr when the chain is too short to benefit from one.
+     */
+    std::shared_ptr<const SEGMENT_INDEX> segmentIndex() const;
+
+    /**
+     * Drop the segment index.  Must be called by everything changing the points or the closed
+     * state of the chain.
+     */
+    void invalidateSegmentIndex()
+    {
+        m_segmentIndex.m_index.reset();
+    }
+
 
     static const ssize_t SHAPE_IS_PT;
 
@@ -980,6 +1040,9 @@ private:
 
     /// cached bounding box
     mutable BOX2I m_bbox;
+
+    /// index of the segments, used by the collision queries on long chains
+    mutable SEGMENT_INDEX_CACHE m_segmentIndex;
 };
 
 
@@ -1470,6 +1470,16 @@ public:
      */
     static const SHAPE_POLY_SET BuildPolysetFromOrientedPaths( const std::vector<SHAPE_LINE_CHAIN>& aPaths, bool aReverseOrientation = false, bool aEvenOdd = false );
 
+    /**
+     * Override the TiledBooleanMinVertices advanced setting, which sets the number of vertices
+     * from which boolean operations are run tile by tile.  Mostly useful to compare the tiled
+     * and untiled results in tests.
+     *
+     * @param aMinVertices is the number of vertices, 0 to never use tiles, or a negative value
+     *                     to go back to the advanced setting.
+     */
+    static void SetTiledBooleanMinVertices( int aMinVertices );
+
     void TransformToPolygon( SHAPE_POLY_SET& aBuffer, int aError,
                              ERROR_LOC aErrorLoc ) const override
     {
@@ -1529,6 +1539,21 @@ private:
     void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                     const SHAPE_POLY_SET& aOtherShape );
 
+    /**
+     * Run a Clipper2 boolean operation on large inputs tile by tile on the thread pool, and
+     * stitch the tiles back together along their edges.
+     *
+     * The result is the same as that of a single Clipper2 call, except for the rounding of the
+     * intersections along edges crossing the tile boundaries (about 1 nm).  Arcs are not
+     * supported, as the tile boundaries would cut through them.
+     *
+     * @return false if the inputs are too small to be worth splitting or couldn't be stitched,
+     *         in which case this is unchanged.
+     */
+    bool tiledBooleanOp( Clipper2Lib::ClipType aType, const Clipper2Lib::Paths64& aSubjects,
+                         const Clipper2Lib::Paths64& aClips,
+                         const std::vector<CLIPPER_Z_VALUE>& aZValues );
+
     /**
      * Check whether the point \a aP is inside the \a aSubpolyIndex-th polygon of the polyset. If
      * the points lies on an edge, the polygon is considered to contain it.
@@ -48,8 +48,10 @@
 
 #include <algorithm>
 #include <deque>
+#include <memory_resource>
 
 #include <math/box2.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/shape_line_chain.h>
 
 class VERTEX_SET;
@@ -251,7 +253,11 @@ class VERTEX_SET
     friend class VERTEX;
 
 public:
-    VERTEX_SET( int aSimplificationLevel )
+    /**
+     * The vertices are allocated from the current GEOMETRY_ARENA of the calling thread, if any.
+     */
+    VERTEX_SET( int aSimplificationLevel ) :
+            m_vertices( GEOMETRY_ARENA::Current() )
     {
         m_simplificationLevel = aSimplificationLevel * ( VECTOR2I::extended_type ) aSimplificationLevel;
     }
@@ -336,7 +342,7 @@ protected:
     double  area( const VERTEX* p, const VERTEX* q, const VERTEX* r ) const;
 
     BOX2I                   m_bbox;
-    std::deque<VERTEX>      m_vertices;
+    std::pmr::deque<VERTEX> m_vertices;
     VECTOR2I::extended_type m_simplificationLevel;
 };
 
@@ -0,0 +1,46 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/geometry_arena.h>
+
+
+static thread_local std::pmr::memory_resource* s_currentArena = nullptr;
+
+
+GEOMETRY_ARENA::GEOMETRY_ARENA() :
+        m_buffer( std::pmr::new_delete_resource() ),
+        m_previous( s_currentArena )
+{
+    s_currentArena = &m_buffer;
+}
+
+
+GEOMETRY_ARENA::~GEOMETRY_ARENA()
+{
+    s_currentArena = m_previous;
+}
+
+
+std::pmr::memory_resource* GEOMETRY_ARENA::Current()
+{
+    return s_currentArena ? s_currentArena : std::pmr::new_delete_resource();
+}
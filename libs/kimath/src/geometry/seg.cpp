@@ -397,25 +397,6 @@ int SEG::Distance( const VECTOR2I& aP ) const
 }
 
 
-SEG::ecoord SEG::SquaredDistance( const VECTOR2I& aP ) const
-{
-    VECTOR2L ab = VECTOR2L( B.x - A.x, B.y - A.y );
-    VECTOR2L ap = VECTOR2L( aP.x - A.x, aP.y - A.y );
-
-    ecoord e = ap.Dot( ab );
-
-    if( e <= 0 )
-        return ap.SquaredEuclideanNorm();
-
-    ecoord f = ab.SquaredEuclideanNorm();
-
-    if( e >= f )
-        return VECTOR2L( aP.x - B.x, aP.y - B.y ).SquaredEuclideanNorm();
-
-    return KiROUND<double, ecoord>( ap.SquaredEuclideanNorm() - ( double( e ) * e ) / f );
-}
-
-
 int SEG::LineDistance( const VECTOR2I& aP, bool aDetermineSide ) const
 {
     ecoord p = ecoord{ A.y } - B.y;
@@ -0,0 +1,377 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include <geometry/seg_batch.h>
+#include <math/util.h>          // for rescale
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#include <immintrin.h>
+
+// SSE2 is part of x86-64, AVX2 has to be checked for at runtime
+#define SEG_BATCH_SSE2
+
+#if defined( __GNUC__ )
+#define SEG_BATCH_AVX2
+#endif
+#endif
+
+static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int ), "VECTOR2I must be a packed x, y pair" );
+
+/// Segments filtered per mask; the mask holds one bit per segment end.
+static constexpr int BLOCK_SEGMENTS = 63;
+
+
+/**
+ * @return a mask whose bit j is set if aPts[j].y > aY, for j < aCount <= 64.
+ */
+static uint64_t aboveMaskScalar( int aY, const VECTOR2I* aPts, int aCount )
+{
+    uint64_t mask = 0;
+
+    for( int j = 0; j < aCount; ++j )
+        mask |= uint64_t( aPts[j].y > aY ) << j;
+
+    return mask;
+}
+
+
+#ifdef SEG_BATCH_SSE2
+static uint64_t aboveMaskSse2( int aY, const VECTOR2I* aPts, int aCount )
+{
+    const __m128i y = _mm_set1_epi32( aY );
+    uint64_t      mask = 0;
+    int           j = 0;
+
+    for( ; j + 4 <= aCount; j += 4 )
+    {
+        __m128 lo = _mm_castsi128_ps( _mm_loadu_si128( (const __m128i*) ( aPts + j ) ) );
+        __m128 hi = _mm_castsi128_ps( _mm_loadu_si128( (const __m128i*) ( aPts + j + 2 ) ) );
+
+        // The y of points j to j + 3, in order
+        __m128i ys = _mm_castps_si128( _mm_shuffle_ps( lo, hi, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+        __m128i above = _mm_cmpgt_epi32( ys, y );
+
+        mask |= uint64_t( _mm_movemask_ps( _mm_castsi128_ps( above ) ) ) << j;
+    }
+
+    if( j < aCount )
+        mask |= aboveMaskScalar( aY, aPts + j, aCount - j ) << j;
+
+    return mask;
+}
+#endif
+
+
+#ifdef SEG_BATCH_AVX2
+__attribute__(( target( "avx2" ) ))
+static uint64_t aboveMaskAvx2( int aY, const VECTOR2I* aPts, int aCount )
+{
+    const __m256i y = _mm256_set1_epi32( aY );
+    uint64_t      mask = 0;
+    int           j = 0;
+
+    for( ; j + 8 <= aCount; j += 8 )
+    {
+        __m256 lo = _mm256_castsi256_ps( _mm256_loadu_si256( (const __m256i*) ( aPts + j ) ) );
+        __m256 hi = _mm256_castsi256_ps( _mm256_loadu_si256( (const __m256i*) ( aPts + j + 4 ) ) );
+
+        // The shuffle works within 128 bit lanes and gives the y of points 0, 1, 4, 5, 2, 3,
+        // 6, 7; the permute puts them back in order
+        __m256i ys = _mm256_castps_si256( _mm256_shuffle_ps( lo, hi, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+        ys = _mm256_permute4x64_epi64( ys, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+        __m256i above = _mm256_cmpgt_epi32( ys, y );
+
+        mask |= uint64_t( _mm256_movemask_ps( _mm256_castsi256_ps( above ) ) ) << j;
+    }
+
+    if( j < aCount )
+        mask |= aboveMaskScalar( aY, aPts + j, aCount - j ) << j;
+
+    return mask;
+}
+#endif
+
+
+static uint64_t aboveMask( int aY, const VECTOR2I* aPts, int aCount )
+{
+#ifdef SEG_BATCH_AVX2
+    static const bool haveAvx2 =
+            []()
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports( "avx2" ) != 0;
+            }();
+
+    if( haveAvx2 )
+        return aboveMaskAvx2( aY, aPts, aCount );
+#endif
+
+#ifdef SEG_BATCH_SSE2
+    return aboveMaskSse2( aY, aPts, aCount );
+#else
+    return aboveMaskScalar( aY, aPts, aCount );
+#endif
+}
+
+
+int CountRayCrossings( const VECTOR2I& aP, const VECTOR2I* aPts, int aPointCount, int aFirst,
+                       int aLast )
+{
+    int crossings = 0;
+
+    // Only called for segments spanning aP.y, so that the division in rescale() is skipped for
+    // all the others
+    auto testSegment =
+            [&]( int i )
+            {
+                const VECTOR2I& p1 = aPts[i];
+                const VECTOR2I& p2 = aPts[i + 1 == aPointCount ? 0 : i + 1];
+                const VECTOR2I  diff = p2 - p1;
+                const int       d = rescale( diff.x, ( aP.y - p1.y ), diff.y );
+
+                if( aP.x - p1.x < d )
+                    crossings++;
+            };
+
+    // Up to the closing segment, the ends of consecutive segments are consecutive points, so
+    // a segment spans aP.y when the above/below bits of its two ends differ.
+    int last = std::min( aLast, aPointCount - 1 );
+
+    for( int first = aFirst; first < last; first += BLOCK_SEGMENTS )
+    {
+        int      count = std::min( BLOCK_SEGMENTS, last - first );
+        uint64_t above = aboveMask( aP.y, aPts + first, count + 1 );
+        uint64_t spanning = ( above ^ ( above >> 1 ) ) & ( ( uint64_t( 1 ) << count ) - 1 );
+
+        while( spanning )
+        {
+            testSegment( first + std::countr_zero( spanning ) );
+            spanning &= spanning - 1;
+        }
+    }
+
+    if( aFirst < aLast && aLast == aPointCount )
+    {
+        const VECTOR2I& p1 = aPts[aPointCount - 1];
+        const VECTOR2I& p2 = aPts[0];
+
+        if( ( p1.y > aP.y ) != ( p2.y > aP.y ) )
+            testSegment( aPointCount - 1 );
+    }
+
+    return crossings;
+}
+
+
+/**
+ * Margin added to the best distance before the box test rejects a segment.  It covers the
+ * rounding of the double part of SEG::SquaredDistance() and of the bound itself, which for
+ * int coordinates stays well under 2^16.
+ */
+static constexpr double NEAR_MARGIN = 131072.0;
+
+/// Segments box tested at a time.  The blocks are kept short so that the limit follows the
+/// best distance closely.
+static constexpr int NEAR_BLOCK_SEGMENTS = 16;
+
+
+/**
+ * @return a mask whose bit j is set unless the bounding box of segment j, joining aPts[j] to
+ *         aPts[j + 1], is further than \a aLimit (squared) from \a aP, for j < aCount < 64.
+ *
+ * A rejected segment can't be nearer than aLimit, as SEG::SquaredDistance() measures to a
+ * point of the box.  Without SIMD support, no segment is rejected.
+ */
+static uint64_t nearMaskScalar( const VECTOR2I& aP, double aLimit, const VECTOR2I* aPts,
+                                int aCount )
+{
+    return ( uint64_t( 1 ) << aCount ) - 1;
+}
+
+
+#ifdef SEG_BATCH_SSE2
+static uint64_t nearMaskSse2( const VECTOR2I& aP, double aLimit, const VECTOR2I* aPts,
+                              int aCount )
+{
+    const __m128d px = _mm_set1_pd( aP.x );
+    const __m128d py = _mm_set1_pd( aP.y );
+    const __m128d limit = _mm_set1_pd( aLimit );
+    const __m128d zero = _mm_setzero_pd();
+    uint64_t      mask = 0;
+    int           j = 0;
+
+    // Segments j and j + 1 join points j, j + 1 and j + 2, which are all in the run
+    for( ; j + 2 <= aCount; j += 2 )
+    {
+        // x0, x1, y0, y1 of the starts and of the ends
+        __m128i a = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i*) ( aPts + j ) ),
+                                       _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        __m128i b = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i*) ( aPts + j + 1 ) ),
+                                       _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+        __m128d ax = _mm_cvtepi32_pd( a );
+        __m128d ay = _mm_cvtepi32_pd( _mm_unpackhi_epi64( a, a ) );
+        __m128d bx = _mm_cvtepi32_pd( b );
+        __m128d by = _mm_cvtepi32_pd( _mm_unpackhi_epi64( b, b ) );
+
+        __m128d gx = _mm_max_pd( _mm_sub_pd( _mm_min_pd( ax, bx ), px ),
+                                 _mm_sub_pd( px, _mm_max_pd( ax, bx ) ) );
+        __m128d gy = _mm_max_pd( _mm_sub_pd( _mm_min_pd( ay, by ), py ),
+                                 _mm_sub_pd( py, _mm_max_pd( ay, by ) ) );
+
+        gx = _mm_max_pd( gx, zero );
+        gy = _mm_max_pd( gy, zero );
+
+        __m128d bound = _mm_add_pd( _mm_mul_pd( gx, gx ), _mm_mul_pd( gy, gy ) );
+
+        mask |= uint64_t( _mm_movemask_pd( _mm_cmple_pd( bound, limit ) ) ) << j;
+    }
+
+    if( j < aCount )
+        mask |= nearMaskScalar( aP, aLimit, aPts + j, aCount - j ) << j;
+
+    return mask;
+}
+#endif
+
+
+#ifdef SEG_BATCH_AVX2
+__attribute__(( target( "avx2" ) ))
+static uint64_t nearMaskAvx2( const VECTOR2I& aP, double aLimit, const VECTOR2I* aPts,
+                              int aCount )
+{
+    const __m256d px = _mm256_set1_pd( aP.x );
+    const __m256d py = _mm256_set1_pd( aP.y );
+    const __m256d limit = _mm256_set1_pd( aLimit );
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256i split = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+    uint64_t      mask = 0;
+    int           j = 0;
+
+    for( ; j + 4 <= aCount; j += 4 )
+    {
+        // The x of the four points in the low lane, the y in the high one
+        __m256i a = _mm256_permutevar8x32_epi32(
+                _mm256_loadu_si256( (const __m256i*) ( aPts + j ) ), split );
+        __m256i b = _mm256_permutevar8x32_epi32(
+                _mm256_loadu_si256( (const __m256i*) ( aPts + j + 1 ) ), split );
+
+        __m256d ax = _mm256_cvtepi32_pd( _mm256_castsi256_si128( a ) );
+        __m256d ay = _mm256_cvtepi32_pd( _mm256_extracti128_si256( a, 1 ) );
+        __m256d bx = _mm256_cvtepi32_pd( _mm256_castsi256_si128( b ) );
+        __m256d by = _mm256_cvtepi32_pd( _mm256_extracti128_si256( b, 1 ) );
+
+        __m256d gx = _mm256_max_pd( _mm256_sub_pd( _mm256_min_pd( ax, bx ), px ),
+                                    _mm256_sub_pd( px, _mm256_max_pd( ax, bx ) ) );
+        __m256d gy = _mm256_max_pd( _mm256_sub_pd( _mm256_min_pd( ay, by ), py ),
+                                    _mm256_sub_pd( py, _mm256_max_pd( ay, by ) ) );
+
+        gx = _mm256_max_pd( gx, zero );
+        gy = _mm256_max_pd( gy, zero );
+
+        __m256d bound = _mm256_add_pd( _mm256_mul_pd( gx, gx ), _mm256_mul_pd( gy, gy ) );
+        __m256d near = _mm256_cmp_pd( bound, limit, _CMP_LE_OQ );
+
+        mask |= uint64_t( _mm256_movemask_pd( near ) ) << j;
+    }
+
+    if( j < aCount )
+        mask |= nearMaskScalar( aP, aLimit, aPts + j, aCount - j ) << j;
+
+    return mask;
+}
+#endif
+
+
+static uint64_t nearMask( const VECTOR2I& aP, double aLimit, const VECTOR2I* aPts, int aCount )
+{
+#ifdef SEG_BATCH_AVX2
+    static const bool haveAvx2 =
+            []()
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports( "avx2" ) != 0;
+            }();
+
+    if( haveAvx2 )
+        return nearMaskAvx2( aP, aLimit, aPts, aCount );
+#endif
+
+#ifdef SEG_BATCH_SSE2
+    return nearMaskSse2( aP, aLimit, aPts, aCount );
+#else
+    return nearMaskScalar( aP, aLimit, aPts, aCount );
+#endif
+}
+
+
+SEG::ecoord MinSegmentSquaredDistance( const VECTOR2I& aP, const VECTOR2I* aPts,
+                                       int aPointCount, int aFirst, int aLast, int* aNearest )
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+    auto testSegment =
+            [&]( int i, const VECTOR2I& aB )
+            {
+                SEG::ecoord d = SEG( aPts[i], aB ).SquaredDistance( aP );
+
+                if( d < best )
+                {
+                    best = d;
+
+                    if( aNearest )
+                        *aNearest = i;
+                }
+            };
+
+    // The box test only rejects segments which can't be nearer than the best one so far, and
+    // the others are tested in order, so the result is that of testing them all.  The first
+    // segment is tested on its own to give the limit a start.
+    int last = std::min( aLast, aPointCount - 1 );
+
+    if( aFirst < last )
+        testSegment( aFirst, aPts[aFirst + 1] );
+
+    for( int first = aFirst + 1; first < last && best > 0; first += NEAR_BLOCK_SEGMENTS )
+    {
+        int      count = std::min( NEAR_BLOCK_SEGMENTS, last - first );
+        uint64_t near = nearMask( aP, double( best ) + NEAR_MARGIN, aPts + first, count );
+
+        while( near && best > 0 )
+        {
+            int i = first + std::countr_zero( near );
+
+            testSegment( i, aPts[i + 1] );
+            near &= near - 1;
+        }
+    }
+
+    if( aFirst < aLast && aLast == aPointCount && best > 0 )
+        testSegment( aPointCount - 1, aPts[0] );
+
+    return best;
+}
@@ -27,6 +27,7 @@
 #include <limits>
 #include <math.h>            // for hypot
 #include <map>
+#include <mutex>
 #include <string>            // for basic_string
 
 #include <clipper.hpp>
@@ -34,6 +35,7 @@
 #include <core/kicad_algo.h> // for alg::run_on_pair
 #include <geometry/circle.h>
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>       // for BOX2I
@@ -47,6 +49,227 @@ class SHAPE;
 const ssize_t                     SHAPE_LINE_CHAIN::SHAPE_IS_PT = -1;
 const std::pair<ssize_t, ssize_t> SHAPE_LINE_CHAIN::SHAPES_ARE_PT = { SHAPE_IS_PT, SHAPE_IS_PT };
 
+/// Chains with fewer segments than this are searched linearly, without a segment index.
+static const int SEGMENT_INDEX_MIN_SEGMENTS = 256;
+
+
+/**
+ * A bounding volume hierarchy over the segments of a chain.
+ *
+ * The leaves are runs of consecutive segments, which are normally close to each other, so the
+ * tree is built bottom-up in chain order without sorting anything.  Walking the tree from left
+ * to right visits the segments in increasing order, so the indexed queries can give exactly
+ * the same answers as the linear scans.
+ */
+class SHAPE_LINE_CHAIN::SEGMENT_INDEX
+{
+public:
+    /**
+     * An axis-aligned box with 64 bit coordinates, so that inflating it by a clearance or
+     * making it unbounded can't overflow.
+     */
+    struct BOX
+    {
+        int64_t minX = std::numeric_limits<int64_t>::max();
+        int64_t minY = std::numeric_limits<int64_t>::max();
+        int64_t maxX = std::numeric_limits<int64_t>::min();
+        int64_t maxY = std::numeric_limits<int64_t>::min();
+
+        BOX() = default;
+
+        BOX( int64_t aMinX, int64_t aMinY, int64_t aMaxX, int64_t aMaxY ) :
+                minX( aMinX ),
+                minY( aMinY ),
+                maxX( aMaxX ),
+                maxY( aMaxY )
+        {}
+
+        void Merge( const VECTOR2I& aP )
+        {
+            minX = std::min<int64_t>( minX, aP.x );
+            minY = std::min<int64_t>( minY, aP.y );
+            maxX = std::max<int64_t>( maxX, aP.x );
+            maxY = std::max<int64_t>( maxY, aP.y );
+        }
+
+        void Merge( const BOX& aOther )
+        {
+            minX = std::min( minX, aOther.minX );
+            minY = std::min( minY, aOther.minY );
+            maxX = std::max( maxX, aOther.maxX );
+            maxY = std::max( maxY, aOther.maxY );
+        }
+
+        bool Intersects( const BOX& aOther ) const
+        {
+            return minX <= aOther.maxX && aOther.minX <= maxX
+                   && minY <= aOther.maxY && aOther.minY <= maxY;
+        }
+
+        double SquaredDistance( const VECTOR2I& aP ) const
+        {
+            double dx = std::max<double>( { 0.0, double( minX - aP.x ), double( aP.x - maxX ) } );
+            double dy = std::max<double>( { 0.0, double( minY - aP.y ), double( aP.y - maxY ) } );
+
+            return dx * dx + dy * dy;
+        }
+    };
+
+    SEGMENT_INDEX( const SHAPE_LINE_CHAIN& aChain ) :
+            m_segmentCount( aChain.SegmentCount() )
+    {
+        const std::vector<VECTOR2I>& pts = aChain.CPoints();
+        std::vector<BOX>             leaves( ( m_segmentCount + LEAF_SIZE - 1 ) / LEAF_SIZE );
+
+        for( int ii = 0; ii < m_segmentCount; ++ii )
+        {
+            BOX& leaf = leaves[ii / LEAF_SIZE];
+
+            leaf.Merge( pts[ii] );
+            leaf.Merge( pts[ii + 1 == (int) pts.size() ? 0 : ii + 1] );
+        }
+
+        m_levels.push_back( std::move( leaves ) );
+
+        while( m_levels.back().size() > 1 )
+        {
+            const std::vector<BOX>& children = m_levels.back();
+            std::vector<BOX>        parents( ( children.size() + 1 ) / 2 );
+
+            for( size_t ii = 0; ii < children.size(); ++ii )
+                parents[ii / 2].Merge( children[ii] );
+
+            m_levels.push_back( std::move( parents ) );
+        }
+    }
+
+    /**
+     * Call \a aVisitor with the index of each segment whose leaf touches \a aBox, in increasing
+     * order, until it returns false.
+     *
+     * @return false if the visitor stopped the query.
+     */
+    template <typename VISITOR>
+    bool Query( const BOX& aBox, VISITOR&& aVisitor ) const
+    {
+        return QueryRuns( aBox,
+                          [&]( int aFirst, int aLast ) -> bool
+                          {
+                              for( int ii = aFirst; ii < aLast; ++ii )
+                              {
+                                  if( !aVisitor( ii ) )
+                                      return false;
+                              }
+
+                              return true;
+                          } );
+    }
+
+    /**
+     * Call \a aVisitor with the first and past-the-end segment indices of each leaf touching
+     * \a aBox, in increasing order, until it returns false.
+     *
+     * @return false if the visitor stopped the query.
+     */
+    template <typename VISITOR>
+    bool QueryRuns( const BOX& aBox, VISITOR&& aVisitor ) const
+    {
+        return query( m_levels.size() - 1, 0, aBox, aVisitor );
+    }
+
+    /**
+     * @return the smallest squared distance from \a aP to a segment of \a aChain, which must
+     *         be the chain the index was built for.
+     */
+    SEG::ecoord SquaredDistance( const SHAPE_LINE_CHAIN& aChain, const VECTOR2I& aP ) const
+    {
+        SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+        nearest( m_levels.size() - 1, 0, aChain, aP, best );
+
+        return best;
+    }
+
+private:
+    template <typename VISITOR>
+    bool query( size_t aLevel, size_t aNode, const BOX& aBox, VISITOR& aVisitor ) const
+    {
+        if( !m_levels[aLevel][aNode].Intersects( aBox ) )
+            return true;
+
+        if( aLevel == 0 )
+            return aVisitor( (int) aNode * LEAF_SIZE, leafEnd( aNode ) );
+
+        size_t lastChild = std::min( aNode * 2 + 2, m_levels[aLevel - 1].size() );
+
+        for( size_t child = aNode * 2; child < lastChild; ++child )
+        {
+            if( !query( aLevel - 1, child, aBox, aVisitor ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    void nearest( size_t aLevel, size_t aNode, const SHAPE_LINE_CHAIN& aChain,
+                  const VECTOR2I& aP, SEG::ecoord& aBest ) const
+    {
+        if( m_levels[aLevel][aNode].SquaredDistance( aP ) >= double( aBest ) )
+            return;
+
+        if( aLevel == 0 )
+        {
+            const std::vector<VECTOR2I>& pts = aChain.CPoints();
+
+            aBest = std::min( aBest, MinSegmentSquaredDistance( aP, pts.data(), pts.size(),
+                                                                aNode * LEAF_SIZE,
+                                                                leafEnd( aNode ) ) );
+            return;
+        }
+
+        size_t lastChild = std::min( aNode * 2 + 2, m_levels[aLevel - 1].size() );
+
+        for( size_t child = aNode * 2; child < lastChild; ++child )
+            nearest( aLevel - 1, child, aChain, aP, aBest );
+    }
+
+    /// @return the index past the last segment of leaf \a aNode.
+    int leafEnd( size_t aNode ) const
+    {
+        return std::min<int>( ( aNode + 1 ) * LEAF_SIZE, m_segmentCount );
+    }
+
+    static constexpr int LEAF_SIZE = 8;
+
+    int                           m_segmentCount;
+
+    /// Boxes of the tree by level, from the leaves (level 0) up to the root.
+    std::vector<std::vector<BOX>> m_levels;
+};
+
+
+std::shared_ptr<const SHAPE_LINE_CHAIN::SEGMENT_INDEX> SHAPE_LINE_CHAIN::segmentIndex() const
+{
+    if( SegmentCount() < SEGMENT_INDEX_MIN_SEGMENTS )
+        return nullptr;
+
+    {
+        std::lock_guard<KISPINLOCK> lock( m_segmentIndex.m_lock );
+
+        if( m_segmentIndex.m_index )
+            return m_segmentIndex.m_index;
+    }
+
+    // Build outside of the lock.  If another thread gets there first, use its index.
+    std::shared_ptr<const SEGMENT_INDEX> index = std::make_shared<const SEGMENT_INDEX>( *this );
+    std::lock_guard<KISPINLOCK>          lock( m_segmentIndex.m_lock );
+
+    if( !m_segmentIndex.m_index )
+        m_segmentIndex.m_index = index;
+
+    return m_segmentIndex.m_index;
+}
+
 
 SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const std::vector<int>& aV)
     : SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ), m_closed( false ), m_width( 0 )
@@ -237,6 +460,8 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
 
 void SHAPE_LINE_CHAIN::fixIndicesRotation()
 {
+    invalidateSegmentIndex();
+
     wxCHECK( m_shapes.size() == m_points.size(), /*void*/ );
 
     if( m_shapes.size() <= 1 )
@@ -260,6 +485,8 @@ void SHAPE_LINE_CHAIN::fixIndicesRotation()
 
 void SHAPE_LINE_CHAIN::mergeFirstLastPointIfNeeded()
 {
+    invalidateSegmentIndex();
+
     if( m_closed )
     {
         if( m_points.size() > 1 && m_points.front() == m_points.back() )
@@ -338,6 +565,8 @@ void SHAPE_LINE_CHAIN::amendArc( size_t aArcIndex, const VECTOR2I& aNewStart,
 
 void SHAPE_LINE_CHAIN::splitArc( ssize_t aPtIndex, bool aCoincident )
 {
+    invalidateSegmentIndex();
+
     if( aPtIndex < 0 )
         aPtIndex += m_shapes.size();
 
@@ -488,26 +717,48 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // Returns false once the search can stop
+    auto collideSegment =
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        VECTOR2I    pn = s.NearestPoint( aP );
-        SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
+                const SEG&  s = GetSegment( i );
+                VECTOR2I    pn = s.NearestPoint( aP );
+                SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
-        {
-            nearest = pn;
-            closest_dist_sq = dist_sq;
+                if( dist_sq < closest_dist_sq )
+                {
+                    nearest = pn;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            };
+
+    // Collide line segments.  Only the segments within the clearance can collide, and the
+    // index visits them in the same order as the linear scan.
+    if( std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex() )
+    {
+        int64_t clearance = std::abs( (int64_t) aClearance );
+
+        index->Query( SEGMENT_INDEX::BOX( aP.x - clearance, aP.y - clearance,
+                                          aP.x + clearance, aP.y + clearance ),
+                      collideSegment );
+    }
+    else
+    {
+        for( size_t i = 0; i < GetSegmentCount(); i++ )
+        {
+            if( !collideSegment( i ) )
                 break;
         }
     }
@@ -541,6 +792,8 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
 
 void SHAPE_LINE_CHAIN::Rotate( const EDA_ANGLE& aAngle, const VECTOR2I& aCenter )
 {
+    invalidateSegmentIndex();
+
     for( VECTOR2I& pt : m_points )
         RotatePoint( pt, aCenter, aAngle );
 
@@ -877,27 +1130,51 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // Returns false once the search can stop
+    auto collideSegment =
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
+                const SEG&  s = GetSegment( i );
+                SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
-        if( dist_sq < closest_dist_sq )
-        {
-            if( aLocation )
-                nearest = s.NearestPoint( aSeg );
+                if( dist_sq < closest_dist_sq )
+                {
+                    if( aLocation )
+                        nearest = s.NearestPoint( aSeg );
 
-            closest_dist_sq = dist_sq;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            };
+
+    // Collide line segments.  Only the segments within the clearance can collide, and the
+    // index visits them in the same order as the linear scan.
+    if( std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex() )
+    {
+        int64_t clearance = std::abs( (int64_t) aClearance );
+
+        index->Query( SEGMENT_INDEX::BOX( std::min( aSeg.A.x, aSeg.B.x ) - clearance,
+                                          std::min( aSeg.A.y, aSeg.B.y ) - clearance,
+                                          std::max( aSeg.A.x, aSeg.B.x ) + clearance,
+                                          std::max( aSeg.A.y, aSeg.B.y ) + clearance ),
+                      collideSegment );
+    }
+    else
+    {
+        for( size_t i = 0; i < GetSegmentCount(); i++ )
+        {
+            if( !collideSegment( i ) )
                 break;
         }
     }
@@ -1020,6 +1297,8 @@ long long int SHAPE_LINE_CHAIN::Length() const
 
 void SHAPE_LINE_CHAIN::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateSegmentIndex();
+
     for( auto& pt : m_points )
     {
         if( aX )
@@ -1036,6 +1315,8 @@ void SHAPE_LINE_CHAIN::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_LINE_CHAIN::Mirror( const SEG& axis )
 {
+    invalidateSegmentIndex();
+
     for( auto& pt : m_points )
         pt = axis.ReflectPoint( pt );
 
@@ -1054,6 +1335,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const VECTOR2I&
 
 void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE_CHAIN& aLine )
 {
+    invalidateSegmentIndex();
+
     if( aEndIndex < 0 )
         aEndIndex += PointCount();
 
@@ -1124,6 +1407,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
 
 void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
 {
+    invalidateSegmentIndex();
+
     wxCHECK( m_shapes.size() == m_points.size(), /*void*/ );
 
     // Unwrap the chain first (correctly handling removing arc at
@@ -1228,6 +1513,8 @@ SEG::ecoord SHAPE_LINE_CHAIN_BASE::SquaredDistance( const VECTOR2I& aP, bool aOu
 
 int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP, bool aExact )
 {
+    invalidateSegmentIndex();
+
     int ii = -1;
     int min_dist = 2;
 
@@ -1407,6 +1694,8 @@ int SHAPE_LINE_CHAIN::NextShape( int aPointIndex ) const
 
 void SHAPE_LINE_CHAIN::SetPoint( int aIndex, const VECTOR2I& aPos )
 {
+    invalidateSegmentIndex();
+
     if( aIndex < 0 )
         aIndex += PointCount();
     else if( aIndex >= PointCount() )
@@ -1586,6 +1875,8 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Slice( int aStartIndex, int aEndIndex )
 
 void SHAPE_LINE_CHAIN::Append( const SHAPE_LINE_CHAIN& aOtherLine )
 {
+    invalidateSegmentIndex();
+
     assert( m_shapes.size() == m_points.size() );
 
     if( aOtherLine.PointCount() == 0 )
@@ -1677,6 +1968,8 @@ void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 {
+    invalidateSegmentIndex();
+
     if( aVertex == m_points.size() )
     {
         Append( aP );
@@ -1698,6 +1991,8 @@ void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const SHAPE_ARC& aArc )
 {
+    invalidateSegmentIndex();
+
     wxCHECK( aVertex < m_points.size(), /* void */ );
 
     if( aVertex > 0 && IsPtOnArc( aVertex ) )
@@ -1963,13 +2258,15 @@ bool SHAPE_LINE_CHAIN_BASE::PointInside( const VECTOR2I& aPt, int aAccuracy,
     {
         const auto p1 = GetPoint( i++ );
         const auto p2 = GetPoint( i == pointCount ? 0 : i );
-        const auto diff = p2 - p1;
 
-        if( diff.y != 0 )
+        // Only segments spanning aPt.y can cross the ray (which also rules out horizontal
+        // ones), so test that before paying for the division.
+        if( ( p1.y > aPt.y ) != ( p2.y > aPt.y ) )
         {
-            const int d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
+            const auto diff = p2 - p1;
+            const int  d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
 
-            if( ( ( p1.y > aPt.y ) != ( p2.y > aPt.y ) ) && ( aPt.x - p1.x < d ) )
+            if( aPt.x - p1.x < d )
                 inside = !inside;
         }
     }
@@ -2016,6 +2313,76 @@ int SHAPE_LINE_CHAIN_BASE::EdgeContainingPoint( const VECTOR2I& aPt, int aAccura
 }
 
 
+bool SHAPE_LINE_CHAIN::PointInside( const VECTOR2I& aPt, int aAccuracy,
+                                    bool aUseBBoxCache ) const
+{
+    if( aUseBBoxCache && !m_bbox.Contains( aPt ) )
+        return false;
+
+    if( !IsClosed() || PointCount() < 3 )
+        return false;
+
+    // Same ray casting as SHAPE_LINE_CHAIN_BASE::PointInside(), on the point array.  With an
+    // index, only segments spanning aPt.y which reach past aPt.x can cross the ray.
+    std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex();
+    int                                  pointCount = PointCount();
+    int                                  crossings = 0;
+
+    if( index )
+    {
+        index->QueryRuns( SEGMENT_INDEX::BOX( aPt.x, aPt.y, std::numeric_limits<int64_t>::max(),
+                                              aPt.y ),
+                          [&]( int aFirst, int aLast ) -> bool
+                          {
+                              crossings += CountRayCrossings( aPt, m_points.data(), pointCount,
+                                                              aFirst, aLast );
+                              return true;
+                          } );
+    }
+    else
+    {
+        crossings = CountRayCrossings( aPt, m_points.data(), pointCount, 0, pointCount );
+    }
+
+    bool inside = crossings % 2 != 0;
+
+    if( aAccuracy <= 1 || inside )
+        return inside;
+
+    if( !index )
+        return PointOnEdge( aPt, aAccuracy );
+
+    // Same test as EdgeContainingPoint(), limited to the segments within aAccuracy
+    int64_t reach = (int64_t) aAccuracy + 1;
+    bool    onEdge = false;
+
+    index->Query( SEGMENT_INDEX::BOX( aPt.x - reach, aPt.y - reach, aPt.x + reach, aPt.y + reach ),
+                  [&]( int i ) -> bool
+                  {
+                      const SEG s = CSegment( i );
+
+                      if( s.A == aPt || s.B == aPt || s.Distance( aPt ) <= aAccuracy + 1 )
+                          onEdge = true;
+
+                      return !onEdge;
+                  } );
+
+    return onEdge;
+}
+
+
+SEG::ecoord SHAPE_LINE_CHAIN::SquaredDistance( const VECTOR2I& aP, bool aOutlineOnly ) const
+{
+    if( IsClosed() && PointInside( aP ) && !aOutlineOnly )
+        return 0;
+
+    if( std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex() )
+        return index->SquaredDistance( *this, aP );
+
+    return MinSegmentSquaredDistance( aP, m_points.data(), PointCount(), 0, SegmentCount() );
+}
+
+
 bool SHAPE_LINE_CHAIN::CheckClearance( const VECTOR2I& aP, const int aDist ) const
 {
     if( !PointCount() )
@@ -2434,6 +2801,8 @@ SHAPE* SHAPE_LINE_CHAIN::Clone() const
 
 bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
 {
+    invalidateSegmentIndex();
+
     size_t n_pts;
     size_t n_arcs;
 
@@ -2531,6 +2900,8 @@ double SHAPE_LINE_CHAIN::Area( bool aAbsolute ) const
 
 void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
 {
+    invalidateSegmentIndex();
+
     std::vector<VECTOR2I> pts_unique;
     std::vector<std::pair<ssize_t, ssize_t>> shapes_unique;
 
@@ -2593,6 +2964,8 @@ void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
 
 void SHAPE_LINE_CHAIN::Simplify( int aMaxError )
 {
+    invalidateSegmentIndex();
+
     if( PointCount() < 3 )
         return;
 
@@ -30,8 +30,12 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <atomic>
 #include <cmath>                             // for sqrt, cos, hypot, isinf
+#include <condition_variable>
 #include <cstdio>
+#include <exception>
+#include <functional>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <map>
@@ -44,9 +48,12 @@
 
 #include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <clipper2/clipper.h>
+#include <core/thread_pool.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
@@ -845,6 +852,508 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET
 }
 
 
+/**
+ * Call \a aTask for each index below \a aCount, on the thread pool and the calling thread, and
+ * return once all the calls are done.
+ *
+ * The indices are claimed from a shared counter by the calling thread and by helpers on the
+ * thread pool, and the calling thread waits for the indices rather than for the helpers.  This
+ * can't deadlock when we are already running on the pool (e.g. from BOARD::CacheTriangulation
+ * or the zone filler): a helper which only starts once all the indices are claimed has nothing
+ * left to do.  The helpers share ownership of the counters because they may start after we
+ * return, but they never call \a aTask then.
+ *
+ * If calls to \a aTask throw, the first exception is rethrown here once all the calls are done.
+ */
+static void runConcurrently( size_t aCount, const std::function<void( size_t )>& aTask )
+{
+    struct COUNTERS
+    {
+        std::atomic<size_t>     next = 0;
+        std::atomic<size_t>     done = 0;
+        std::mutex              doneMutex;
+        std::condition_variable doneCv;
+        std::exception_ptr      exception;
+    };
+
+    auto state = std::make_shared<COUNTERS>();
+
+    auto work =
+            [state, aCount, &aTask]()
+            {
+                for( size_t ii = state->next++; ii < aCount; ii = state->next++ )
+                {
+                    try
+                    {
+                        aTask( ii );
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard<std::mutex> doneLock( state->doneMutex );
+
+                        if( !state->exception )
+                            state->exception = std::current_exception();
+                    }
+
+                    if( ++state->done == aCount )
+                    {
+                        std::lock_guard<std::mutex> doneLock( state->doneMutex );
+                        state->doneCv.notify_all();
+                    }
+                }
+            };
+
+    if( aCount > 1 )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+        size_t       helpers = std::min<size_t>( aCount, tp.get_thread_count() ) - 1;
+
+        for( size_t ii = 0; ii < helpers; ++ii )
+            tp.push_task( work );
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> doneLock( state->doneMutex );
+    state->doneCv.wait( doneLock, [&]() { return state->done == aCount; } );
+
+    if( state->exception )
+        std::rethrow_exception( state->exception );
+}
+
+
+/// Neighbouring tiles overlap by this much, so that the rounding of points along their common
+/// edge can't leave a gap between their results.
+static const int64_t TILE_OVERLAP = 1000;
+
+/// About one tile per this many vertices of the inputs, within MIN_TILES and MAX_TILES.
+static const size_t TILE_VERTICES = 2500;
+static const size_t MIN_TILES = 4;
+static const size_t MAX_TILES = 256;
+
+/// Overrides ADVANCED_CFG::m_TiledBooleanMinVertices when not negative.
+static std::atomic<int> s_tiledBooleanMinVertices( -1 );
+
+
+void SHAPE_POLY_SET::SetTiledBooleanMinVertices( int aMinVertices )
+{
+    s_tiledBooleanMinVertices = aMinVertices;
+}
+
+
+/**
+ * Split \a aExtent into about \a aCount tiles of similar size, in rows and columns following its
+ * aspect ratio.
+ */
+static std::vector<Clipper2Lib::Rect64> makeTiles( const Clipper2Lib::Rect64& aExtent,
+                                                   size_t aCount )
+{
+    double width = std::max<double>( aExtent.Width(), 1.0 );
+    double height = std::max<double>( aExtent.Height(), 1.0 );
+    size_t cols = std::clamp<size_t>( std::lround( std::sqrt( aCount * width / height ) ), 1,
+                                      aCount );
+    size_t rows = std::max<size_t>( aCount / cols, 1 );
+
+    std::vector<Clipper2Lib::Rect64> tiles;
+
+    for( size_t row = 0; row < rows; ++row )
+    {
+        for( size_t col = 0; col < cols; ++col )
+        {
+            tiles.emplace_back( aExtent.left + aExtent.Width() * col / cols,
+                                aExtent.top + aExtent.Height() * row / rows,
+                                aExtent.left + aExtent.Width() * ( col + 1 ) / cols,
+                                aExtent.top + aExtent.Height() * ( row + 1 ) / rows );
+        }
+    }
+
+    return tiles;
+}
+
+
+static Clipper2Lib::Rect64 inflateRect( const Clipper2Lib::Rect64& aRect, int64_t aAmount )
+{
+    return Clipper2Lib::Rect64( aRect.left - aAmount, aRect.top - aAmount,
+                                aRect.right + aAmount, aRect.bottom + aAmount );
+}
+
+
+static bool rectsIntersect( const Clipper2Lib::Rect64& aA, const Clipper2Lib::Rect64& aB )
+{
+    return aA.left <= aB.right && aB.left <= aA.right && aA.top <= aB.bottom
+           && aB.top <= aA.bottom;
+}
+
+
+/// @return true if \a aInner is inside \a aOuter without touching its edges.
+static bool rectStrictlyInside( const Clipper2Lib::Rect64& aInner,
+                                const Clipper2Lib::Rect64& aOuter )
+{
+    return aInner.left > aOuter.left && aInner.right < aOuter.right
+           && aInner.top > aOuter.top && aInner.bottom < aOuter.bottom;
+}
+
+
+/// Rounding along the tile edges leaves vertices at most this far from where the untiled
+/// operation would have them.
+static const int64_t SEAM_TOLERANCE = 2;
+
+
+static double segmentDistanceSqr( const Clipper2Lib::Point64& aPt,
+                                  const Clipper2Lib::Point64& aA, const Clipper2Lib::Point64& aB )
+{
+    double dx = double( aB.x - aA.x );
+    double dy = double( aB.y - aA.y );
+    double px = double( aPt.x - aA.x );
+    double py = double( aPt.y - aA.y );
+    double lengthSqr = dx * dx + dy * dy;
+    double t = lengthSqr > 0.0 ? std::clamp( ( px * dx + py * dy ) / lengthSqr, 0.0, 1.0 ) : 0.0;
+
+    return ( px - t * dx ) * ( px - t * dx ) + ( py - t * dy ) * ( py - t * dy );
+}
+
+
+/**
+ * Remove the vertices the union of overlapping tiles leaves along their common edges, where
+ * the two tiles rounded the same edge differently.  These are steps and spikes of a nanometre
+ * or so, which would make the path touch itself.
+ *
+ * @param aCutsX and \a aCutsY are the sorted coordinates of the edges between tiles.
+ */
+static void removeSeamVertices( Clipper2Lib::Path64& aPath, const std::vector<int64_t>& aCutsX,
+                                const std::vector<int64_t>& aCutsY )
+{
+    auto nearCut =
+            []( int64_t aCoord, const std::vector<int64_t>& aCuts )
+            {
+                auto it = std::lower_bound( aCuts.begin(), aCuts.end(), aCoord - TILE_OVERLAP );
+                return it != aCuts.end() && *it <= aCoord + TILE_OVERLAP;
+            };
+
+    bool removed = true;
+
+    while( removed && aPath.size() > 3 )
+    {
+        Clipper2Lib::Path64 kept;
+
+        removed = false;
+        kept.reserve( aPath.size() );
+
+        for( size_t ii = 0; ii < aPath.size(); ++ii )
+        {
+            const Clipper2Lib::Point64& pt = aPath[ii];
+            const Clipper2Lib::Point64& prev = kept.empty() ? aPath.back() : kept.back();
+            const Clipper2Lib::Point64& next = aPath[( ii + 1 ) % aPath.size()];
+
+            if( aPath.size() - ( ii - kept.size() ) > 3
+                    && ( nearCut( pt.x, aCutsX ) || nearCut( pt.y, aCutsY ) )
+                    && segmentDistanceSqr( pt, prev, next ) <= SEAM_TOLERANCE * SEAM_TOLERANCE )
+            {
+                removed = true;
+                continue;
+            }
+
+            kept.push_back( pt );
+        }
+
+        aPath = std::move( kept );
+    }
+}
+
+
+/**
+ * Put the results of an operation run tile by tile back together.
+ *
+ * Each of \a aResults is the result within the matching tile of \a aTiles, inflated by
+ * TILE_OVERLAP.  Polygons well inside their tile are complete and are kept as they are.  The
+ * others are merged by a union, except for their holes which are well inside the tile: these
+ * are left out of the union and given back to the merged polygon which contains them, so that
+ * the union only has to deal with what lies along the tile edges.
+ *
+ * @param aPolygons receives the polygons, each an outline followed by its holes.
+ * @return false if a hole couldn't be given back to a merged polygon.
+ */
+static bool stitchTiles( const std::vector<Clipper2Lib::Rect64>& aTiles,
+                         const std::vector<Clipper2Lib::PolyTree64>& aResults,
+                         std::vector<Clipper2Lib::Paths64>& aPolygons )
+{
+    using namespace Clipper2Lib;
+
+    Paths64              edgePaths;
+    std::vector<Paths64> innerHoles;    // of each outline sent to the union
+
+    std::function<void( const PolyPath64&, const Rect64& )> addOutline =
+            [&]( const PolyPath64& aOutline, const Rect64& aInner )
+            {
+                if( rectStrictlyInside( GetBounds( aOutline.Polygon() ), aInner ) )
+                {
+                    Paths64& polygon = aPolygons.emplace_back();
+
+                    polygon.push_back( aOutline.Polygon() );
+
+                    for( const std::unique_ptr<PolyPath64>& hole : aOutline )
+                        polygon.push_back( hole->Polygon() );
+                }
+                else
+                {
+                    Paths64& holes = innerHoles.emplace_back();
+
+                    edgePaths.push_back( aOutline.Polygon() );
+
+                    for( const std::unique_ptr<PolyPath64>& hole : aOutline )
+                    {
+                        if( rectStrictlyInside( GetBounds( hole->Polygon() ), aInner ) )
+                            holes.push_back( hole->Polygon() );
+                        else
+                            edgePaths.push_back( hole->Polygon() );
+                    }
+
+                    if( holes.empty() )
+                        innerHoles.pop_back();
+                }
+
+                // Islands within the holes
+                for( const std::unique_ptr<PolyPath64>& hole : aOutline )
+                {
+                    for( const std::unique_ptr<PolyPath64>& island : *hole )
+                        addOutline( *island, aInner );
+                }
+            };
+
+    for( size_t ii = 0; ii < aTiles.size(); ++ii )
+    {
+        Rect64 inner = inflateRect( aTiles[ii], -TILE_OVERLAP );
+
+        for( const std::unique_ptr<PolyPath64>& outline : aResults[ii] )
+            addOutline( *outline, inner );
+    }
+
+    if( edgePaths.empty() )
+        return true;
+
+    Clipper64  clipper;
+    PolyTree64 merged;
+
+    clipper.AddSubject( edgePaths );
+    clipper.Execute( ClipType::Union, FillRule::NonZero, merged );
+
+    std::vector<int64_t> cutsX;
+    std::vector<int64_t> cutsY;
+
+    for( const Rect64& tile : aTiles )
+    {
+        cutsX.push_back( tile.left );
+        cutsY.push_back( tile.top );
+    }
+
+    std::sort( cutsX.begin(), cutsX.end() );
+    cutsX.erase( std::unique( cutsX.begin(), cutsX.end() ), cutsX.end() );
+    std::sort( cutsY.begin(), cutsY.end() );
+    cutsY.erase( std::unique( cutsY.begin(), cutsY.end() ), cutsY.end() );
+
+    // The first tiles' left and top edges are the edges of the extent, not cuts
+    cutsX.erase( cutsX.begin() );
+    cutsY.erase( cutsY.begin() );
+
+    size_t              firstMerged = aPolygons.size();
+    std::vector<Rect64> mergedBounds;
+
+    std::function<void( const PolyPath64& )> addMerged =
+            [&]( const PolyPath64& aOutline )
+            {
+                Paths64& polygon = aPolygons.emplace_back();
+
+                polygon.push_back( aOutline.Polygon() );
+                removeSeamVertices( polygon.back(), cutsX, cutsY );
+                mergedBounds.push_back( GetBounds( polygon.back() ) );
+
+                for( const std::unique_ptr<PolyPath64>& hole : aOutline )
+                {
+                    polygon.push_back( hole->Polygon() );
+                    removeSeamVertices( polygon.back(), cutsX, cutsY );
+                }
+
+                for( const std::unique_ptr<PolyPath64>& hole : aOutline )
+                {
+                    for( const std::unique_ptr<PolyPath64>& island : *hole )
+                        addMerged( *island );
+                }
+            };
+
+    for( const std::unique_ptr<PolyPath64>& outline : merged )
+        addMerged( *outline );
+
+    // The holes left out of an outline all go to the innermost merged outline containing a
+    // point of the first of them.
+    for( Paths64& holes : innerHoles )
+    {
+        int target = -1;
+
+        for( const Point64& pt : holes.front() )
+        {
+            bool   onEdge = false;
+            double targetArea = 0.0;
+
+            target = -1;
+
+            for( size_t ii = 0; ii < mergedBounds.size() && !onEdge; ++ii )
+            {
+                const Rect64& bounds = mergedBounds[ii];
+
+                if( pt.x < bounds.left || pt.x > bounds.right || pt.y < bounds.top
+                    || pt.y > bounds.bottom )
+                {
+                    continue;
+                }
+
+                switch( PointInPolygon( pt, aPolygons[firstMerged + ii].front() ) )
+                {
+                case PointInPolygonResult::IsInside:
+                    if( target < 0 || double( bounds.Width() ) * bounds.Height() < targetArea )
+                    {
+                        target = (int) ii;
+                        targetArea = double( bounds.Width() ) * bounds.Height();
+                    }
+
+                    break;
+
+                case PointInPolygonResult::IsOn:
+                    onEdge = true;
+                    break;
+
+                case PointInPolygonResult::IsOutside:
+                    break;
+                }
+            }
+
+            if( !onEdge )
+                break;
+
+            target = -1;
+        }
+
+        if( target < 0 )
+            return false;
+
+        Paths64& polygon = aPolygons[firstMerged + target];
+
+        polygon.insert( polygon.end(), holes.begin(), holes.end() );
+    }
+
+    return true;
+}
+
+
+bool SHAPE_POLY_SET::tiledBooleanOp( Clipper2Lib::ClipType aType,
+                                     const Clipper2Lib::Paths64& aSubjects,
+                                     const Clipper2Lib::Paths64& aClips,
+                                     const std::vector<CLIPPER_Z_VALUE>& aZValues )
+{
+    using namespace Clipper2Lib;
+
+    int minVertices = s_tiledBooleanMinVertices;
+
+    if( minVertices < 0 )
+        minVertices = ADVANCED_CFG::GetCfg().m_TiledBooleanMinVertices;
+
+    // XOR results are left alone: regions which touch at a point can be joined or split by the
+    // rounding along the tile edges.
+    if( minVertices <= 0 || aType == ClipType::Xor || aSubjects.empty() )
+        return false;
+
+    size_t vertexCount = 0;
+
+    for( const Path64& path : aSubjects )
+        vertexCount += path.size();
+
+    for( const Path64& path : aClips )
+        vertexCount += path.size();
+
+    if( vertexCount < (size_t) minVertices )
+        return false;
+
+    std::vector<Rect64> subjectBounds;
+    std::vector<Rect64> clipBounds;
+
+    subjectBounds.reserve( aSubjects.size() );
+    clipBounds.reserve( aClips.size() );
+
+    for( const Path64& path : aSubjects )
+        subjectBounds.push_back( GetBounds( path ) );
+
+    for( const Path64& path : aClips )
+        clipBounds.push_back( GetBounds( path ) );
+
+    // A difference or an intersection is within the subjects, so the clips don't need to be
+    // cut to the tiles either
+    Rect64 extent = GetBounds( aSubjects );
+
+    if( aType == ClipType::Union && !aClips.empty() )
+    {
+        Rect64 clipExtent = GetBounds( aClips );
+
+        extent.left = std::min( extent.left, clipExtent.left );
+        extent.top = std::min( extent.top, clipExtent.top );
+        extent.right = std::max( extent.right, clipExtent.right );
+        extent.bottom = std::max( extent.bottom, clipExtent.bottom );
+    }
+
+    // The tiles only depend on the inputs, as the rounding along the tile edges would otherwise
+    // make the result depend on the number of threads.  There are still enough of them for a
+    // few per thread, as the work isn't spread evenly over the extent.
+    size_t                  tileCount = std::clamp( vertexCount / TILE_VERTICES, MIN_TILES,
+                                                    MAX_TILES );
+    std::vector<Rect64>     tiles = makeTiles( extent, tileCount );
+    std::vector<PolyTree64> results( tiles.size() );
+
+    runConcurrently( tiles.size(),
+            [&]( size_t aTile )
+            {
+                Rect64 rect = inflateRect( tiles[aTile], TILE_OVERLAP );
+
+                auto inTile =
+                        [&]( const Paths64& aPaths, const std::vector<Rect64>& aBounds )
+                        {
+                            Paths64 selected;
+
+                            for( size_t ii = 0; ii < aPaths.size(); ++ii )
+                            {
+                                if( rectsIntersect( aBounds[ii], rect ) )
+                                    selected.push_back( aPaths[ii] );
+                            }
+
+                            return selected;
+                        };
+
+                Paths64   clips = inTile( aClips, clipBounds );
+                Clipper64 clipper;
+
+                clipper.AddSubject( RectClip( rect, inTile( aSubjects, subjectBounds ) ) );
+                clipper.AddClip( aType == ClipType::Union ? RectClip( rect, clips ) : clips );
+                clipper.Execute( aType, FillRule::NonZero, results[aTile] );
+            } );
+
+    std::vector<Paths64> polygons;
+
+    if( !stitchTiles( tiles, results, polygons ) )
+        return false;
+
+    std::vector<SHAPE_ARC> noArcs;
+
+    m_polys.clear();
+
+    for( const Paths64& polygon : polygons )
+    {
+        POLYGON& poly = m_polys.emplace_back();
+
+        for( const Path64& path : polygon )
+            poly.emplace_back( path, aZValues, noArcs );
+    }
+
+    return true;
+}
+
+
 void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOtherShape )
 {
     booleanOp( aType, *this, aOtherShape );
@@ -886,6 +1395,10 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
         }
     }
 
+    // Arcs would be cut by the tile edges
+    if( arcBuffer.empty() && tiledBooleanOp( aType, paths, clips, zValues ) )
+        return;
+
     c.AddSubject( paths );
     c.AddClip( clips );
 
@@ -2809,23 +3322,32 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
         return 0;
     }
 
-    CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
-
-    SEG::ecoord minDistance = (*iterator).SquaredDistance( aPoint );
+    // Scan the outline and holes in the same order as CIterateSegmentsWithHoles(), keeping the
+    // first of the nearest segments.
+    const POLYGON& polygon = m_polys[aPolygonIndex];
+    SEG::ecoord    minDistance = VECTOR2I::ECOORD_MAX;
+    int            nearestContour = -1;
+    int            nearestSegment = -1;
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    for( size_t ii = 0; ii < polygon.size() && minDistance > 0; ii++ )
     {
-        SEG::ecoord currentDistance = (*iterator).SquaredDistance( aPoint );
+        const SHAPE_LINE_CHAIN&      contour = polygon[ii];
+        const std::vector<VECTOR2I>& pts = contour.CPoints();
+        int                          segment = -1;
+        SEG::ecoord currentDistance = MinSegmentSquaredDistance( aPoint, pts.data(), pts.size(), 0,
+                                                                 contour.SegmentCount(), &segment );
 
         if( currentDistance < minDistance )
         {
-            if( aNearest )
-                *aNearest = (*iterator).NearestPoint( aPoint );
-
+            nearestContour = ii;
+            nearestSegment = segment;
             minDistance = currentDistance;
         }
     }
 
+    if( aNearest && nearestContour >= 0 )
+        *aNearest = polygon[nearestContour].CSegment( nearestSegment ).NearestPoint( aPoint );
+
     return minDistance;
 }
 
@@ -3262,13 +3784,13 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
     auto triangulate =
             []( SHAPE_POLY_SET& polySet, int forOutline,
                 std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>& dest,
-                std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* hintData )
+                const std::unique_ptr<TRIANGULATED_POLYGON>* hintData, size_t hintCount )
             {
                 bool triangulationValid = false;
                 int pass = 0;
                 int index = 0;
 
-                if( hintData && hintData->size() != (unsigned) polySet.OutlineCount() )
+                if( hintData && hintCount != (unsigned) polySet.OutlineCount() )
                     hintData = nullptr;
 
                 while( polySet.OutlineCount() > 0 )
@@ -3283,7 +3805,7 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
                     // first simplify the system before fracturing and removing the holes
                     // This may result in multiple, disjoint polygons.
                     if( !tess.TesselatePolygon( polySet.Polygon( 0 ).front(),
-                                                hintData ? hintData->at( index ).get() : nullptr ) )
+                                                hintData ? hintData[index].get() : nullptr ) )
                     {
                         ++pass;
 
@@ -3319,6 +3841,53 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
                 return triangulationValid;
             };
 
+    auto triangulateCells =
+            [&]( SHAPE_POLY_SET& partitions, int forOutline )
+            {
+                size_t count = partitions.OutlineCount();
+
+                // The hints are only used when they match the cells one to one
+                const std::unique_ptr<TRIANGULATED_POLYGON>* hints = nullptr;
+
+                if( aHintData && aHintData->size() == count )
+                    hints = aHintData->data();
+
+                // Each cell is triangulated into its own buffer
+                std::vector<SHAPE_POLY_SET>                                     cells;
+                std::vector<std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>> results( count );
+                std::vector<char>                                               valid( count );
+
+                cells.reserve( count );
+
+                for( size_t ii = 0; ii < count; ++ii )
+                    cells.emplace_back( partitions.CPolygon( ii ) );
+
+                runConcurrently( count,
+                        [&]( size_t ii )
+                        {
+                            // Pool threads don't share the arena of the caller
+                            GEOMETRY_ARENA arena;
+
+                            valid[ii] = triangulate( cells[ii], forOutline, results[ii],
+                                                     hints ? hints + ii : nullptr, 1 );
+                        } );
+
+                bool triangulationValid = count > 0;
+
+                for( size_t ii = 0; ii < count; ++ii )
+                {
+                    triangulationValid &= valid[ii] != 0;
+
+                    for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : results[ii] )
+                    {
+                        if( tri->GetTriangleCount() > 0 )
+                            m_triangulatedPolys.push_back( std::move( tri ) );
+                    }
+                }
+
+                return triangulationValid;
+            };
+
     m_triangulatedPolys.clear();
 
     if( aPartition )
@@ -3342,7 +3911,7 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
 
             // This pushes the triangulation for all polys in partitions
             // to be referenced to the ii-th polygon
-            if( !triangulate( partitions, ii , m_triangulatedPolys, aHintData ) )
+            if( !triangulateCells( partitions, ii ) )
             {
                 wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
             }
@@ -3363,7 +3932,9 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
 
         tmpSet.Fracture( PM_FAST );
 
-        if( !triangulate( tmpSet, -1, m_triangulatedPolys, aHintData ) )
+        if( !triangulate( tmpSet, -1, m_triangulatedPolys,
+                          aHintData ? aHintData->data() : nullptr,
+                          aHintData ? aHintData->size() : 0 ) )
         {
             wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate polygon" );
         }
@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -50,6 +51,23 @@ namespace IO
     * @return true if the file attribut is set.
     */
     bool IsFileHidden( const wxString& aFileName );
+
+    /**
+     * Map a whole file read-only into memory, hinting for sequential access.
+     *
+     * An empty file is mapped successfully with a null \a aData and zero \a aSize.
+     *
+     * @param aPath is the file to map.
+     * @param aData receives the start of the mapping.
+     * @param aSize receives the length of the file.
+     * @return true if the file could be opened and mapped.
+     */
+    bool MapFile( const wxString& aPath, const char*& aData, size_t& aSize );
+
+    /**
+     * Release a mapping created by MapFile().
+     */
+    void UnmapFile( const char* aData, size_t aSize );
 } // namespace IO
 } // namespace KIPLATFORM
 
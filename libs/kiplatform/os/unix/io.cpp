@@ -24,6 +24,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -66,3 +67,50 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 
     return fn.GetName().StartsWith( wxT( "." ) );
 }
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, const char*& aData, size_t& aSize )
+{
+    aData = nullptr;
+    aSize = 0;
+
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    if( fileStat.st_size > 0 )
+    {
+        void* data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        if( data == MAP_FAILED )
+        {
+            close( fd );
+            return false;
+        }
+
+        madvise( data, fileStat.st_size, MADV_SEQUENTIAL );
+
+        aData = static_cast<const char*>( data );
+        aSize = fileStat.st_size;
+    }
+
+    // The mapping holds its own reference to the file
+    close( fd );
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize )
+{
+    if( aData )
+        munmap( const_cast<char*>( aData ), aSize );
+}
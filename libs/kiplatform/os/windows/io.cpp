@@ -123,4 +123,60 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
         result = true;
 
     return result;
-}
\ No newline at end of file
+}
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, const char*& aData, size_t& aSize )
+{
+    aData = nullptr;
+    aSize = 0;
+
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if( !GetFileSizeEx( hFile, &fileSize ) )
+    {
+        CloseHandle( hFile );
+        return false;
+    }
+
+    if( fileSize.QuadPart > 0 )
+    {
+        HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if( !hMapping )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+        // The view keeps the mapping object (and the file) alive
+        CloseHandle( hMapping );
+
+        if( !data )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        aData = static_cast<const char*>( data );
+        aSize = static_cast<size_t>( fileSize.QuadPart );
+    }
+
+    CloseHandle( hFile );
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize )
+{
+    if( aData )
+        UnmapViewOfFile( aData );
+}
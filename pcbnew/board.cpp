@@ -79,6 +79,7 @@ BOARD::BOARD() :
         m_LegacyNetclassesLoaded( false ),
         m_boardUse( BOARD_USE::NORMAL ),
         m_timeStamp( 1 ),
+        m_netClassTimeStamp( 1 ),
         m_paper( PAGE_INFO::A4 ),
         m_project( nullptr ),
         m_userUnits( EDA_UNITS::MILLIMETRES ),
@@ -974,6 +975,7 @@ void BOARD::FixupEmbeddedData()
                 embeddedFile->decompressedData = file->decompressedData;
                 embeddedFile->data_sha = file->data_sha;
                 embeddedFile->is_valid = file->is_valid;
+                embeddedFile->is_compressed_only = file->is_compressed_only;
             }
         }
     }
@@ -2044,6 +2046,9 @@ void BOARD::SynchronizeNetsAndNetClasses( bool aResetTrackAndViaSizes )
     for( NETINFO_ITEM* net : m_NetInfo )
         net->SetNetClass( bds.m_NetSettings->GetEffectiveNetClass( net->GetNetname() ) );
 
+    // Netclass assignments (and the netclass objects themselves) may have changed
+    m_netClassTimeStamp++;
+
     if( aResetTrackAndViaSizes )
     {
         // Set initial values for custom track width & via size to match the default
@@ -311,6 +311,11 @@ public:
 
     int GetTimeStamp() const { return m_timeStamp; }
 
+    /**
+     * @return a counter which changes whenever the nets' netclass assignments are rebuilt.
+     */
+    int GetNetClassTimeStamp() const { return m_netClassTimeStamp; }
+
     /**
      * Find out if the board is being used to hold a single footprint for editing/viewing.
      *
@@ -1322,6 +1327,7 @@ private:
     /// What is this board being used for
     BOARD_USE           m_boardUse;
     int                 m_timeStamp;                // actually a modification counter
+    int                 m_netClassTimeStamp;        // changes with the netclass assignments
 
     wxString            m_fileName;
 
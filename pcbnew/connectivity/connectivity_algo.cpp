@@ -52,6 +52,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
     case PCB_FOOTPRINT_T:
         for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
         {
+            markConnectedNetsAsDirty( m_itemMap[pad] );
             m_itemMap[pad].MarkItemsAsInvalid();
             m_itemMap.erase( pad );
         }
@@ -65,6 +66,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
     case PCB_VIA_T:
     case PCB_ZONE_T:
     case PCB_SHAPE_T:
+        markConnectedNetsAsDirty( m_itemMap[aItem] );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase ( aItem );
         m_itemList.SetDirty( true );
@@ -101,6 +103,16 @@ void CN_CONNECTIVITY_ALGO::markItemNetAsDirty( const BOARD_ITEM* aItem )
 }
 
 
+void CN_CONNECTIVITY_ALGO::markConnectedNetsAsDirty( const ITEM_MAP_ENTRY& aEntry )
+{
+    for( CN_ITEM* item : aEntry.GetItems() )
+    {
+        for( CN_ITEM* connected : item->ConnectedItems() )
+            MarkNetAsDirty( connected->Net() );
+    }
+}
+
+
 bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 {
     if( !aItem->IsOnCopperLayer() )
@@ -315,7 +327,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 }
 
 
-const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode )
+const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
+                                                                          bool aDirtyNetsOnly )
 {
     static const std::vector<KICAD_T> withoutZones = { PCB_TRACE_T,
                                                        PCB_ARC_T,
@@ -331,13 +344,14 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
                                                     PCB_FOOTPRINT_T,
                                                     PCB_SHAPE_T };
 
-    return SearchClusters( aMode, aMode == CSM_PROPAGATE ? withoutZones : withZones, -1 );
+    return SearchClusters( aMode, aMode == CSM_PROPAGATE ? withoutZones : withZones, -1, nullptr,
+                           aDirtyNetsOnly );
 }
 
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vector<KICAD_T>& aTypes,
-                                      int aSingleNet, CN_ITEM* rootItem )
+                                      int aSingleNet, CN_ITEM* rootItem, bool aDirtyNetsOnly )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
@@ -350,7 +364,8 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vect
         searchConnections();
 
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aTypes, rootItem ]( CN_ITEM *aItem )
+            [&item_set, withinAnyNet, aSingleNet, &aTypes, rootItem, aDirtyNetsOnly,
+             this]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -377,6 +392,11 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vect
 
                 aItem->SetVisited( false );
 
+                // Items on clean nets can still be reached from a dirty one; they just don't
+                // start a cluster of their own
+                if( aDirtyNetsOnly && !IsNetDirty( aItem->Net() ) )
+                    return;
+
                 item_set.insert( aItem );
             };
 
@@ -657,7 +677,7 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 
 void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    m_connClusters = SearchClusters( CSM_PROPAGATE, true );
     propagateConnections( aCommit );
 }
 
@@ -721,7 +741,7 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    m_ratsnestClusters = SearchClusters( CSM_RATSNEST, true );
     return m_ratsnestClusters;
 }
 
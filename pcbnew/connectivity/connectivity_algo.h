@@ -189,7 +189,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -226,12 +226,21 @@ public:
     bool Remove( BOARD_ITEM* aItem );
     bool Add( BOARD_ITEM* aItem );
 
+    /**
+     * Search for clusters of connected items.
+     *
+     * @param aDirtyNetsOnly only search from items on dirty nets.  Clusters are still followed
+     *                       into other nets when \a aMode allows it, but clusters made up only
+     *                       of items on clean nets are skipped.
+     */
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vector<KICAD_T>& aTypes,
-                                   int aSingleNet, CN_ITEM* rootItem = nullptr );
-    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
+                                   int aSingleNet, CN_ITEM* rootItem = nullptr,
+                                   bool aDirtyNetsOnly = false );
+    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aDirtyNetsOnly = false );
 
     /**
-     * Propagate nets from pads to other items in clusters.
+     * Propagate nets from pads to other items in clusters.  Only clusters including an item
+     * on a dirty net are visited; the others were settled by a previous call.
      * @param aCommit is used to store undo information for items modified by the call.
      */
     void PropagateNets( BOARD_COMMIT* aCommit = nullptr );
@@ -242,6 +251,9 @@ public:
     void FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
                                  bool aConnectivityAlreadyRebuilt );
 
+    /**
+     * Return the ratsnest clusters of the dirty nets.
+     */
     const CLUSTERS& GetClusters();
 
     const CN_LIST& ItemList() const
@@ -286,6 +298,12 @@ private:
 
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
+    /**
+     * Mark the nets of the items connected to \a aEntry's items as dirty, as removing it may
+     * split or reshape their clusters.
+     */
+    void markConnectedNetsAsDirty( const ITEM_MAP_ENTRY& aEntry );
+
 private:
     CONNECTIVITY_DATA*                                    m_parentConnectivityData;
     CN_LIST                                               m_itemList;
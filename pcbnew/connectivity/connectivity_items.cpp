@@ -32,6 +32,58 @@
 
 #include <wx/log.h>
 
+
+void* CN_ANCHOR_POOL::Allocate( size_t aSize )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( m_slotSize == 0 )
+    {
+        size_t align = alignof( std::max_align_t );
+        m_slotSize = ( std::max( aSize, sizeof( FREE_SLOT ) ) + align - 1 ) / align * align;
+    }
+
+    // Only one type is ever allocated from the pool; anything else goes to the heap
+    if( aSize > m_slotSize )
+        return ::operator new( aSize );
+
+    if( !m_freeList )
+    {
+        size_t slabSize = m_slotSize * SLAB_SLOTS / sizeof( std::max_align_t );
+        char*  slab = reinterpret_cast<char*>(
+                m_slabs.emplace_back( new std::max_align_t[slabSize] ).get() );
+
+        for( size_t ii = SLAB_SLOTS; ii > 0; --ii )
+        {
+            FREE_SLOT* slot = reinterpret_cast<FREE_SLOT*>( slab + ( ii - 1 ) * m_slotSize );
+            slot->m_next = m_freeList;
+            m_freeList = slot;
+        }
+    }
+
+    FREE_SLOT* slot = m_freeList;
+    m_freeList = slot->m_next;
+
+    return slot;
+}
+
+
+void CN_ANCHOR_POOL::Deallocate( void* aPtr, size_t aSize )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( aSize > m_slotSize )
+    {
+        ::operator delete( aPtr );
+        return;
+    }
+
+    FREE_SLOT* slot = static_cast<FREE_SLOT*>( aPtr );
+    slot->m_next = m_freeList;
+    m_freeList = slot;
+}
+
+
 int CN_ITEM::AnchorCount() const
 {
     if( !m_valid )
@@ -151,7 +203,7 @@ CN_ITEM* CN_LIST::Add( PAD* pad )
          return nullptr;
 
      auto item = new CN_ITEM( pad, false, 1 );
-     item->AddAnchor( pad->ShapePos() );
+     item->AddAnchor( pad->ShapePos(), m_anchorAllocator );
      item->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
 
      switch( pad->GetAttribute() )
@@ -187,8 +239,8 @@ CN_ITEM* CN_LIST::Add( PCB_TRACK* track )
 {
     CN_ITEM* item = new CN_ITEM( track, true );
     m_items.push_back( item );
-    item->AddAnchor( track->GetStart() );
-    item->AddAnchor( track->GetEnd() );
+    item->AddAnchor( track->GetStart(), m_anchorAllocator );
+    item->AddAnchor( track->GetEnd(), m_anchorAllocator );
     item->SetLayer( track->GetLayer() );
     addItemtoTree( item );
     SetDirty();
@@ -200,8 +252,8 @@ CN_ITEM* CN_LIST::Add( PCB_ARC* aArc )
 {
     CN_ITEM* item = new CN_ITEM( aArc, true );
     m_items.push_back( item );
-    item->AddAnchor( aArc->GetStart() );
-    item->AddAnchor( aArc->GetEnd() );
+    item->AddAnchor( aArc->GetStart(), m_anchorAllocator );
+    item->AddAnchor( aArc->GetEnd(), m_anchorAllocator );
     item->SetLayer( aArc->GetLayer() );
     addItemtoTree( item );
     SetDirty();
@@ -214,7 +266,7 @@ CN_ITEM* CN_LIST::Add( PCB_VIA* via )
     CN_ITEM* item = new CN_ITEM( via, !via->GetIsFree(), 1 );
 
     m_items.push_back( item );
-    item->AddAnchor( via->GetStart() );
+    item->AddAnchor( via->GetStart(), m_anchorAllocator );
 
     item->SetLayers( LAYER_RANGE( via->TopLayer(), via->BottomLayer() ) );
     addItemtoTree( item );
@@ -236,7 +288,7 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
         zitem->BuildRTree();
 
         for( const VECTOR2I& pt : zone->GetFilledPolysList( aLayer )->COutline( j ).CPoints() )
-            zitem->AddAnchor( pt );
+            zitem->AddAnchor( pt, m_anchorAllocator );
 
         rv.push_back( Add( zitem ) );
     }
@@ -260,7 +312,7 @@ CN_ITEM* CN_LIST::Add( PCB_SHAPE* shape )
     m_items.push_back( item );
 
     for( const VECTOR2I& point : shape->GetConnectionPoints() )
-        item->AddAnchor( point );
+        item->AddAnchor( point, m_anchorAllocator );
 
     item->SetLayer( shape->GetLayer() );
     addItemtoTree( item );
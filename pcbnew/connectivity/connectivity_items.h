@@ -40,7 +40,9 @@
 
 #include <memory>
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <mutex>
 #include <vector>
 #include <deque>
 
@@ -124,6 +126,88 @@ private:
 };
 
 
+/**
+ * A free-list arena which CN_ANCHORs are allocated from.
+ *
+ * Anchors are shared with the ratsnest and may outlive their items, so they stay reference
+ * counted; but rather than each one being a separate heap allocation they (and their reference
+ * counts) are carved out of contiguous slabs and recycled as they are released.  The pool is
+ * kept alive by the anchors allocated from it.
+ */
+class CN_ANCHOR_POOL
+{
+public:
+    CN_ANCHOR_POOL() :
+            m_slotSize( 0 ),
+            m_freeList( nullptr )
+    { }
+
+    void* Allocate( size_t aSize );
+    void  Deallocate( void* aPtr, size_t aSize );
+
+private:
+    struct FREE_SLOT
+    {
+        FREE_SLOT* m_next;
+    };
+
+    static constexpr size_t SLAB_SLOTS = 256;
+
+    std::mutex                                        m_lock;
+    size_t                                            m_slotSize;   ///< set by first Allocate()
+    FREE_SLOT*                                        m_freeList;
+    std::vector<std::unique_ptr<std::max_align_t[]>>  m_slabs;
+};
+
+
+/**
+ * Standard allocator interface to a CN_ANCHOR_POOL, for use with std::allocate_shared().
+ */
+template <typename T>
+class CN_ANCHOR_ALLOCATOR
+{
+public:
+    using value_type = T;
+
+    CN_ANCHOR_ALLOCATOR( std::shared_ptr<CN_ANCHOR_POOL> aPool ) :
+            m_pool( std::move( aPool ) )
+    { }
+
+    template <typename U>
+    CN_ANCHOR_ALLOCATOR( const CN_ANCHOR_ALLOCATOR<U>& aOther ) :
+            m_pool( aOther.m_pool )
+    { }
+
+    T* allocate( size_t aCount )
+    {
+        return static_cast<T*>( m_pool->Allocate( aCount * sizeof( T ) ) );
+    }
+
+    void deallocate( T* aPtr, size_t aCount )
+    {
+        m_pool->Deallocate( aPtr, aCount * sizeof( T ) );
+    }
+
+    template <typename U>
+    bool operator==( const CN_ANCHOR_ALLOCATOR<U>& aOther ) const
+    {
+        return m_pool == aOther.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=( const CN_ANCHOR_ALLOCATOR<U>& aOther ) const
+    {
+        return m_pool != aOther.m_pool;
+    }
+
+private:
+    template <typename U>
+    friend class CN_ANCHOR_ALLOCATOR;
+
+    std::shared_ptr<CN_ANCHOR_POOL> m_pool;
+};
+
+
 
 /**
  * CN_ITEM represents a BOARD_CONNETED_ITEM in the connectivity system (ie: a pad, track/arc/via,
@@ -152,9 +236,10 @@ public:
             anchor->SetItem( nullptr );
     };
 
-    std::shared_ptr<CN_ANCHOR> AddAnchor( const VECTOR2I& aPos )
+    std::shared_ptr<CN_ANCHOR> AddAnchor( const VECTOR2I& aPos,
+                                          const CN_ANCHOR_ALLOCATOR<CN_ANCHOR>& aAllocator )
     {
-        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
+        m_anchors.emplace_back( std::allocate_shared<CN_ANCHOR>( aAllocator, aPos, this ) );
         return m_anchors.at( m_anchors.size() - 1 );
     }
 
@@ -373,7 +458,8 @@ private:
 class CN_LIST
 {
 public:
-    CN_LIST()
+    CN_LIST() :
+            m_anchorAllocator( std::make_shared<CN_ANCHOR_POOL>() )
     {
         m_dirty = false;
         m_hasInvalid = false;
@@ -441,6 +527,8 @@ private:
     bool                  m_dirty;
     bool                  m_hasInvalid;
     CN_RTREE<CN_ITEM*>    m_index;
+
+    CN_ANCHOR_ALLOCATOR<CN_ANCHOR> m_anchorAllocator;   ///< for the anchors of m_items
 };
 
 
@@ -114,7 +114,8 @@ bool DRC_CACHE_GENERATOR::Run()
                 copperLayers.RunOnLayers(
                         [&]( PCB_LAYER_ID layer )
                         {
-                            m_board->m_CopperItemRTreeCache->Insert( item, layer, largestClearance );
+                            m_board->m_CopperItemRTreeCache->Stage( item, layer, layer,
+                                                                    largestClearance );
                         } );
 
                 done.fetch_add( 1 );
@@ -153,6 +154,20 @@ bool DRC_CACHE_GENERATOR::Run()
         status = retn.wait_for( std::chrono::milliseconds( 250 ) );
     }
 
+    // Pack the per-layer trees from the staged items, one layer per task
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
+        LSEQ                                layers = boardCopperLayers.Seq();
+        DRC_RTREE*                          copperTree = m_board->m_CopperItemRTreeCache.get();
+
+        tp.parallelize_loop( layers.size(),
+                             [&]( size_t aStart, size_t aEnd )
+                             {
+                                 for( size_t ii = aStart; ii < aEnd; ++ii )
+                                     copperTree->BuildLayer( layers[ii] );
+                             } ).wait();
+    }
+
     if( !reportPhase( _( "Tessellating copper zones..." ) ) )
         return false;   // DRC cancelled
 
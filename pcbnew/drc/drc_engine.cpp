@@ -70,13 +70,12 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_drawingSheet( nullptr ),
     m_schematicNetlist( nullptr ),
     m_rulesValid( false ),
+    m_errorLimits( DRCE_LAST + 1 ),
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
     m_reporter( nullptr ),
     m_progressReporter( nullptr )
 {
-    m_errorLimits.resize( DRCE_LAST + 1 );
-
     for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
         m_errorLimits[ ii ] = ERROR_LIMIT;
 }
@@ -619,12 +618,59 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     int timestamp = m_board->GetTimeStamp();
 
+    // Providers which only read the board and the caches are run together on the thread pool
+    // up front.  Their reports are held back and flushed at the point in the sequence where the
+    // provider would otherwise have run, so the output is the same as a serial run.
+    thread_pool&                                    tp = GetKiCadThreadPool();
+    std::map<DRC_TEST_PROVIDER*, std::future<bool>> concurrentResults;
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        if( provider->CanRunConcurrently() )
+        {
+            concurrentResults[ provider ] = tp.submit(
+                    [provider, aUnits]() -> bool
+                    {
+                        return provider->RunTestsDeferred( aUnits );
+                    } );
+        }
+    }
+
+    if( !concurrentResults.empty() )
+    {
+        ReportPhase( _( "Running independent tests..." ) );
+
+        size_t done = 0;
+
+        for( auto& [ provider, result ] : concurrentResults )
+        {
+            while( result.wait_for( std::chrono::milliseconds( 250 ) )
+                        != std::future_status::ready )
+            {
+                ReportProgress( static_cast<double>( done ) / concurrentResults.size() );
+            }
+
+            ++done;
+        }
+    }
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
         ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
 
-        if( !provider->RunTests( aUnits ) )
+        auto it = concurrentResults.find( provider );
+
+        if( it != concurrentResults.end() )
+        {
+            provider->FlushDeferredReports();
+
+            if( !it->second.get() || IsCancelled() )
+                break;
+        }
+        else if( !provider->RunTests( aUnits ) )
+        {
             break;
+        }
     }
 
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
@@ -1573,12 +1619,13 @@ void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const
 {
     static std::mutex globalLock;
 
-    m_errorLimits[ aItem->GetErrorCode() ] -= 1;
-
-    if( m_violationHandler )
     {
         std::lock_guard<std::mutex> guard( globalLock );
-        m_violationHandler( aItem, aPos, aMarkerLayer );
+
+        m_errorLimits[ aItem->GetErrorCode() ] -= 1;
+
+        if( m_violationHandler )
+            m_violationHandler( aItem, aPos, aMarkerLayer );
     }
 
     if( m_reporter )
@@ -24,6 +24,7 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -237,9 +238,10 @@ protected:
     bool                                    m_rulesValid;
     std::vector<DRC_TEST_PROVIDER*>         m_testProviders;
 
-    std::vector<int>           m_errorLimits;
-    bool                       m_reportAllTrackErrors;
-    bool                       m_testFootprints;
+    // Read by parallelForEach() workers while the calling thread reports violations
+    std::vector<std::atomic<int>> m_errorLimits;
+    bool                          m_reportAllTrackErrors;
+    bool                          m_testFootprints;
 
     // constraint -> rule -> provider
     std::map<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> m_constraintMap;
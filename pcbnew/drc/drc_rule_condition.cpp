@@ -22,6 +22,9 @@
  */
 
 
+#include <board.h>
+#include <board_connected_item.h>
+#include <netclass.h>
 #include <board_item.h>
 #include <reporter.h>
 #include <drc/drc_rule_condition.h>
@@ -30,7 +33,8 @@
 
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
-    m_ucode ( nullptr )
+    m_ucode ( nullptr ),
+    m_memoTimeStamp( -1 )
 {
 }
 
@@ -40,12 +44,73 @@ DRC_RULE_CONDITION::~DRC_RULE_CONDITION()
 }
 
 
+DRC_RULE_CONDITION::MEMO_KEY DRC_RULE_CONDITION::makeMemoKey( const BOARD_ITEM* aItemA,
+                                                              const BOARD_ITEM* aItemB )
+{
+    auto netclass =
+            []( const BOARD_ITEM* aItem ) -> wxString
+            {
+                if( auto item = dynamic_cast<const BOARD_CONNECTED_ITEM*>( aItem ) )
+                {
+                    if( const NETCLASS* nc = item->GetEffectiveNetClass() )
+                        return nc->GetVariableSubstitutionName();
+                }
+
+                return wxEmptyString;
+            };
+
+    return { aItemA->Type(), netclass( aItemA ),
+             aItemB ? aItemB->Type() : TYPE_NOT_INIT, netclass( aItemB ) };
+}
+
+
 bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
                                       int aConstraint, PCB_LAYER_ID aLayer, REPORTER* aReporter )
 {
     if( GetExpression().IsEmpty() )
         return true;
 
+    const BOARD* board = aItemA ? aItemA->GetBoard() : nullptr;
+
+    // Conditions which only read the items' types and netclasses give the same answer for
+    // every pair of items sharing those, so cache them.  The cache is dropped when the board's
+    // netclass assignments change.  Reporting is always done on a fresh evaluation.
+    if( aReporter || !board || !m_ucode || !m_ucode->IsMemoizable() )
+        return evaluate( aItemA, aItemB, aConstraint, aLayer, aReporter );
+
+    MEMO_KEY key = makeMemoKey( aItemA, aItemB );
+    int      timeStamp = board->GetNetClassTimeStamp();
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_memoMutex );
+
+        if( m_memoTimeStamp == timeStamp )
+        {
+            auto it = m_memo.find( key );
+
+            if( it != m_memo.end() )
+                return it->second;
+        }
+    }
+
+    bool result = evaluate( aItemA, aItemB, aConstraint, aLayer, nullptr );
+
+    std::unique_lock<std::shared_mutex> writeLock( m_memoMutex );
+
+    if( m_memoTimeStamp != timeStamp )
+    {
+        m_memo.clear();
+        m_memoTimeStamp = timeStamp;
+    }
+
+    m_memo[ key ] = result;
+    return result;
+}
+
+
+bool DRC_RULE_CONDITION::evaluate( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
+                                   int aConstraint, PCB_LAYER_ID aLayer, REPORTER* aReporter )
+{
     if( !m_ucode )
     {
         if( aReporter )
@@ -90,9 +155,11 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
 {
     PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
 
+    std::function<void( const wxString& aMessage, int aOffset )> errorCallback;
+
     if( aReporter )
     {
-        compiler.SetErrorCallback(
+        errorCallback =
                 [&]( const wxString& aMessage, int aOffset )
                 {
                     wxString rest;
@@ -104,7 +171,9 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
                                                      rest );
 
                     aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                } );
+                };
+
+        compiler.SetErrorCallback( errorCallback );
     }
 
     m_ucode = std::make_unique<PCBEXPR_UCODE>();
@@ -112,6 +181,11 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
     bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+
+    // Conditions are evaluated for every item pair, so it's worth folding their constants once
+    if( ok )
+        m_ucode->Optimize( errorCallback );
+
     return ok;
 }
 
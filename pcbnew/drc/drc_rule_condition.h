@@ -26,6 +26,9 @@
 
 #include <core/typeinfo.h>
 #include <layer_ids.h>
+#include <hash.h>
+#include <shared_mutex>
+#include <unordered_map>
 
 class BOARD_ITEM;
 class PCBEXPR_UCODE;
@@ -47,8 +50,47 @@ public:
     wxString GetExpression() const { return m_expression; }
 
 private:
-    wxString                       m_expression;
-    std::unique_ptr<PCBEXPR_UCODE> m_ucode;
+    /**
+     * The inputs a memoizable condition can read: the type and effective netclass of each item.
+     *
+     * Netclasses are keyed by the name conditions read, which lists all the constituents of an
+     * aggregate netclass.  They are recreated by RecomputeEffectiveNetclasses(), so a pointer
+     * could be reused by a different netclass.
+     */
+    struct MEMO_KEY
+    {
+        KICAD_T  TypeA;
+        wxString NetclassA;
+        KICAD_T  TypeB;
+        wxString NetclassB;
+
+        bool operator==( const MEMO_KEY& other ) const
+        {
+            return TypeA == other.TypeA && NetclassA == other.NetclassA
+                    && TypeB == other.TypeB && NetclassB == other.NetclassB;
+        }
+    };
+
+    struct MEMO_KEY_HASH
+    {
+        std::size_t operator()( const MEMO_KEY& k ) const
+        {
+            return hash_val( k.TypeA, k.NetclassA, k.TypeB, k.NetclassB );
+        }
+    };
+
+    static MEMO_KEY makeMemoKey( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB );
+
+    bool evaluate( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB, int aConstraint,
+                   PCB_LAYER_ID aLayer, REPORTER* aReporter );
+
+private:
+    wxString                                          m_expression;
+    std::unique_ptr<PCBEXPR_UCODE>                    m_ucode;
+
+    std::shared_mutex                                 m_memoMutex;
+    std::unordered_map<MEMO_KEY, bool, MEMO_KEY_HASH> m_memo;
+    int                                               m_memoTimeStamp;
 };
 
 
@@ -29,12 +29,19 @@
 #include <pad.h>
 #include <zone.h>
 #include <pcb_text.h>
+#include <core/thread_pool.h>
+
+#include <atomic>
+#include <memory>
 
 
 // A list of all basic (ie: non-compound) board geometry items
 std::vector<KICAD_T> DRC_TEST_PROVIDER::s_allBasicItems;
 std::vector<KICAD_T> DRC_TEST_PROVIDER::s_allBasicItemsButZones;
 
+thread_local std::vector<DRC_TEST_PROVIDER::DEFERRED_REPORT>*
+        DRC_TEST_PROVIDER::s_threadReports = nullptr;
+
 
 DRC_TEST_PROVIDER_REGISTRY::~DRC_TEST_PROVIDER_REGISTRY()
 {
@@ -72,20 +79,155 @@ const wxString DRC_TEST_PROVIDER::GetName() const { return wxT( "<no name test>"
 const wxString DRC_TEST_PROVIDER::GetDescription() const { return wxEmptyString; }
 
 
+bool DRC_TEST_PROVIDER::RunTestsDeferred( EDA_UNITS aUnits )
+{
+    m_deferredReports.clear();
+    m_deferReports = true;
+
+    bool retVal = RunTests( aUnits );
+
+    m_deferReports = false;
+    return retVal;
+}
+
+
+void DRC_TEST_PROVIDER::FlushDeferredReports()
+{
+    for( const DEFERRED_REPORT& report : m_deferredReports )
+        forwardReport( report );
+
+    m_deferredReports.clear();
+}
+
+
+bool DRC_TEST_PROVIDER::forwardReport( const DEFERRED_REPORT& aReport )
+{
+    if( !aReport.item )
+    {
+        logAux( aReport.msg );
+    }
+    else if( !m_drcEngine->IsErrorLimitExceeded( aReport.item->GetErrorCode() ) )
+    {
+        // The limits are not decremented while reports are held back, so apply them here
+        // exactly as they would have been applied had the reports been made in sequence.
+        if( m_deferReports )
+            m_deferredReports.push_back( aReport );
+        else
+            m_drcEngine->ReportViolation( aReport.item, aReport.pos, aReport.layer );
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool DRC_TEST_PROVIDER::parallelForEach( size_t aCount, const std::function<void( size_t )>& aFunc,
+                                         const std::function<bool( size_t )>& aFilter )
+{
+    // A deferred provider is already running on a worker thread; waiting on the pool from
+    // there could starve it.
+    wxCHECK_MSG( !m_deferReports, false, wxT( "Concurrent providers can't use the thread pool" ) );
+
+    thread_pool&                              tp = GetKiCadThreadPool();
+    std::vector<std::vector<DEFERRED_REPORT>> reports( aCount );
+    std::unique_ptr<std::atomic<bool>[]>      finished( new std::atomic<bool>[aCount]() );
+    std::atomic<size_t>                       done( 0 );
+    size_t                                    flushed = 0;
+
+    auto runRange =
+            [&]( size_t aStart, size_t aEnd )
+            {
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    if( !m_drcEngine->IsCancelled() )
+                    {
+                        s_threadReports = &reports[ii];
+                        aFunc( ii );
+                        s_threadReports = nullptr;
+                    }
+
+                    finished[ii].store( true, std::memory_order_release );
+                    done.fetch_add( 1 );
+                }
+            };
+
+    // Hand on the reports of the leading run of finished indices.  This happens while the
+    // workers are still going, so that the error limits they check are kept up to date.
+    auto flush =
+            [&]()
+            {
+                while( flushed < aCount && finished[flushed].load( std::memory_order_acquire ) )
+                {
+                    if( !m_drcEngine->IsCancelled() && ( !aFilter || aFilter( flushed ) ) )
+                    {
+                        for( const DEFERRED_REPORT& report : reports[flushed] )
+                        {
+                            // Only the violations which make it through count towards the
+                            // statistics
+                            if( forwardReport( report ) && report.item
+                                    && report.item->GetViolatingRule() )
+                            {
+                                accountCheck( report.item->GetViolatingRule() );
+                            }
+                        }
+                    }
+
+                    reports[flushed].clear();
+                    reports[flushed].shrink_to_fit();
+                    ++flushed;
+                }
+            };
+
+    BS::multi_future<void> results = tp.parallelize_loop( aCount, runRange );
+
+    for( size_t ii = 0; ii < results.size(); ++ii )
+    {
+        while( results[ii].wait_for( std::chrono::milliseconds( 250 ) )
+                    != std::future_status::ready )
+        {
+            flush();
+            reportProgress( done, aCount );
+        }
+    }
+
+    flush();
+
+    return !m_drcEngine->IsCancelled();
+}
+
+
 void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item,
                                          const VECTOR2I& aMarkerPos, int aMarkerLayer )
 {
+    item->SetViolatingTest( this );
+
+    // Reports from parallelForEach() are accounted for when they are handed on
+    if( s_threadReports )
+    {
+        s_threadReports->push_back( { item, aMarkerPos, aMarkerLayer, wxEmptyString } );
+        return;
+    }
+
     std::lock_guard<std::mutex> lock( m_statsMutex );
+
     if( item->GetViolatingRule() )
         accountCheck( item->GetViolatingRule() );
 
-    item->SetViolatingTest( this );
-    m_drcEngine->ReportViolation( item, aMarkerPos, aMarkerLayer );
+    if( m_deferReports )
+        m_deferredReports.push_back( { item, aMarkerPos, aMarkerLayer, wxEmptyString } );
+    else
+        m_drcEngine->ReportViolation( item, aMarkerPos, aMarkerLayer );
 }
 
 
 bool DRC_TEST_PROVIDER::reportProgress( size_t aCount, size_t aSize, size_t aDelta )
 {
+    if( m_deferReports )
+        return !m_drcEngine->IsCancelled();
+
     if( ( aCount % aDelta ) == 0 || aCount == aSize -  1 )
     {
         if( !m_drcEngine->ReportProgress( static_cast<double>( aCount ) / aSize ) )
@@ -99,6 +241,10 @@ bool DRC_TEST_PROVIDER::reportProgress( size_t aCount, size_t aSize, size_t aDel
 bool DRC_TEST_PROVIDER::reportPhase( const wxString& aMessage )
 {
     reportAux( aMessage );
+
+    if( m_deferReports )
+        return !m_drcEngine->IsCancelled();
+
     return m_drcEngine->ReportPhase( aMessage );
 }
 
@@ -110,7 +256,25 @@ void DRC_TEST_PROVIDER::reportAux( const wxChar* fmt, ... )
     wxString str;
     str.PrintfV( fmt, vargs );
     va_end( vargs );
-    m_drcEngine->ReportAux( str );
+    logAux( str );
+}
+
+
+void DRC_TEST_PROVIDER::logAux( const wxString& aMsg )
+{
+    if( s_threadReports )
+    {
+        s_threadReports->push_back( { nullptr, VECTOR2I(), UNDEFINED_LAYER, aMsg } );
+    }
+    else if( m_deferReports )
+    {
+        std::lock_guard<std::mutex> lock( m_statsMutex );
+        m_deferredReports.push_back( { nullptr, VECTOR2I(), UNDEFINED_LAYER, aMsg } );
+    }
+    else
+    {
+        m_drcEngine->ReportAux( aMsg );
+    }
 }
 
 
@@ -136,15 +300,15 @@ void DRC_TEST_PROVIDER::reportRuleStatistics()
     if( !m_isRuleDriven )
         return;
 
-    m_drcEngine->ReportAux( wxT( "Rule hit statistics: " ) );
+    logAux( wxT( "Rule hit statistics: " ) );
 
     for( const std::pair<const DRC_RULE* const, int>& stat : m_stats )
     {
         if( stat.first )
         {
-            m_drcEngine->ReportAux( wxString::Format( wxT( " - rule '%s': %d hits " ),
-                                                      stat.first->m_Name,
-                                                      stat.second ) );
+            logAux( wxString::Format( wxT( " - rule '%s': %d hits " ),
+                                      stat.first->m_Name,
+                                      stat.second ) );
         }
     }
 }
@@ -91,6 +91,26 @@ public:
         return Run();
     }
 
+    /**
+     * Run the tests with all violations and log messages held back until
+     * flushDeferredReports() is called.  The progress reporter is not touched, so this may be
+     * called from a worker thread.
+     */
+    bool RunTestsDeferred( EDA_UNITS aUnits );
+
+    /**
+     * Hand any reports held back by RunTestsDeferred() to the DRC engine, in the order they
+     * were generated.  Must be called from the main thread.
+     */
+    void FlushDeferredReports();
+
+    /**
+     * Return true if this provider only reads the board and the DRC caches, and does not
+     * submit work of its own to the thread pool.  Such providers may be run alongside one
+     * another on the thread pool.
+     */
+    virtual bool CanRunConcurrently() const { return false; }
+
     /**
      * Run this provider against the given PCB with configured options (if any).
      */
@@ -117,6 +137,21 @@ protected:
     virtual void accountCheck( const DRC_RULE* ruleToTest );
     virtual void accountCheck( const DRC_CONSTRAINT& constraintToTest );
 
+    /**
+     * Call \a aFunc for each index in [0, aCount) on the thread pool.
+     *
+     * Violations and log messages reported from within \a aFunc are held back per index and
+     * handed on from the calling thread in index order, as soon as all the earlier indices are
+     * done, so the results don't depend on thread scheduling.  Error limits and rule statistics
+     * are applied as they are handed on; \a aFunc should check IsErrorLimitExceeded() to stop
+     * early.  \a aFilter, if given, is called in index order on the calling thread before an
+     * index's reports are handed on; returning false drops them.
+     *
+     * @return false if the DRC was cancelled.
+     */
+    bool parallelForEach( size_t aCount, const std::function<void( size_t )>& aFunc,
+                          const std::function<bool( size_t )>& aFilter = nullptr );
+
     bool isInvisibleText( const BOARD_ITEM* aItem ) const;
 
     wxString formatMsg( const wxString& aFormatString, const wxString& aSource, double aConstraint,
@@ -128,11 +163,30 @@ protected:
 
     EDA_UNITS   userUnits() const;
 
+private:
+    struct DEFERRED_REPORT
+    {
+        std::shared_ptr<DRC_ITEM> item;     // nullptr for log messages
+        VECTOR2I                  pos;
+        int                       layer;
+        wxString                  msg;
+    };
+
+    void logAux( const wxString& aMsg );
+    bool forwardReport( const DEFERRED_REPORT& aReport );
+
 protected:
     DRC_ENGINE* m_drcEngine;
     std::unordered_map<const DRC_RULE*, int> m_stats;
     bool        m_isRuleDriven = true;
     std::mutex  m_statsMutex;
+
+private:
+    bool                         m_deferReports = false;
+    std::vector<DEFERRED_REPORT> m_deferredReports;
+
+    // Set on a worker thread while it runs a parallelForEach() index
+    static thread_local std::vector<DEFERRED_REPORT>* s_threadReports;
 };
 
 #endif // DRC_TEST_PROVIDER__H
@@ -25,6 +25,7 @@
 #include <atomic>
 #include <deque>
 #include <optional>
+#include <set>
 #include <utility>
 
 #include <wx/debug.h>
@@ -38,6 +39,7 @@
 #include <drc/drc_rtree.h>
 #include <drc/drc_rule_condition.h>
 #include <footprint.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/vertex_set.h>
@@ -117,7 +119,8 @@ class POLYGON_TEST : public VERTEX_SET
 public:
     POLYGON_TEST( int aLimit ) :
         VERTEX_SET( 0 ),
-        m_limit( aLimit )
+        m_limit( aLimit ),
+        m_hits( m_vertices.get_allocator().resource() )
     {
     };
 
@@ -132,7 +135,7 @@ public:
         m_vertices.front().updateList();
 
         VERTEX* p = m_vertices.front().next;
-        std::set<VERTEX*> all_hits;
+        std::pmr::set<VERTEX*> all_hits( m_vertices.get_allocator().resource() );
 
         while( p != &m_vertices.front() )
         {
@@ -158,7 +161,7 @@ public:
         return !m_hits.empty();
     }
 
-    std::set<std::pair<int, int>>& GetVertices()
+    std::pmr::set<std::pair<int, int>>& GetVertices()
     {
         return m_hits;
     }
@@ -298,8 +301,8 @@ public:
     }
 
 private:
-    int                             m_limit;
-    std::set<std::pair<int, int>>   m_hits;
+    int                                m_limit;
+    std::pmr::set<std::pair<int, int>> m_hits;
 };
 
 
@@ -396,7 +399,9 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
                 if( m_drcEngine->IsCancelled() )
                     return 0;
 
-                POLYGON_TEST test( aMinWidth );
+                // The vertices and hits of the test are freed at once when we're done
+                GEOMETRY_ARENA arena;
+                POLYGON_TEST   test( aMinWidth );
 
                 for( int ii = 0; ii < aItemsPoly.Poly.OutlineCount(); ++ii )
                 {
@@ -267,31 +267,27 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
     /*
      * Test copper and silk items against the set of edges.
      */
-    const int progressDelta = 200;
-    int       count = 0;
-    int       ii = 0;
+    std::vector<BOARD_ITEM*> items;
 
     forEachGeometryItem( s_allBasicItemsButZones, LSET::AllLayersMask(),
             [&]( BOARD_ITEM *item ) -> bool
             {
-                count++;
+                items.push_back( item );
                 return true;
             } );
 
-    forEachGeometryItem( s_allBasicItemsButZones, LSET::AllLayersMask(),
-            [&]( BOARD_ITEM *item ) -> bool
+    auto testItem =
+            [&]( size_t aIdx )
             {
+                BOARD_ITEM* item = items[aIdx];
                 bool testCopper = !m_drcEngine->IsErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
                 bool testSilk = !m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
 
                 if( !testCopper && !testSilk )
-                    return false;       // All limits exceeded; we're done
-
-                if( !reportProgress( ii++, count, progressDelta ) )
-                    return false;       // DRC cancelled; we're done
+                    return;             // All limits exceeded
 
                 if( isInvisibleText( item ) )
-                    return true;        // Continue with other items
+                    return;
 
                 if( item->Type() == PCB_PAD_T )
                 {
@@ -300,7 +296,7 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                     if( pad->GetProperty() == PAD_PROP::CASTELLATED
                         || pad->GetAttribute() == PAD_ATTRIB::CONN )
                     {
-                        return true;    // Continue with other items
+                        return;
                     }
                 }
 
@@ -339,9 +335,10 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                         }
                     }
                 }
+            };
 
-                return true;
-            } );
+    if( !parallelForEach( items.size(), testItem ) )
+        return false;   // DRC cancelled
 
     reportRuleStatistics();
 
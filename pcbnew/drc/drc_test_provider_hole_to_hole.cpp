@@ -67,6 +67,11 @@ public:
         return wxT( "Tests hole to hole spacing" );
     }
 
+    virtual bool CanRunConcurrently() const override
+    {
+        return true;
+    }
+
 private:
     bool testHoleAgainstHole( BOARD_ITEM* aItem, SHAPE_CIRCLE* aHole, BOARD_ITEM* aOther );
 
@@ -76,6 +76,9 @@ private:
 
     void testItemAgainstZones( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer );
 
+    void testShape( PCB_SHAPE* aShape, PCB_LAYER_ID aLayer, int aMaxError,
+                    DRC_CONSTRAINT& aConstraint );
+
     void testShapeLineChain( const SHAPE_LINE_CHAIN& aOutline, int aLineWidth, PCB_LAYER_ID aLayer,
                              BOARD_ITEM* aParentItem, DRC_CONSTRAINT& aConstraint );
 
@@ -120,16 +123,22 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
     static const LSET courtyards( { F_CrtYd, B_CrtYd } );
 
     //
-    // Generate a count for use in progress reporting.
+    // Gather the items, and generate a count for use in progress reporting.
     //
 
+    std::vector<BOARD_ITEM*>                items;
+    std::unordered_map<BOARD_ITEM*, size_t> itemIndex;
+
     forEachGeometryItem( itemTypes, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
-                ++count;
+                itemIndex[ item ] = items.size();
+                items.push_back( item );
                 return true;
             } );
 
+    count = items.size();
+
     //
     // Generate a BOARD_ITEM RTree.
     //
@@ -169,98 +178,131 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
                 return true;
             } );
 
-    std::unordered_map<PTR_PTR_CACHE_KEY, LSET> checkedPairs;
-    progressDelta = 100;
-    ii = 0;
+    auto queryLayers =
+            []( BOARD_ITEM* aItem ) -> LSET
+            {
+                if( aItem->Type() == PCB_FOOTPRINT_T )
+                    return courtyards;
+
+                return aItem->GetLayerSet();
+            };
 
     //
     // Run clearance checks -between- items.
     //
+    // Items are tested on the thread pool.  So that each pair is tested once regardless of
+    // scheduling, a pair is tested by whichever of its two items comes first in item order, on
+    // the layers that item queries.  Holes and board edges are in the tree on more layers than
+    // their items query, so the later item may still find the pair on other layers; those are
+    // tested in a second pass, once the first has reported what it found, and only if it found
+    // nothing.
+    //
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
-    {
-        if( !reportPhase( _( "Checking physical clearances..." ) ) )
-            return false;   // DRC cancelled
+    // The items each item reported a violation against, written only by that item's task
+    std::vector<std::unordered_set<BOARD_ITEM*>> reported( items.size() );
 
-        forEachGeometryItem( itemTypes, LSET::AllLayersMask(),
-                [&]( BOARD_ITEM* item ) -> bool
+    auto testItem =
+            [&]( size_t aIdx )
+            {
+                BOARD_ITEM*                           item = items[aIdx];
+                std::unordered_map<BOARD_ITEM*, LSET> checked;
+
+                for( PCB_LAYER_ID layer : queryLayers( item ).Seq() )
                 {
-                    if( !reportProgress( ii++, count, progressDelta ) )
-                        return false;
+                    std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
 
-                    LSET layers = item->GetLayerSet();
+                    m_itemTree.QueryColliding( item, layer, layer,
+                            // Filter:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                auto it = itemIndex.find( other );
 
-                    if( item->Type() == PCB_FOOTPRINT_T )
-                        layers = courtyards;
+                                if( it != itemIndex.end() && it->second < aIdx )
+                                    return false;
 
-                    for( PCB_LAYER_ID layer : layers.Seq() )
-                    {
-                        std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
+                                if( checked[ other ].test( layer ) )
+                                    return false;
 
-                        m_itemTree.QueryColliding( item, layer, layer,
-                                // Filter:
-                                [&]( BOARD_ITEM* other ) -> bool
+                                checked[ other ].set( layer );
+                                return true;
+                            },
+                            // Visitor:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                // Once we record one DRC for error for physical clearance we
+                                // don't need to record more
+                                if( testItemAgainstItem( item, itemShape.get(), layer, other ) > 0 )
                                 {
-                                    BOARD_ITEM* a = item;
-                                    BOARD_ITEM* b = other;
-
-                                    // store canonical order so we don't collide in both
-                                    // directions (a:b and b:a)
-                                    if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                                        std::swap( a, b );
-
-                                    auto it = checkedPairs.find( { a, b } );
-
-                                    if( it != checkedPairs.end() && it->second.test( layer ) )
-                                    {
-                                        return false;
-                                    }
-                                    else
-                                    {
-                                        checkedPairs[ { a, b } ].set( layer );
-                                        return true;
-                                    }
-                                },
-                                // Visitor:
-                                [&]( BOARD_ITEM* other ) -> bool
+                                    checked[ other ].set();
+                                    reported[ aIdx ].insert( other );
+                                }
+
+                                return !m_drcEngine->IsCancelled();
+                            },
+                            m_board->m_DRCMaxPhysicalClearance );
+
+                    testItemAgainstZones( item, layer );
+                }
+            };
+
+    auto testItemOnOtherLayers =
+            [&]( size_t aIdx )
+            {
+                BOARD_ITEM*                     item = items[aIdx];
+                std::unordered_set<BOARD_ITEM*> done;
+
+                for( PCB_LAYER_ID layer : queryLayers( item ).Seq() )
+                {
+                    std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
+
+                    m_itemTree.QueryColliding( item, layer, layer,
+                            // Filter:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                auto it = itemIndex.find( other );
+
+                                // Only the pairs left over by the first pass
+                                if( it == itemIndex.end() || it->second > aIdx
+                                        || queryLayers( other ).Contains( layer ) )
                                 {
-                                    if( testItemAgainstItem( item, itemShape.get(), layer,
-                                                                other ) > 0 )
-                                    {
-                                        BOARD_ITEM* a = item;
-                                        BOARD_ITEM* b = other;
-
-                                        // store canonical order
-                                        if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                                            std::swap( a, b );
-
-                                        // Once we record one DRC for error for physical clearance
-                                        // we don't need to record more
-                                        checkedPairs[ { a, b } ].set();
-                                    }
-
-                                    return !m_drcEngine->IsCancelled();
-                                },
-                                m_board->m_DRCMaxPhysicalClearance );
-
-                        testItemAgainstZones( item, layer );
-                    }
+                                    return false;
+                                }
 
-                    return true;
-                } );
-    }
+                                return !done.count( other )
+                                        && !reported[ it->second ].count( item );
+                            },
+                            // Visitor:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                if( testItemAgainstItem( item, itemShape.get(), layer, other ) > 0 )
+                                    done.insert( other );
 
-    progressDelta = 100;
-    count = 0;
-    ii = 0;
+                                return !m_drcEngine->IsCancelled();
+                            },
+                            m_board->m_DRCMaxPhysicalClearance );
+                }
+            };
+
+    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE )
+            || !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
+    {
+        if( !reportPhase( _( "Checking physical clearances..." ) ) )
+            return false;   // DRC cancelled
+
+        if( !parallelForEach( items.size(), testItem ) )
+            return false;   // DRC cancelled
+
+        if( !parallelForEach( items.size(), testItemOnOtherLayers ) )
+            return false;   // DRC cancelled
+    }
 
     //
-    // Generate a count for progress reporting.
+    // Run clearance checks -within- polygonal items.
     //
 
-    forEachGeometryItem( { PCB_ZONE_T, PCB_SHAPE_T },
-            LSET::AllCuMask(),
+    std::vector<BOARD_ITEM*> polyItems;
+
+    forEachGeometryItem( { PCB_ZONE_T, PCB_SHAPE_T }, LSET::AllCuMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
                 ZONE* zone = dynamic_cast<ZONE*>( item );
@@ -268,124 +310,119 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
                 if( zone && zone->GetIsRuleArea() )
                     return true;    // Continue with other items
 
-                count += ( item->GetLayerSet() & LSET::AllCuMask() ).count();
-
+                polyItems.push_back( item );
                 return true;
             } );
 
-    //
-    // Run clearance checks -within- polygonal items.
-    //
-
-    forEachGeometryItem( { PCB_ZONE_T, PCB_SHAPE_T },
-            LSET::AllCuMask(),
-            [&]( BOARD_ITEM* item ) -> bool
+    auto testPolyItem =
+            [&]( size_t aIdx )
             {
-                PCB_SHAPE* shape = dynamic_cast<PCB_SHAPE*>( item );
-                ZONE*      zone = dynamic_cast<ZONE*>( item );
-
-                if( zone && zone->GetIsRuleArea() )
-                    return true;    // Continue with other items
+                BOARD_ITEM* item = polyItems[aIdx];
+                PCB_SHAPE*  shape = dynamic_cast<PCB_SHAPE*>( item );
+                ZONE*       zone = dynamic_cast<ZONE*>( item );
 
                 for( PCB_LAYER_ID layer : item->GetLayerSet().Seq() )
                 {
                     if( IsCopperLayer( layer ) )
                     {
-                        if( !reportProgress( ii++, count, progressDelta ) )
-                            return false;
-
                         DRC_CONSTRAINT c = m_drcEngine->EvalRules( PHYSICAL_CLEARANCE_CONSTRAINT,
                                                                    item, nullptr, layer );
 
                         if( shape )
-                        {
-                            switch( shape->GetShape() )
-                            {
-                            case SHAPE_T::POLY:
-                                testShapeLineChain( shape->GetPolyShape().Outline( 0 ),
-                                                    shape->GetWidth(), layer, item, c );
-                                break;
+                            testShape( shape, layer, errorMax, c );
 
-                            case SHAPE_T::BEZIER:
-                            {
-                                SHAPE_LINE_CHAIN asPoly;
+                        if( zone )
+                            testZoneLayer( zone, layer, c );
+                    }
 
-                                shape->RebuildBezierToSegmentsPointsList( ARC_HIGH_DEF );
+                    if( m_drcEngine->IsCancelled() )
+                        return;
+                }
+            };
 
-                                for( const VECTOR2I& pt : shape->GetBezierPoints() )
-                                    asPoly.Append( pt );
+    if( !parallelForEach( polyItems.size(), testPolyItem ) )
+        return false;   // DRC cancelled
 
-                                testShapeLineChain( asPoly, shape->GetWidth(), layer, item, c );
-                                break;
-                            }
+    reportRuleStatistics();
 
-                            case SHAPE_T::ARC:
-                            {
-                                SHAPE_LINE_CHAIN asPoly;
+    return !m_drcEngine->IsCancelled();
+}
 
-                                VECTOR2I  center = shape->GetCenter();
-                                EDA_ANGLE angle  = -shape->GetArcAngle();
-                                double    r      = shape->GetRadius();
-                                int       steps  = GetArcToSegmentCount( r, errorMax, angle );
 
-                                asPoly.Append( shape->GetStart() );
+void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testShape( PCB_SHAPE* aShape, PCB_LAYER_ID aLayer,
+                                                      int aMaxError, DRC_CONSTRAINT& aConstraint )
+{
+    switch( aShape->GetShape() )
+    {
+    case SHAPE_T::POLY:
+        testShapeLineChain( aShape->GetPolyShape().Outline( 0 ), aShape->GetWidth(), aLayer,
+                            aShape, aConstraint );
+        break;
 
-                                for( int step = 1; step <= steps; ++step )
-                                {
-                                    EDA_ANGLE rotation = ( angle * step ) / steps;
-                                    VECTOR2I  pt = shape->GetStart();
+    case SHAPE_T::BEZIER:
+    {
+        SHAPE_LINE_CHAIN asPoly;
 
-                                    RotatePoint( pt, center, rotation );
-                                    asPoly.Append( pt );
-                                }
+        aShape->RebuildBezierToSegmentsPointsList( ARC_HIGH_DEF );
 
-                                testShapeLineChain( asPoly, shape->GetWidth(), layer, item, c );
-                                break;
-                            }
+        for( const VECTOR2I& pt : aShape->GetBezierPoints() )
+            asPoly.Append( pt );
 
-                            case SHAPE_T::RECTANGLE:
-                            {
-                                SHAPE_LINE_CHAIN asPoly;
-                                std::vector<VECTOR2I> pts = shape->GetRectCorners();
-                                asPoly.Append( pts[0] );
-                                asPoly.Append( pts[1] );
-                                asPoly.Append( pts[2] );
-                                asPoly.Append( pts[3] );
-                                asPoly.SetClosed( true );
-
-                                testShapeLineChain( asPoly, shape->GetWidth(), layer, item, c );
-                                break;
-                            }
-
-                            case SHAPE_T::SEGMENT:
-                            {
-                                SHAPE_LINE_CHAIN asPoly;
-                                asPoly.Append( shape->GetStart() );
-                                asPoly.Append( shape->GetEnd() );
+        testShapeLineChain( asPoly, aShape->GetWidth(), aLayer, aShape, aConstraint );
+        break;
+    }
 
-                                testShapeLineChain( asPoly, shape->GetWidth(), layer, item, c );
-                                break;
-                            }
+    case SHAPE_T::ARC:
+    {
+        SHAPE_LINE_CHAIN asPoly;
 
-                            default:
-                                UNIMPLEMENTED_FOR( shape->SHAPE_T_asString() );
-                            }
-                        }
+        VECTOR2I  center = aShape->GetCenter();
+        EDA_ANGLE angle  = -aShape->GetArcAngle();
+        double    r      = aShape->GetRadius();
+        int       steps  = GetArcToSegmentCount( r, aMaxError, angle );
 
-                        if( zone )
-                            testZoneLayer( static_cast<ZONE*>( item ), layer, c );
-                    }
+        asPoly.Append( aShape->GetStart() );
 
-                    if( m_drcEngine->IsCancelled() )
-                        return false;
-                }
+        for( int step = 1; step <= steps; ++step )
+        {
+            EDA_ANGLE rotation = ( angle * step ) / steps;
+            VECTOR2I  pt = aShape->GetStart();
 
-                return !m_drcEngine->IsCancelled();
-            } );
+            RotatePoint( pt, center, rotation );
+            asPoly.Append( pt );
+        }
 
-    reportRuleStatistics();
+        testShapeLineChain( asPoly, aShape->GetWidth(), aLayer, aShape, aConstraint );
+        break;
+    }
 
-    return !m_drcEngine->IsCancelled();
+    case SHAPE_T::RECTANGLE:
+    {
+        SHAPE_LINE_CHAIN asPoly;
+        std::vector<VECTOR2I> pts = aShape->GetRectCorners();
+        asPoly.Append( pts[0] );
+        asPoly.Append( pts[1] );
+        asPoly.Append( pts[2] );
+        asPoly.Append( pts[3] );
+        asPoly.SetClosed( true );
+
+        testShapeLineChain( asPoly, aShape->GetWidth(), aLayer, aShape, aConstraint );
+        break;
+    }
+
+    case SHAPE_T::SEGMENT:
+    {
+        SHAPE_LINE_CHAIN asPoly;
+        asPoly.Append( aShape->GetStart() );
+        asPoly.Append( aShape->GetEnd() );
+
+        testShapeLineChain( asPoly, aShape->GetWidth(), aLayer, aShape, aConstraint );
+        break;
+    }
+
+    default:
+        UNIMPLEMENTED_FOR( aShape->SHAPE_T_asString() );
+    }
 }
 
 
@@ -770,13 +807,19 @@ void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aIt
         if( !testClearance && !testHoles )
             return;
 
-        DRC_RTREE*     zoneTree = m_board->m_CopperZoneRTreeCache[ zone ].get();
+        DRC_RTREE*     zoneTree = nullptr;
         DRC_CONSTRAINT constraint;
         bool           colliding;
         int            clearance = -1;
         int            actual;
         VECTOR2I       pos;
 
+        // Items are tested concurrently, so don't let operator[] insert into the cache
+        auto it = m_board->m_CopperZoneRTreeCache.find( zone );
+
+        if( it != m_board->m_CopperZoneRTreeCache.end() )
+            zoneTree = it->second.get();
+
         if( testClearance )
         {
             constraint = m_drcEngine->EvalRules( PHYSICAL_CLEARANCE_CONSTRAINT, aItem, zone,
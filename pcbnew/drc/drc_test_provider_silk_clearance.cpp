@@ -173,24 +173,54 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
         DRC_RTREE::LAYER_PAIR( B_SilkS, Margin )
     };
 
-    targetTree.QueryCollidingPairs( &silkTree, layerPairs,
-            [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItemShape,
-                 DRC_RTREE::ITEM_WITH_SHAPE* aTestItemShape, bool* aCollisionDetected ) -> bool
+    std::vector<DRC_RTREE::PAIR_INFO> pairs = targetTree.GetCandidatePairs( &silkTree, layerPairs,
+                                                                            m_largestClearance );
+
+    // The pairs are tested concurrently in runs of consecutive pairs.  Within a run, pairs of
+    // two items which already collided (eg: other parts of a compound shape) are skipped, as
+    // they would be in a serial walk.  Runs are merged in order on the calling thread, which
+    // drops the collisions already found by an earlier run and reports the others.
+    struct FOUND_COLLISION
+    {
+        std::shared_ptr<DRC_ITEM> item;
+        VECTOR2I                  pos;
+        PCB_LAYER_ID              layer;
+    };
+
+    const size_t                 runSize = 256;
+    size_t                       runCount = ( pairs.size() + runSize - 1 ) / runSize;
+    std::vector<FOUND_COLLISION> found( pairs.size() );
+
+    std::unordered_map<PTR_PTR_CACHE_KEY, int> collidingCompounds;
+
+    auto canonicalKey =
+            []( const DRC_RTREE::PAIR_INFO& aPair ) -> PTR_PTR_CACHE_KEY
             {
-                BOARD_ITEM*  refItem = aRefItemShape->parent;
-                const SHAPE* refShape = aRefItemShape->shape;
-                BOARD_ITEM*  testItem = aTestItemShape->parent;
-                const SHAPE* testShape = aTestItemShape->shape;
+                BOARD_ITEM* a = aPair.refItem->parent;
+                BOARD_ITEM* b = aPair.testItem->parent;
 
-                std::shared_ptr<SHAPE> hole;
+                // store canonical order so we don't collide in both directions (a:b and b:a)
+                if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                    std::swap( a, b );
 
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
-                    return false;
+                return { a, b };
+            };
+
+    auto testPair =
+            [&]( size_t aIdx ) -> bool
+            {
+                const DRC_RTREE::LAYER_PAIR& layers = pairs[aIdx].layerPair;
+                BOARD_ITEM*  refItem = pairs[aIdx].refItem->parent;
+                const SHAPE* refShape = pairs[aIdx].refItem->shape;
+                BOARD_ITEM*  testItem = pairs[aIdx].testItem->parent;
+                const SHAPE* testShape = pairs[aIdx].testItem->shape;
+
+                std::shared_ptr<SHAPE> hole;
 
                 if( isInvisibleText( refItem ) || isInvisibleText( testItem ) )
-                    return true;
+                    return false;
 
-                if( testItem->IsTented( aLayers.first ) )
+                if( testItem->IsTented( layers.first ) )
                 {
                     if( testItem->HasHole() )
                     {
@@ -199,21 +229,21 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                     }
                     else
                     {
-                        return true;
+                        return false;
                     }
                 }
 
                 DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( SILK_CLEARANCE_CONSTRAINT,
                                                                     refItem, testItem,
-                                                                    aLayers.second );
+                                                                    layers.second );
 
                 if( constraint.IsNull() || constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
-                    return true;
+                    return false;
 
                 int minClearance = constraint.GetValue().Min();
 
                 if( minClearance < 0 )
-                    return true;
+                    return false;
 
                 int      actual;
                 VECTOR2I pos;
@@ -223,7 +253,7 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                 if( refItem->Type() == PCB_SHAPE_T && testItem->Type() == PCB_SHAPE_T
                          && refItem->GetParentFootprint() == testItem->GetParentFootprint() )
                 {
-                    return true;
+                    return false;
                 }
 
                 if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
@@ -243,18 +273,63 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                     drcItem->SetItems( refItem, testItem );
                     drcItem->SetViolatingRule( constraint.GetParentRule() );
 
-                    reportViolation( drcItem, pos, aLayers.second );
+                    found[aIdx] = { drcItem, pos, layers.second };
+                    return true;
+                }
 
-                    *aCollisionDetected = true;
+                return false;
+            };
+
+    auto testRun =
+            [&]( size_t aRun )
+            {
+                std::unordered_set<PTR_PTR_CACHE_KEY> checked;
+                size_t                                end = std::min( pairs.size(),
+                                                                      ( aRun + 1 ) * runSize );
+
+                for( size_t ii = aRun * runSize; ii < end; ++ii )
+                {
+                    if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+                        break;
+
+                    PTR_PTR_CACHE_KEY key = canonicalKey( pairs[ii] );
+
+                    // don't report multiple collisions for compound or triangulated shapes
+                    if( checked.count( key ) )
+                        continue;
+
+                    if( testPair( ii ) )
+                        checked.insert( key );
                 }
+            };
 
-                return true;
-            },
-            m_largestClearance,
-            [&]( int aCount, int aSize ) -> bool
+    auto reportRun =
+            [&]( size_t aRun ) -> bool
             {
-                return reportProgress( aCount, aSize, progressDelta );
-            } );
+                size_t end = std::min( pairs.size(), ( aRun + 1 ) * runSize );
+
+                for( size_t ii = aRun * runSize; ii < end; ++ii )
+                {
+                    if( !found[ii].item )
+                        continue;
+
+                    PTR_PTR_CACHE_KEY key = canonicalKey( pairs[ii] );
+
+                    if( !collidingCompounds.count( key )
+                            && !m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+                    {
+                        collidingCompounds[ key ] = 1;
+                        reportViolation( found[ii].item, found[ii].pos, found[ii].layer );
+                    }
+
+                    found[ii].item.reset();
+                }
+
+                return true;
+            };
+
+    if( !parallelForEach( runCount, testRun, reportRun ) )
+        return false;   // DRC cancelled
 
     reportRuleStatistics();
 
@@ -61,6 +61,11 @@ public:
     {
         return wxT( "Tests text height and thickness" );
     }
+
+    virtual bool CanRunConcurrently() const override
+    {
+        return true;
+    }
 };
 
 
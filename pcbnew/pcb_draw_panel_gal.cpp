@@ -271,6 +271,8 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard, PROGRESS_REPORTER* aReport
     if( m_drawingSheet )
         m_drawingSheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
+    m_view->BeginBulkLoad();
+
     // Load drawings
     for( BOARD_ITEM* drawing : aBoard->Drawings() )
         m_view->Add( drawing );
@@ -300,6 +302,8 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard, PROGRESS_REPORTER* aReport
         m_ratsnest = std::make_unique<RATSNEST_VIEW_ITEM>( aBoard->GetConnectivity() );
         m_view->Add( m_ratsnest.get() );
     }
+
+    m_view->EndBulkLoad();
 }
 
 
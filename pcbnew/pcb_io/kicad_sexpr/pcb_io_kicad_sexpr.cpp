@@ -42,6 +42,7 @@
 #include <footprint.h>
 #include <io/kicad/kicad_io_utils.h>
 #include <kiface_base.h>
+#include <kiplatform/environment.h>
 #include <locale_io.h>
 #include <macros.h>
 #include <pad.h>
@@ -2630,9 +2631,16 @@ PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
-
-    unsigned lineCount = 0;
+    // The lexer tokenizes straight out of the mapped file.  A mapped file which is truncated
+    // while it is read faults instead of failing to read, which is likelier on a network share,
+    // so those files are read through a buffer.
+    std::unique_ptr<LINE_READER> reader;
+    unsigned                     lineCount = 0;
+
+    if( KIPLATFORM::ENV::IsNetworkPath( aFileName ) )
+        reader = std::make_unique<FILE_LINE_READER>( aFileName );
+    else
+        reader = std::make_unique<MAPPED_FILE_LINE_READER>( aFileName );
 
     fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
 
@@ -2643,13 +2651,22 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
+        if( auto mappedReader = dynamic_cast<MAPPED_FILE_LINE_READER*>( reader.get() ) )
+        {
+            lineCount = mappedReader->CountLines();
+        }
+        else
+        {
+            FILE_LINE_READER* fileReader = static_cast<FILE_LINE_READER*>( reader.get() );
+
+            while( fileReader->ReadLine() )
+                lineCount++;
 
-        reader.Rewind();
+            fileReader->Rewind();
+        }
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    BOARD* board = DoLoad( *reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
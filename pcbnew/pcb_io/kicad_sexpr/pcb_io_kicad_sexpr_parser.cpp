@@ -27,8 +27,10 @@
  * @brief Pcbnew s-expression file format parser implementation.
  */
 
+#include <atomic>
 #include <cerrno>
 #include <charconv>
+#include <future>
 #include <confirm.h>
 #include <macros.h>
 #include <fmt/format.h>
@@ -69,6 +71,7 @@
 #include <progress_reporter.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code. Needed for PCB_REFERENCE_IMAGE
@@ -89,6 +92,28 @@ constexpr double INT_LIMIT = std::numeric_limits<int>::max() - 10;
 using namespace PCB_KEYS_T;
 
 
+PCB_IO_KICAD_SEXPR_PARSER::PCB_IO_KICAD_SEXPR_PARSER( LINE_READER* aReader,
+                                                      const PCB_IO_KICAD_SEXPR_PARSER& aParent ) :
+        PCB_LEXER( aReader ),
+        m_board( aParent.m_board ),
+        m_layerIndices( aParent.m_layerIndices ),
+        m_layerMasks( aParent.m_layerMasks ),
+        m_netCodes( aParent.m_netCodes ),
+        m_tooRecent( aParent.m_tooRecent ),
+        m_requiredVersion( aParent.m_requiredVersion ),
+        m_generatorVersion( aParent.m_generatorVersion ),
+        m_appendToExisting( false ),
+        m_showLegacySegmentZoneWarning( aParent.m_showLegacySegmentZoneWarning ),
+        m_showLegacy5ZoneWarning( aParent.m_showLegacy5ZoneWarning ),
+        m_progressReporter( nullptr ),
+        m_lastProgressTime( aParent.m_lastProgressTime ),
+        m_lineCount( 0 ),
+        m_deferBoardChanges( true ),
+        m_legacyTeardrops( false )
+{
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::init()
 {
     m_showLegacySegmentZoneWarning = true;
@@ -920,6 +945,27 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
     std::vector<BOARD_ITEM*> bulkAddedItems;
     BOARD_ITEM* item = nullptr;
 
+    // Footprints and zones make up the bulk of a large board.  Set their text aside and parse
+    // them on the thread pool once everything they depend on (layers, nets, setup) is loaded.
+    // Appending resets UUIDs through a shared map, and boards older than the V6 format may
+    // need one-time legacy conversions, so those are still parsed in sequence.
+    std::vector<std::unique_ptr<DEFERRED_LIST>> deferredLists;
+    bool deferLists = !m_appendToExisting && m_requiredVersion >= 20210108
+                          && GetKiCadThreadPool().get_thread_count() > 1;
+
+    auto deferList =
+            [&]( bool aIsZone )
+            {
+                std::unique_ptr<DEFERRED_LIST> list = std::make_unique<DEFERRED_LIST>();
+
+                list->isZone = aIsZone;
+                list->lineNumber = ReadRawList( list->text );
+                list->slot = bulkAddedItems.size();
+
+                bulkAddedItems.push_back( nullptr );
+                deferredLists.push_back( std::move( list ) );
+            };
+
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
         checkpoint();
@@ -1043,6 +1089,12 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 
         case T_module:      // legacy token
         case T_footprint:
+            if( deferLists )
+            {
+                deferList( false );
+                break;
+            }
+
             item = parseFOOTPRINT();
             m_board->Add( item, ADD_MODE::BULK_APPEND, true );
             bulkAddedItems.push_back( item );
@@ -1075,6 +1127,12 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             break;
 
         case T_zone:
+            if( deferLists )
+            {
+                deferList( true );
+                break;
+            }
+
             item = parseZONE( m_board );
             m_board->Add( item, ADD_MODE::BULK_APPEND, true );
             bulkAddedItems.push_back( item );
@@ -1118,6 +1176,9 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( !deferredLists.empty() )
+        parseDeferredLists( deferredLists, bulkAddedItems );
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1229,6 +1290,120 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::parseDeferredLists(
+        std::vector<std::unique_ptr<DEFERRED_LIST>>& aLists,
+        std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::atomic<bool>              cancelled( false );
+    std::vector<std::future<void>> returns;
+
+    auto parseList =
+            [&]( DEFERRED_LIST* aList )
+            {
+                if( cancelled.load() )
+                    return;
+
+                try
+                {
+                    aList->parser.reset( new PCB_IO_KICAD_SEXPR_PARSER( aList->reader.get(),
+                                                                        *this ) );
+
+                    PCB_IO_KICAD_SEXPR_PARSER& parser = *aList->parser;
+
+                    parser.NextTok();   // the list's T_LEFT
+                    parser.NextTok();   // and its keyword
+
+                    if( aList->isZone )
+                        aList->item = parser.parseZONE( m_board );
+                    else
+                        aList->item = parser.parseFOOTPRINT();
+                }
+                catch( ... )
+                {
+                    aList->error = std::current_exception();
+                }
+            };
+
+    returns.reserve( aLists.size() );
+
+    for( const std::unique_ptr<DEFERRED_LIST>& list : aLists )
+    {
+        list->reader = std::make_unique<STRING_LINE_READER>( std::move( list->text ), CurSource(),
+                                                             list->lineNumber );
+        returns.emplace_back( tp.submit( parseList, list.get() ) );
+    }
+
+    for( const std::future<void>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+                cancelled.store( true );
+
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
+    }
+
+    auto deleteItems =
+            [&]( size_t aFirst )
+            {
+                for( size_t ii = aFirst; ii < aLists.size(); ++ii )
+                    delete aLists[ii]->item;
+            };
+
+    if( cancelled.load() )
+    {
+        deleteItems( 0 );
+        THROW_IO_ERROR( _( "Open cancelled by user." ) );
+    }
+
+    // Attach the results in file order, so the board ends up exactly as a sequential parse
+    // would have left it and the first error in the file is the one reported.
+    for( size_t ii = 0; ii < aLists.size(); ++ii )
+    {
+        DEFERRED_LIST& list = *aLists[ii];
+
+        if( list.parser )
+        {
+            m_requiredVersion = std::max( m_requiredVersion, list.parser->m_requiredVersion );
+            m_tooRecent = ( m_requiredVersion > SEXPR_BOARD_FILE_VERSION );
+        }
+
+        if( list.error )
+        {
+            deleteItems( ii );
+            std::rethrow_exception( list.error );
+        }
+
+        PCB_IO_KICAD_SEXPR_PARSER& parser = *list.parser;
+
+        for( const auto& [zone, netName] : parser.m_pendingZoneNets )
+            resolveZoneNet( zone, netName );
+
+        if( parser.m_legacyTeardrops )
+            m_board->SetLegacyTeardrops( true );
+
+        m_board->Add( list.item, ADD_MODE::BULK_APPEND, true );
+        aBulkAddedItems[list.slot] = list.item;
+
+        m_undefinedLayers.insert( parser.m_undefinedLayers.begin(),
+                                  parser.m_undefinedLayers.end() );
+        m_fontTextMap.insert( parser.m_fontTextMap.begin(), parser.m_fontTextMap.end() );
+
+        std::move( parser.m_groupInfos.begin(), parser.m_groupInfos.end(),
+                   std::back_inserter( m_groupInfos ) );
+        std::move( parser.m_generatorInfos.begin(), parser.m_generatorInfos.end(),
+                   std::back_inserter( m_generatorInfos ) );
+
+        list.parser.reset();
+        list.reader.reset();
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem =
@@ -2027,17 +2202,17 @@ template<class T, class M>
 T PCB_IO_KICAD_SEXPR_PARSER::lookUpLayer( const M& aMap )
 {
     // avoid constructing another std::string, use lexer's directly
-    typename M::const_iterator it = aMap.find( curText );
+    typename M::const_iterator it = aMap.find( CurStr() );
 
     if( it == aMap.end() )
     {
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
         return Rescue;
     }
 
     // Some files may have saved items to the Rescue Layer due to an issue in v5
     if( it->second == Rescue )
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
 
     return it->second;
 }
@@ -6606,28 +6781,19 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         // Can happens which old boards, with nonexistent nets ...
         // or after being edited by hand
         // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net, ADD_MODE::INSERT, true );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        if( m_deferBoardChanges )
+            m_pendingZoneNets.emplace_back( zone.get(), netnameFromfile );
+        else
+            resolveZoneNet( zone.get(), netnameFromfile );
     }
 
     if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
-        m_board->SetLegacyTeardrops( true );
+    {
+        if( m_deferBoardChanges )
+            m_legacyTeardrops = true;
+        else
+            m_board->SetLegacyTeardrops( true );
+    }
 
     // Clear flags used in zone edition:
     zone->SetNeedRefill( false );
@@ -6636,6 +6802,29 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::resolveZoneNet( ZONE* aZone, const wxString& aNetName )
+{
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net, ADD_MODE::INSERT, true );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
 PCB_TARGET* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, nullptr,
@@ -39,7 +39,10 @@
 #include <math/box2.h>
 #include <string_any_map.h>
 
+#include <charconv>
 #include <chrono>
+#include <exception>
+#include <memory>
 #include <unordered_map>
 
 
@@ -85,6 +88,8 @@ public:
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
+        m_deferBoardChanges( false ),
+        m_legacyTeardrops( false ),
         m_queryUserCallback( std::move( aQueryUserCallback ) )
     {
         init();
@@ -146,6 +151,28 @@ private:
         STRING_ANY_MAP properties;
     };
 
+    /**
+     * A top level footprint or zone whose text was set aside while reading a board, to be
+     * parsed on the thread pool once the rest of the board has been read.
+     */
+    struct DEFERRED_LIST
+    {
+        bool                                       isZone;
+        std::string                                text;
+        int                                        lineNumber;
+        size_t                                     slot;    ///< index in the bulk added items
+        std::unique_ptr<LINE_READER>               reader;
+        std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER> parser;
+        BOARD_ITEM*                                item = nullptr;
+        std::exception_ptr                         error;
+    };
+
+    /**
+     * Construct a parser for a single list set aside by \a aParent, sharing its layer and net
+     * mappings.  Changes to the board itself are recorded for \a aParent to apply.
+     */
+    PCB_IO_KICAD_SEXPR_PARSER( LINE_READER* aReader, const PCB_IO_KICAD_SEXPR_PARSER& aParent );
+
     ///< Convert net code using the mapping table if available,
     ///< otherwise returns unchanged net code if < 0 or if it's out of range
     inline int getNetCode( int aNetCode )
@@ -241,6 +268,21 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Parse the footprints and zones set aside by parseBOARD_unchecked() on the thread pool,
+     * then add them to the board and merge their parsers' state in file order.
+     *
+     * @throw the first error, in file order, thrown while parsing one of the lists.
+     */
+    void        parseDeferredLists( std::vector<std::unique_ptr<DEFERRED_LIST>>& aLists,
+                                    std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
+    /**
+     * Give \a aZone the net named \a aNetName, adding the net to the board if it doesn't
+     * exist yet.
+     */
+    void        resolveZoneNet( ZONE* aZone, const wxString& aNetName );
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -334,6 +376,12 @@ private:
 
     inline int parseInt()
     {
+        std::string_view text = CurView();
+        int              value = 0;
+
+        if( std::from_chars( text.data(), text.data() + text.size(), value ).ec == std::errc() )
+            return value;
+
         return (int)strtol( CurText(), nullptr, 10 );
     }
 
@@ -412,6 +460,12 @@ private:
     std::vector<GROUP_INFO>     m_groupInfos;
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
+    bool                m_deferBoardChanges; ///< parsing a deferred list; leave the board alone
+    bool                m_legacyTeardrops;   ///< a deferred zone needs legacy teardrops
+
+    ///< zones parsed from a deferred list whose nets still have to be resolved
+    std::vector<std::pair<ZONE*, wxString>> m_pendingZoneNets;
+
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
 
@@ -205,12 +205,12 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
 
     if( m_itemIndex == 2 )
-        return new PCBEXPR_LAYER_VALUE( context->GetLayer() );
+        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>( context->GetLayer() );
 
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
     auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
 
@@ -220,13 +220,13 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
         // simpler "A.Via_Type == 'buried'" is perfectly clear.  Instead, return an undefined
         // value when the property doesn't appear on a particular object.
 
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
     }
     else
     {
         if( m_type == LIBEVAL::VT_NUMERIC )
         {
-            return new LIBEVAL::VALUE( (double) item->Get<int>( it->second ) );
+            return aCtx->AllocValue( (double) item->Get<int>( it->second ) );
         }
         else
         {
@@ -237,9 +237,9 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
                 str = item->Get<wxString>( it->second );
 
                 if( it->second->Name() == wxT( "Pin Type" ) )
-                    return new PCBEXPR_PINTYPE_VALUE( str );
+                    return aCtx->AllocValue<PCBEXPR_PINTYPE_VALUE>( str );
                 else
-                    return new LIBEVAL::VALUE( str );
+                    return aCtx->AllocValue( str );
             }
             else
             {
@@ -251,18 +251,19 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
                         || it->second->Name() == wxT( "Layer Bottom" ) )
                 {
                     if( any.GetAs<PCB_LAYER_ID>( &layer ) )
-                        return new PCBEXPR_LAYER_VALUE( layer );
+                        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>( layer );
                     else if( any.GetAs<wxString>( &str ) )
-                        return new PCBEXPR_LAYER_VALUE( context->GetBoard()->GetLayerID( str ) );
+                        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>(
+                                context->GetBoard()->GetLayerID( str ) );
                 }
                 else
                 {
                     if( any.GetAs<wxString>( &str ) )
-                        return new LIBEVAL::VALUE( str );
+                        return aCtx->AllocValue( str );
                 }
             }
 
-            return new LIBEVAL::VALUE();
+            return aCtx->AllocValue();
         }
     }
 }
@@ -273,9 +274,9 @@ LIBEVAL::VALUE* PCBEXPR_NETCLASS_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NETCLASS_VALUE( item );
+    return aCtx->AllocValue<PCBEXPR_NETCLASS_VALUE>( item );
 }
 
 
@@ -284,9 +285,9 @@ LIBEVAL::VALUE* PCBEXPR_NETNAME_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NET_VALUE( item );
+    return aCtx->AllocValue<PCBEXPR_NET_VALUE>( item );
 }
 
 
@@ -295,9 +296,9 @@ LIBEVAL::VALUE* PCBEXPR_TYPE_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new LIBEVAL::VALUE( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    return aCtx->AllocValue( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
 }
 
 
@@ -305,6 +306,9 @@ LIBEVAL::FUNC_CALL_REF PCBEXPR_UCODE::CreateFuncCall( const wxString& aName )
 {
     PCBEXPR_BUILTIN_FUNCTIONS& registry = PCBEXPR_BUILTIN_FUNCTIONS::Instance();
 
+    // Functions may look at anything (geometry, areas, the current layer, etc.)
+    m_memoizable = false;
+
     return registry.Get( aName.Lower() );
 }
 
@@ -316,6 +320,10 @@ std::unique_ptr<LIBEVAL::VAR_REF> PCBEXPR_UCODE::CreateVarRef( const wxString& a
     std::unique_ptr<PCBEXPR_VAR_REF> vref;
 
     // Check for a couple of very common cases and compile them straight to "object code".
+    // Only the netclass and type references leave the expression memoizable.
+
+    if( aField.CmpNoCase( wxT( "NetClass" ) ) != 0 && aField.CmpNoCase( wxT( "Type" ) ) != 0 )
+        m_memoizable = false;
 
     if( aField.CmpNoCase( wxT( "NetClass" ) ) == 0 )
     {
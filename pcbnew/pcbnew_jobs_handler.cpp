@@ -39,6 +39,7 @@
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_batch.h>
 #include <lset.h>
 #include <cli/exit_codes.h>
 #include <exporters/place_file_exporter.h>
@@ -65,12 +66,14 @@
 #include <pcbnew_settings.h>
 #include <pcbplot.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
 #include <3d_rendering/raytracing/render_3d_raytrace_ram.h>
 #include <3d_rendering/track_ball.h>
 #include <project_pcb.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <reporter.h>
 #include <string_utf8_map.h>
+#include <string_utils.h>
 #include <wildcards_and_files_ext.h>
 #include <export_vrml.h>
 #include <wx/wfstream.h>
@@ -78,6 +81,10 @@
 
 #include "pcbnew_scripting_helpers.h"
 
+#include <mutex>
+#include <set>
+#include <thread>
+
 
 #ifdef _WIN32
 #ifdef TRANSPARENT
@@ -87,7 +94,9 @@
 
 
 PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
-        JOB_DISPATCHER( aKiway )
+        JOB_DISPATCHER( aKiway ),
+        m_batchBoard( nullptr ),
+        m_batchConcurrent( false )
 {
     Register( "3d", std::bind( &PCBNEW_JOBS_HANDLER::JobExportStep, this, std::placeholders::_1 ) );
     Register( "render", std::bind( &PCBNEW_JOBS_HANDLER::JobExportRender, this, std::placeholders::_1 ) );
@@ -108,6 +117,7 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
     Register( "drc", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrc, this, std::placeholders::_1 ) );
     Register( "ipc2581",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportIpc2581, this, std::placeholders::_1 ) );
+    Register( "batch", std::bind( &PCBNEW_JOBS_HANDLER::JobBatch, this, std::placeholders::_1 ) );
 }
 
 
@@ -118,12 +128,8 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
     if( aStepJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aStepJob->m_filename, true );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aStepJob->m_filename );
+    prepareBoard( brd, aJob );
 
     if( aStepJob->m_params.m_OutputFile.IsEmpty() )
     {
@@ -232,12 +238,8 @@ int PCBNEW_JOBS_HANDLER::JobExportRender( JOB* aJob )
     if( aRenderJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aRenderJob->m_filename, true );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aRenderJob->m_filename );
+    prepareBoard( brd, aJob );
 
     BOARD_ADAPTER boardAdapter;
 
@@ -425,13 +427,8 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     svgPlotOptions.m_sketchPadsOnFabLayers = aSvgJob->m_sketchPadsOnFabLayers;
     svgPlotOptions.m_drillShapeOption = aSvgJob->m_drillShapeOption;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aSvgJob->m_filename, true );
-    loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aSvgJob->m_filename );
+    prepareBoard( brd, aJob, aSvgJob->m_drawingSheet );
 
     if( aJob->IsCli() )
     {
@@ -452,13 +449,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     if( aDxfJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aDxfJob->m_filename, true );
-    loadOverrideDrawingSheet( brd, aDxfJob->m_drawingSheet );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aDxfJob->m_filename );
+    prepareBoard( brd, aJob, aDxfJob->m_drawingSheet );
 
     if( aDxfJob->m_outputFile.IsEmpty() )
     {
@@ -528,13 +520,8 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
     if( aPdfJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aPdfJob->m_filename, true );
-    loadOverrideDrawingSheet( brd, aPdfJob->m_drawingSheet );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aPdfJob->m_filename );
+    prepareBoard( brd, aJob, aPdfJob->m_drawingSheet );
 
     if( aPdfJob->m_outputFile.IsEmpty() )
     {
@@ -619,13 +606,8 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     if( aGerberJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
-    loadOverrideDrawingSheet( brd, aGerberJob->m_drawingSheet );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aGerberJob->m_filename );
+    prepareBoard( brd, aJob, aGerberJob->m_drawingSheet );
 
     PCB_PLOT_PARAMS       boardPlotOptions = brd->GetPlotOptions();
     LSET                  plotOnAllLayersSelection = boardPlotOptions.GetPlotOnAllLayersSelection();
@@ -654,75 +636,140 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    layer;
+        LSEQ            plotSequence;
+        PCB_PLOT_PARAMS plotOpts;
+        wxFileName      fn;
+        wxString        layerName;
+        wxString        sheetName;
+        wxString        sheetPath;
+        bool            plotted = false;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
     for( PCB_LAYER_ID layer : LSET( aGerberJob->m_printMaskLayer ).UIOrder() )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& plot = layerPlots.emplace_back();
+
+        plot.layer = layer;
 
         // Base layer always gets plotted first.
-        plotSequence.push_back( layer );
+        plot.plotSequence.push_back( layer );
 
         // Now all the "include on all" layers
         for( PCB_LAYER_ID layer_all : aGerberJob->m_layersIncludeOnAll.UIOrder() )
         {
             // Don't plot the same layer more than once;
-            if( find( plotSequence.begin(), plotSequence.end(), layer_all ) != plotSequence.end() )
+            if( find( plot.plotSequence.begin(), plot.plotSequence.end(), layer_all )
+                    != plot.plotSequence.end() )
+            {
                 continue;
+            }
 
-            plotSequence.push_back( layer_all );
+            plot.plotSequence.push_back( layer_all );
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
+        plot.fn = brd->GetFileName();
+        plot.layerName = brd->GetLayerName( layer );
 
         if( aGerberJob->m_useBoardPlotParams )
-            plotOpts = boardPlotOptions;
+            plot.plotOpts = boardPlotOptions;
         else
-            populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
+            populateGerberPlotOptionsFromJob( plot.plotOpts, aGerberJob );
 
-        if( plotOpts.GetUseGerberProtelExtensions() )
+        if( plot.plotOpts.GetUseGerberProtelExtensions() )
             fileExt = GetGerberProtelExtension( layer );
         else
             fileExt = FILEEXT::GerberFileExtension;
 
-        BuildPlotFileName( &fn, aGerberJob->m_outputFile, layerName, fileExt );
-        wxString fullname = fn.GetFullName();
+        BuildPlotFileName( &plot.fn, aGerberJob->m_outputFile, plot.layerName, fileExt );
+        wxString fullname = plot.fn.GetFullName();
 
         jobfile_writer.AddGbrFile( layer, fullname );
 
         if( aJob->GetVarOverrides().contains( wxT( "LAYER" ) ) )
-            layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
+            plot.layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETNAME" ) ) )
-            sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
+            plot.sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETPATH" ) ) )
-            sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+            plot.sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+    }
+
+    // Every layer has its own plotter and output file, so the layers can be plotted in any
+    // order, or all at once
+    auto plotLayer =
+            [&]( LAYER_PLOT& aPlot )
+            {
+                // We are feeding it one layer at the start here to silence a logic check
+                GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &aPlot.plotOpts,
+                                                                            aPlot.layer,
+                                                                            aPlot.layerName,
+                                                                            aPlot.fn.GetFullPath(),
+                                                                            aPlot.sheetName,
+                                                                            aPlot.sheetPath );
+
+                if( plotter )
+                {
+                    PlotBoardLayers( brd, plotter, aPlot.plotSequence, aPlot.plotOpts );
+                    plotter->EndPlot();
+                    aPlot.plotted = true;
+                }
+
+                delete plotter;
+            };
+
+    if( aGerberJob->m_parallelPlot && layerPlots.size() > 1 )
+    {
+        thread_pool&                   tp = GetKiCadThreadPool();
+        std::vector<std::future<void>> returns;
+
+        // Every layer's plotter setup computes the board bounding box.  Do it once beforehand so
+        // that the footprint bounding box caches are filled here, and only read by the layers.
+        // (The drawing sheet and text box caches are guarded by their own locks.)
+        brd->ComputeBoundingBox( false, false );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer,
-                                                                    layerName, fn.GetFullPath(),
-                                                                    sheetName, sheetPath );
+        returns.reserve( layerPlots.size() );
+
+        for( LAYER_PLOT& plot : layerPlots )
+        {
+            returns.emplace_back( tp.submit(
+                    [&plotLayer, &plot]()
+                    {
+                        plotLayer( plot );
+                    } ) );
+        }
 
-        if( plotter )
+        for( const std::future<void>& ret : returns )
+            ret.wait();
+    }
+    else
+    {
+        for( LAYER_PLOT& plot : layerPlots )
+            plotLayer( plot );
+    }
+
+    // Report in layer order, whichever order the layers finished in
+    for( const LAYER_PLOT& plot : layerPlots )
+    {
+        if( plot.plotted )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                  plot.fn.GetFullPath() ),
                                 RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
             m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
+                                                  plot.fn.GetFullPath() ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -767,12 +814,8 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     if( aGerberJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, aGerberJob->m_filename );
+    prepareBoard( brd, aJob );
 
     if( aGerberJob->m_outputFile.IsEmpty() )
     {
@@ -841,10 +884,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
     if( aDrillJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aDrillJob->m_filename, true );
+    BOARD* brd = getBoard( aJob, aDrillJob->m_filename );
 
     // ensure output dir exists
     wxFileName fn( aDrillJob->m_outputDir + wxT( "/" ) );
@@ -960,10 +1000,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
     if( aPosJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( aPosJob->m_filename, true );
+    BOARD* brd = getBoard( aJob, aPosJob->m_filename );
 
     if( aPosJob->m_outputFile.IsEmpty() )
     {
@@ -1261,12 +1298,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
     if( drcJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( aJob->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( drcJob->m_filename, true );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( aJob, drcJob->m_filename );
+    prepareBoard( brd, aJob );
 
     if( drcJob->m_outputFile.IsEmpty() )
     {
@@ -1429,10 +1462,7 @@ int PCBNEW_JOBS_HANDLER::JobExportIpc2581( JOB* aJob )
     if( job == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    if( job->IsCli() )
-        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
-
-    BOARD* brd = LoadBoard( job->m_filename, true );
+    BOARD* brd = getBoard( job, job->m_filename );
 
     if( job->m_outputFile.IsEmpty() )
     {
@@ -1506,6 +1536,260 @@ int PCBNEW_JOBS_HANDLER::JobExportIpc2581( JOB* aJob )
 }
 
 
+namespace
+{
+
+/**
+ * Serialise reports from batched jobs running on several threads.
+ */
+class LOCKING_REPORTER : public REPORTER
+{
+public:
+    LOCKING_REPORTER( REPORTER* aReporter ) :
+            m_reporter( aReporter )
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        m_reporter->Report( aText, aSeverity );
+        return *this;
+    }
+
+    bool HasMessage() const override { return m_reporter->HasMessage(); }
+
+private:
+    REPORTER*  m_reporter;
+    std::mutex m_mutex;
+};
+
+
+/**
+ * @return the board file a job works on, or nullptr if it doesn't take a board.
+ */
+wxString* getBoardJobFilename( JOB* aJob )
+{
+    if( JOB_EXPORT_PCB_3D* job = dynamic_cast<JOB_EXPORT_PCB_3D*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_PCB_RENDER* job = dynamic_cast<JOB_PCB_RENDER*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_SVG* job = dynamic_cast<JOB_EXPORT_PCB_SVG*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_DXF* job = dynamic_cast<JOB_EXPORT_PCB_DXF*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_PDF* job = dynamic_cast<JOB_EXPORT_PCB_PDF*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_GERBER* job = dynamic_cast<JOB_EXPORT_PCB_GERBER*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_DRILL* job = dynamic_cast<JOB_EXPORT_PCB_DRILL*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_POS* job = dynamic_cast<JOB_EXPORT_PCB_POS*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_PCB_DRC* job = dynamic_cast<JOB_PCB_DRC*>( aJob ) )
+        return &job->m_filename;
+    else if( JOB_EXPORT_PCB_IPC2581* job = dynamic_cast<JOB_EXPORT_PCB_IPC2581*>( aJob ) )
+        return &job->m_filename;
+
+    return nullptr;
+}
+
+
+/**
+ * @return the drawing sheet a job overrides the board's with, if any.
+ */
+wxString getBoardJobDrawingSheet( JOB* aJob )
+{
+    if( JOB_EXPORT_PCB_SVG* job = dynamic_cast<JOB_EXPORT_PCB_SVG*>( aJob ) )
+        return job->m_drawingSheet;
+    else if( JOB_EXPORT_PCB_DXF* job = dynamic_cast<JOB_EXPORT_PCB_DXF*>( aJob ) )
+        return job->m_drawingSheet;
+    else if( JOB_EXPORT_PCB_PDF* job = dynamic_cast<JOB_EXPORT_PCB_PDF*>( aJob ) )
+        return job->m_drawingSheet;
+    else if( JOB_EXPORT_PCB_GERBER* job = dynamic_cast<JOB_EXPORT_PCB_GERBER*>( aJob ) )
+        return job->m_drawingSheet;
+
+    return wxEmptyString;
+}
+
+} // namespace
+
+
+int PCBNEW_JOBS_HANDLER::JobBatch( JOB* aJob )
+{
+    JOB_PCB_BATCH* batchJob = dynamic_cast<JOB_PCB_BATCH*>( aJob );
+
+    if( batchJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    // Exporters which only read the board and share no global state.  DRC adds markers to the
+    // board, the drill map changes the visible layers to measure the board, the 3D exporters
+    // share model caches, and the plotters (gerber(s), pdf, svg, dxf) draw the global drawing
+    // sheet, so those run on their own.
+    static const std::set<std::string> readOnlyJobs = { "pos" };
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
+
+    BOARD* brd = LoadBoard( batchJob->m_filename, true );
+
+    if( !brd )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to load board '%s'.\n" ),
+                                              batchJob->m_filename ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+    brd->SynchronizeProperties();
+
+    m_batchBoard = brd;
+    m_batchFilename = batchJob->m_filename;
+
+    int exitCode = CLI::EXIT_CODES::OK;
+
+    auto recordExitCode =
+            [&]( int aExitCode )
+            {
+                // Report the first failure
+                if( exitCode == CLI::EXIT_CODES::OK )
+                    exitCode = aExitCode;
+            };
+
+    auto runJob =
+            [&]( JOB* aSubJob ) -> int
+            {
+                try
+                {
+                    return RunJob( aSubJob );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+                }
+                catch( const std::exception& e )
+                {
+                    m_reporter->Report( From_UTF8( e.what() ) + wxS( "\n" ), RPT_SEVERITY_ERROR );
+                }
+
+                return CLI::EXIT_CODES::ERR_UNKNOWN;
+            };
+
+    // A job's own text variable and drawing sheet overrides are applied to the shared board
+    // (and the global drawing sheet) by prepareBoard(); put back the batch's after each job so
+    // that they don't leak into the following ones.
+    const std::map<wxString, wxString> batchTextVars = brd->GetProject()->GetTextVars();
+    const wxString                     batchDrawingSheet = BASE_SCREEN::m_DrawingSheetFileName;
+
+    auto runSerialJob =
+            [&]( JOB* aSubJob )
+            {
+                recordExitCode( runJob( aSubJob ) );
+
+                brd->GetProject()->GetTextVars() = batchTextVars;
+
+                if( !getBoardJobDrawingSheet( aSubJob ).IsEmpty() )
+                {
+                    BASE_SCREEN::m_DrawingSheetFileName = batchDrawingSheet;
+
+                    if( batchDrawingSheet.IsEmpty() )
+                        DS_DATA_MODEL::GetTheInstance().SetDefaultLayout();
+                    else
+                        loadOverrideDrawingSheet( brd, batchDrawingSheet );
+                }
+
+                brd->SynchronizeProperties();
+            };
+
+    // Read-only jobs next to each other in the list run together; everything else runs on its
+    // own, so the jobs still run in the order they were listed.
+    std::vector<JOB*> concurrentJobs;
+
+    auto runConcurrentJobs =
+            [&]()
+            {
+                if( concurrentJobs.size() <= 1 )
+                {
+                    for( JOB* job : concurrentJobs )
+                        runSerialJob( job );
+
+                    concurrentJobs.clear();
+                    return;
+                }
+
+                REPORTER*                reporter = m_reporter;
+                LOCKING_REPORTER         lockingReporter( reporter );
+                std::vector<int>         results( concurrentJobs.size(), CLI::EXIT_CODES::OK );
+                std::vector<std::thread> threads;
+
+                m_reporter = &lockingReporter;
+                m_batchConcurrent = true;
+
+                // The position files measure the board, which fills the footprints' bounding
+                // box caches; fill them here rather than from several threads at once.
+                brd->ComputeBoundingBox( false, false );
+
+                // Plain threads rather than the thread pool: the exporters queue their own work
+                // on the pool, and pool workers blocked waiting on it could starve it.
+                for( size_t ii = 0; ii < concurrentJobs.size(); ++ii )
+                {
+                    threads.emplace_back(
+                            [&, ii]()
+                            {
+                                results[ii] = runJob( concurrentJobs[ii] );
+                            } );
+                }
+
+                for( std::thread& thread : threads )
+                    thread.join();
+
+                m_batchConcurrent = false;
+                m_reporter = reporter;
+
+                for( int result : results )
+                    recordExitCode( result );
+
+                concurrentJobs.clear();
+            };
+
+    for( JOB* job : batchJob->m_jobs )
+    {
+        wxString* filename = getBoardJobFilename( job );
+
+        if( !filename )
+        {
+            runConcurrentJobs();
+            m_reporter->Report( wxString::Format( _( "Job '%s' cannot be run in a batch.\n" ),
+                                                  job->GetType() ),
+                                RPT_SEVERITY_ERROR );
+            recordExitCode( CLI::EXIT_CODES::ERR_ARGS );
+            continue;
+        }
+
+        // Jobs with their own overrides would change the shared board under the others' feet
+        if( batchJob->m_concurrent && *filename == m_batchFilename
+                && readOnlyJobs.count( job->GetType() ) && job->GetVarOverrides().empty() )
+        {
+            concurrentJobs.push_back( job );
+        }
+        else
+        {
+            runConcurrentJobs();
+            runSerialJob( job );
+        }
+    }
+
+    runConcurrentJobs();
+
+    m_batchBoard = nullptr;
+    m_batchFilename.clear();
+
+    return exitCode;
+}
+
+
 DS_PROXY_VIEW_ITEM* PCBNEW_JOBS_HANDLER::getDrawingSheetProxyView( BOARD* aBrd )
 {
     DS_PROXY_VIEW_ITEM* drawingSheet = new DS_PROXY_VIEW_ITEM( pcbIUScale,
@@ -1561,3 +1845,26 @@ void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString&
     // failed loading custom path, revert back to default
     loadSheet( aBrd->GetProject()->GetProjectFile().m_BoardDrawingSheetFile );
 }
+
+
+BOARD* PCBNEW_JOBS_HANDLER::getBoard( JOB* aJob, wxString& aFilename )
+{
+    if( m_batchBoard && aFilename == m_batchFilename )
+        return m_batchBoard;
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
+
+    return LoadBoard( aFilename, true );
+}
+
+
+void PCBNEW_JOBS_HANDLER::prepareBoard( BOARD* aBrd, JOB* aJob, const wxString& aDrawingSheet )
+{
+    if( m_batchConcurrent )
+        return;
+
+    loadOverrideDrawingSheet( aBrd, aDrawingSheet );
+    aBrd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+    aBrd->SynchronizeProperties();
+}
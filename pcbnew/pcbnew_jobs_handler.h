@@ -48,14 +48,31 @@ public:
     int JobExportFpSvg( JOB* aJob );
     int JobExportDrc( JOB* aJob );
     int JobExportIpc2581( JOB* aJob );
+    int JobBatch( JOB* aJob );
 
 private:
+    /**
+     * Load the board a job works on, or return the board shared by the running batch.
+     */
+    BOARD* getBoard( JOB* aJob, wxString& aFilename );
+
+    /**
+     * Apply a job's drawing sheet and text variable overrides to its board.  This is a no-op
+     * while batched jobs run concurrently; the batch prepared the shared board beforehand, and
+     * restores its own overrides after each job that runs on its own.
+     */
+    void prepareBoard( BOARD* aBrd, JOB* aJob, const wxString& aDrawingSheet = wxEmptyString );
+
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS&       aPlotOpts,
                                            JOB_EXPORT_PCB_GERBER* aJob );
     int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
     void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
 
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( BOARD* aBrd );
+
+    BOARD*   m_batchBoard;       ///< Board loaded by the running batch, if any.
+    wxString m_batchFilename;    ///< File m_batchBoard was loaded from.
+    bool     m_batchConcurrent;  ///< Batched jobs are running concurrently on m_batchBoard.
 };
 
 #endif
\ No newline at end of file
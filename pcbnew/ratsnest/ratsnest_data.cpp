@@ -41,6 +41,7 @@ using namespace std::placeholders;
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <unordered_map>
 
 #include <delaunator.hpp>
 
@@ -137,22 +138,44 @@ void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
 class RN_NET::TRIANGULATOR_STATE
 {
 private:
+    ///< Nets with fewer anchors than this are always triangulated from scratch.
+    static constexpr size_t c_minIncrementalNodes = 64;
+
+    ///< Added plus removed anchors, as a fraction of the net, above which a full rebuild wins.
+    static constexpr double c_maxChurnRatio = 0.1;
+
+    ///< Upper bound on added plus removed anchors handled incrementally, whatever the net size.
+    static constexpr size_t c_maxChurnNodes = 256;
+
+    ///< Number of incremental passes after which the graph is rebuilt to bound its drift.
+    static constexpr int c_maxIncrementalPasses = 32;
+
     std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> m_allNodes;
 
+    ///< Anchors of the previous pass, in position order.  Holding the references keeps removed
+    ///< anchors alive so their addresses can't be handed out again to newly added ones.
+    std::vector<std::shared_ptr<CN_ANCHOR>> m_prevNodes;
+    std::vector<VECTOR2I>                   m_prevPos;
+
+    ///< Candidate edges of the previous pass between distinct positions (m_prevNodes indices).
+    std::vector<std::pair<int, int>>        m_prevEdges;
+    int                                     m_incrementalPasses = 0;
+
 
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
-    bool areNodesColinear( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes ) const
+    bool areNodesColinear( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes,
+                           const std::vector<int>& aIndices ) const
     {
-        if ( aNodes.size() <= 2 )
+        if ( aIndices.size() <= 2 )
             return true;
 
-        const VECTOR2I p0( aNodes[0]->Pos() );
-        const VECTOR2I v0( aNodes[1]->Pos() - p0 );
+        const VECTOR2I p0( aNodes[aIndices[0]]->Pos() );
+        const VECTOR2I v0( aNodes[aIndices[1]]->Pos() - p0 );
 
-        for( unsigned i = 2; i < aNodes.size(); i++ )
+        for( unsigned i = 2; i < aIndices.size(); i++ )
         {
-            const VECTOR2I v1 = aNodes[i]->Pos() - p0;
+            const VECTOR2I v1 = aNodes[aIndices[i]]->Pos() - p0;
 
             if( v0.Cross( v1 ) != 0 )
                 return false;
@@ -161,102 +184,355 @@ private:
         return true;
     }
 
-public:
-
-    void Clear()
-    {
-        m_allNodes.clear();
-    }
-
-    void AddNode( const std::shared_ptr<CN_ANCHOR>& aNode )
-    {
-        m_allNodes.insert( aNode );
-    }
-
-    void Triangulate( std::vector<CN_EDGE>& mstEdges )
+    /**
+     * Build the Delaunay graph of the distinct anchor positions from scratch.
+     *
+     * @return false if there are fewer than two distinct positions.
+     */
+    bool triangulate( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes,
+                      std::vector<std::pair<int, int>>& aEdges ) const
     {
-        std::vector<double>                                    node_pts;
-        std::vector<std::shared_ptr<CN_ANCHOR>>                anchors;
-        std::vector< std::vector<std::shared_ptr<CN_ANCHOR>> > anchorChains( m_allNodes.size() );
+        std::vector<double> node_pts;
+        std::vector<int>    anchors;
 
-        node_pts.reserve( 2 * m_allNodes.size() );
-        anchors.reserve( m_allNodes.size() );
+        node_pts.reserve( 2 * aNodes.size() );
+        anchors.reserve( aNodes.size() );
 
-        auto addEdge =
-                [&]( const std::shared_ptr<CN_ANCHOR>& src, const std::shared_ptr<CN_ANCHOR>& dst )
-                {
-                    mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
-                };
-
-        std::shared_ptr<CN_ANCHOR> prev = nullptr;
-
-        for( const std::shared_ptr<CN_ANCHOR>& n : m_allNodes )
+        for( size_t i = 0; i < aNodes.size(); i++ )
         {
-            if( !prev || prev->Pos() != n->Pos() )
+            if( i == 0 || aNodes[i - 1]->Pos() != aNodes[i]->Pos() )
             {
-                node_pts.push_back( n->Pos().x );
-                node_pts.push_back( n->Pos().y );
-                anchors.push_back( n );
-                prev = n;
+                node_pts.push_back( aNodes[i]->Pos().x );
+                node_pts.push_back( aNodes[i]->Pos().y );
+                anchors.push_back( i );
             }
-
-            anchorChains[anchors.size() - 1].push_back( n );
         }
 
         if( anchors.size() < 2 )
         {
-            return;
+            return false;
         }
-        else if( areNodesColinear( anchors ) )
+        else if( areNodesColinear( aNodes, anchors ) )
         {
             // special case: all nodes are on the same line - there's no
             // triangulation for such set. In this case, we sort along any coordinate
             // and chain the nodes together.
             for( size_t i = 0; i < anchors.size() - 1; i++ )
-                addEdge( anchors[i], anchors[i + 1] );
+                aEdges.emplace_back( anchors[i], anchors[i + 1] );
         }
         else
         {
             delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
+            const std::vector<size_t>& triangles = delaunator.triangles;
+            const std::vector<size_t>& halfedges = delaunator.halfedges;
 
-            for( size_t i = 0; i < triangles.size(); i += 3 )
+            // Each interior edge appears as two opposite half-edges; keep one of them
+            for( size_t i = 0; i < triangles.size(); i++ )
             {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
-            }
-
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
-            {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
+                if( halfedges[i] != delaunator::INVALID_INDEX && halfedges[i] < i )
                     continue;
 
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
+                size_t next = ( i % 3 == 2 ) ? i - 2 : i + 1;
+                aEdges.emplace_back( anchors[triangles[i]], anchors[triangles[next]] );
             }
         }
 
-        for( size_t i = 0; i < anchorChains.size(); i++ )
+        return true;
+    }
+
+    /**
+     * Connect a newly added anchor to its nearest neighbour in each of the eight 45 degree
+     * octants around it.  The Euclidean MST edges incident to a point are always among these,
+     * so inserting anchors this way loses nothing compared to a new triangulation.
+     */
+    void addOctantNeighbours( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes, int aIdx,
+                              std::vector<std::pair<int, int>>& aEdges ) const
+    {
+        const VECTOR2I p = aNodes[aIdx]->Pos();
+        SEG::ecoord    best[8];
+        int            bestIdx[8];
+
+        std::fill( std::begin( best ), std::end( best ), VECTOR2I::ECOORD_MAX );
+        std::fill( std::begin( bestIdx ), std::end( bestIdx ), -1 );
+
+        auto octant =
+                []( const VECTOR2L& d ) -> int
+                {
+                    return ( d.x >= 0 ? 4 : 0 ) + ( d.y >= 0 ? 2 : 0 )
+                           + ( std::abs( d.x ) >= std::abs( d.y ) ? 1 : 0 );
+                };
+
+        // Largest best distance among the octants on one side of the sweep; once the x
+        // distance alone exceeds it, no further node on that side can improve any octant
+        auto sideLimit =
+                [&]( bool aRight ) -> SEG::ecoord
+                {
+                    SEG::ecoord limit = 0;
+
+                    for( int o = aRight ? 4 : 0; o < ( aRight ? 8 : 4 ); o++ )
+                        limit = std::max( limit, best[o] );
+
+                    return limit;
+                };
+
+        auto visit =
+                [&]( int aOther )
+                {
+                    VECTOR2L d = VECTOR2L( aNodes[aOther]->Pos() ) - VECTOR2L( p );
+
+                    if( d.x == 0 && d.y == 0 )
+                        return;
+
+                    int         o = octant( d );
+                    SEG::ecoord dist_sq = d.SquaredEuclideanNorm();
+
+                    if( dist_sq < best[o] )
+                    {
+                        best[o] = dist_sq;
+                        bestIdx[o] = aOther;
+                    }
+                };
+
+        for( int i = aIdx + 1; i < (int) aNodes.size(); i++ )
+        {
+            SEG::ecoord dx = (SEG::ecoord) aNodes[i]->Pos().x - p.x;
+
+            if( dx > 0 && dx * dx > sideLimit( true ) )
+                break;
+
+            visit( i );
+        }
+
+        for( int i = aIdx - 1; i >= 0; i-- )
+        {
+            SEG::ecoord dx = (SEG::ecoord) p.x - aNodes[i]->Pos().x;
+
+            if( dx > 0 && dx * dx > sideLimit( false ) )
+                break;
+
+            visit( i );
+        }
+
+        for( int idx : bestIdx )
+        {
+            if( idx >= 0 )
+                aEdges.emplace_back( aIdx, idx );
+        }
+    }
+
+    /**
+     * Patch the previous pass's graph: drop edges of removed anchors, close the holes they
+     * leave by triangulating their surviving neighbours, and attach added anchors to their
+     * octant neighbours.  Removed anchors which were neighbours leave a single hole, which is
+     * closed as a whole.
+     *
+     * @return false if the churn is too large or the patched graph no longer spans the net,
+     *         in which case the caller must rebuild from scratch.
+     */
+    bool updateIncremental( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes,
+                            std::vector<std::pair<int, int>>& aEdges ) const
+    {
+        if( m_prevNodes.empty() || aNodes.size() < c_minIncrementalNodes
+                || m_incrementalPasses >= c_maxIncrementalPasses )
+        {
+            return false;
+        }
+
+        std::unordered_map<const CN_ANCHOR*, int> prevIndex;
+        prevIndex.reserve( m_prevNodes.size() );
+
+        for( size_t i = 0; i < m_prevNodes.size(); i++ )
+            prevIndex.emplace( m_prevNodes[i].get(), i );
+
+        std::vector<int> prevToNew( m_prevNodes.size(), -1 );
+        std::vector<int> added;
+
+        for( size_t i = 0; i < aNodes.size(); i++ )
+        {
+            auto it = prevIndex.find( aNodes[i].get() );
+
+            if( it != prevIndex.end() && m_prevPos[it->second] == aNodes[i]->Pos() )
+                prevToNew[it->second] = i;
+            else
+                added.push_back( i );
+        }
+
+        size_t kept = aNodes.size() - added.size();
+        size_t churn = added.size() + ( m_prevNodes.size() - kept );
+
+        if( churn > c_maxChurnNodes || churn > c_maxChurnRatio * aNodes.size() )
+            return false;
+
+        // Group removed anchors joined by an edge: the triangles around them merge into one
+        // hole.  Removed anchors which weren't neighbours share no triangle, so their holes
+        // can be closed separately.
+        disjoint_set removedGroups( m_prevNodes.size() );
+
+        for( const auto& [a, b] : m_prevEdges )
         {
-            std::vector<std::shared_ptr<CN_ANCHOR>>& chain = anchorChains[i];
+            if( prevToNew[a] < 0 && prevToNew[b] < 0 )
+                removedGroups.unite( a, b );
+        }
+
+        std::unordered_map<int, std::vector<int>> holes;
+
+        for( const auto& [a, b] : m_prevEdges )
+        {
+            int na = prevToNew[a];
+            int nb = prevToNew[b];
+
+            if( na >= 0 && nb >= 0 )
+                aEdges.emplace_back( na, nb );
+            else if( na >= 0 )
+                holes[removedGroups.find( b )].push_back( na );
+            else if( nb >= 0 )
+                holes[removedGroups.find( a )].push_back( nb );
+        }
+
+        for( auto& [removed, neighbours] : holes )
+        {
+            // The edges filling a hole are Delaunay edges between the surviving anchors on its
+            // rim, and stay Delaunay in any subset holding both ends, so triangulating just
+            // those points closes it exactly.
+            // Node indices follow position order, so sorting them keeps the subset sorted.
+            std::sort( neighbours.begin(), neighbours.end() );
+            neighbours.erase( std::unique( neighbours.begin(), neighbours.end() ),
+                              neighbours.end() );
+
+            std::vector<std::shared_ptr<CN_ANCHOR>> local;
+            std::vector<std::pair<int, int>>        localEdges;
+
+            for( int idx : neighbours )
+                local.push_back( aNodes[idx] );
+
+            triangulate( local, localEdges );
+
+            for( const auto& [a, b] : localEdges )
+                aEdges.emplace_back( neighbours[a], neighbours[b] );
+        }
 
-            if( chain.size() < 2 )
+        for( int idx : added )
+            addOctantNeighbours( aNodes, idx, aEdges );
+
+        // Removing anchors can leave a rim too small to triangulate (or every anchor of a
+        // region), so check the graph still spans every anchor (coincident anchors are chained
+        // together separately)
+        disjoint_set dset( aNodes.size() );
+        size_t       components = aNodes.size();
+
+        for( size_t i = 1; i < aNodes.size(); i++ )
+        {
+            if( aNodes[i - 1]->Pos() == aNodes[i]->Pos() && dset.unite( i - 1, i ) )
+                components--;
+        }
+
+        for( const auto& [a, b] : aEdges )
+        {
+            if( dset.unite( a, b ) )
+                components--;
+        }
+
+        return components == 1;
+    }
+
+    /**
+     * Chain anchors sharing a position.  These edges carry no length, so they are weighted
+     * by whether they join different clusters.
+     */
+    void addCoincidentChains( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes,
+                              std::vector<CN_EDGE>& mstEdges ) const
+    {
+        std::vector<std::shared_ptr<CN_ANCHOR>> chain;
+
+        for( size_t i = 0; i <= aNodes.size(); i++ )
+        {
+            if( i < aNodes.size() && ( chain.empty() || chain[0]->Pos() == aNodes[i]->Pos() ) )
+            {
+                chain.push_back( aNodes[i] );
                 continue;
+            }
 
-            std::sort( chain.begin(), chain.end(),
-                    [] ( const std::shared_ptr<CN_ANCHOR>& a, const std::shared_ptr<CN_ANCHOR>& b )
-                    {
-                        return a->GetCluster().get() < b->GetCluster().get();
-                    } );
+            if( chain.size() >= 2 )
+            {
+                std::sort( chain.begin(), chain.end(),
+                        [] ( const std::shared_ptr<CN_ANCHOR>& a,
+                             const std::shared_ptr<CN_ANCHOR>& b )
+                        {
+                            return a->GetCluster().get() < b->GetCluster().get();
+                        } );
 
-            for( unsigned int j = 1; j < chain.size(); j++ )
+                for( unsigned int j = 1; j < chain.size(); j++ )
+                {
+                    const std::shared_ptr<CN_ANCHOR>& prevNode = chain[j - 1];
+                    const std::shared_ptr<CN_ANCHOR>& curNode  = chain[j];
+                    int weight = prevNode->GetCluster() != curNode->GetCluster() ? 1 : 0;
+                    mstEdges.emplace_back( prevNode, curNode, weight );
+                }
+            }
+
+            chain.clear();
+
+            if( i < aNodes.size() )
+                chain.push_back( aNodes[i] );
+        }
+    }
+
+public:
+
+    void Clear()
+    {
+        m_allNodes.clear();
+    }
+
+    /**
+     * Forget the previous pass so that the next Triangulate() starts from scratch.
+     */
+    void ClearHistory()
+    {
+        m_prevNodes.clear();
+        m_prevPos.clear();
+        m_prevEdges.clear();
+        m_incrementalPasses = 0;
+    }
+
+    void AddNode( const std::shared_ptr<CN_ANCHOR>& aNode )
+    {
+        m_allNodes.insert( aNode );
+    }
+
+    void Triangulate( std::vector<CN_EDGE>& mstEdges )
+    {
+        std::vector<std::shared_ptr<CN_ANCHOR>> nodes( m_allNodes.begin(), m_allNodes.end() );
+        std::vector<std::pair<int, int>>        edges;
+
+        if( updateIncremental( nodes, edges ) )
+        {
+            m_incrementalPasses++;
+        }
+        else
+        {
+            edges.clear();
+            m_incrementalPasses = 0;
+
+            if( !triangulate( nodes, edges ) )
             {
-                const std::shared_ptr<CN_ANCHOR>& prevNode = chain[j - 1];
-                const std::shared_ptr<CN_ANCHOR>& curNode  = chain[j];
-                int weight = prevNode->GetCluster() != curNode->GetCluster() ? 1 : 0;
-                mstEdges.emplace_back( prevNode, curNode, weight );
+                ClearHistory();
+                return;
             }
         }
+
+        for( const auto& [a, b] : edges )
+            mstEdges.emplace_back( nodes[a], nodes[b], nodes[a]->Dist( *nodes[b] ) );
+
+        addCoincidentChains( nodes, mstEdges );
+
+        m_prevPos.resize( nodes.size() );
+
+        for( size_t i = 0; i < nodes.size(); i++ )
+            m_prevPos[i] = nodes[i]->Pos();
+
+        m_prevNodes = std::move( nodes );
+        m_prevEdges = std::move( edges );
     }
 };
 
@@ -274,6 +550,7 @@ void RN_NET::compute()
     if( m_nodes.size() <= 2 )
     {
         m_rnEdges.clear();
+        m_triangulator->ClearHistory();
 
         // Check if the only possible connection exists
         if( m_boardEdges.size() == 0 && m_nodes.size() == 2 )
@@ -24,6 +24,7 @@
  */
 
 #include <future>
+#include <set>
 #include <core/kicad_algo.h>
 #include <advanced_config.h>
 #include <board.h>
@@ -44,6 +45,7 @@
 #include <progress_reporter.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/convex_hull.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/vertex_set.h>
 #include <kidialog.h>
@@ -279,6 +281,8 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         footprint->BuildCourtyardCaches();
     }
 
+    buildZoneIndex();
+
     LSET boardCuMask = m_board->GetEnabledLayers() & LSET::AllCuMask();
 
     auto findHighestPriorityZone = [&]( const BOX2I& aBBox, const PCB_LAYER_ID aItemLayer,
@@ -288,8 +292,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         unsigned highestPriority = 0;
         ZONE*    highestPriorityZone = nullptr;
 
-        for( ZONE* zone : m_board->Zones() )
+        for( ZONE* zone : queryZones( aItemLayer, aBBox ) )
         {
+            if( zone->GetParentFootprint() )
+                continue;
+
             // Rule areas are not filled
             if( zone->GetIsRuleArea() )
                 continue;
@@ -324,8 +331,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     auto isInPourKeepoutArea = [&]( const BOX2I& aBBox, const PCB_LAYER_ID aItemLayer,
                                     const VECTOR2I aTestPoint ) -> bool
     {
-        for( ZONE* zone : m_board->Zones() )
+        for( ZONE* zone : queryZones( aItemLayer, aBBox ) )
         {
+            if( zone->GetParentFootprint() )
+                continue;
+
             if( !zone->GetIsRuleArea() )
                 continue;
 
@@ -437,35 +447,44 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         }
     }
 
-    for( ZONE* zone : aZones )
-    {
-        // Rule areas are not filled
-        if( zone->GetIsRuleArea() )
-            continue;
+    // The zones being filled.  This starts out as aZones, but may grow to include zones whose
+    // fills depend on the fills of aZones.
+    std::vector<ZONE*> zones( aZones.begin(), aZones.end() );
 
-        // Degenerate zones will cause trouble; skip them
-        if( zone->GetNumCorners() <= 2 )
-            continue;
+    auto prepareZone =
+            [&]( ZONE* zone, std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aFillItems )
+            {
+                // Rule areas are not filled
+                if( zone->GetIsRuleArea() )
+                    return;
 
-        if( m_commit )
-            m_commit->Modify( zone );
+                // Degenerate zones will cause trouble; skip them
+                if( zone->GetNumCorners() <= 2 )
+                    return;
 
-        // calculate the hash value for filled areas. it will be used later to know if the
-        // current filled areas are up to date
-        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
-        {
-            zone->BuildHashValue( layer );
-            oldFillHashes[ { zone, layer } ] = zone->GetHashValue( layer );
+                if( m_commit )
+                    m_commit->Modify( zone );
 
-            // Add the zone to the list of zones to test or refill
-            toFill.emplace_back( std::make_pair( zone, layer ) );
+                // calculate the hash value for filled areas. it will be used later to know if
+                // the current filled areas are up to date
+                for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                {
+                    zone->BuildHashValue( layer );
+                    oldFillHashes[ { zone, layer } ] = zone->GetHashValue( layer );
 
-            isolatedIslandsMap[ zone ][ layer ] = ISOLATED_ISLANDS();
-        }
+                    // Add the zone to the list of zones to test or refill
+                    aFillItems.emplace_back( std::make_pair( zone, layer ) );
 
-        // Remove existing fill first to prevent drawing invalid polygons on some platforms
-        zone->UnFill();
-    }
+                    isolatedIslandsMap[ zone ][ layer ] = ISOLATED_ISLANDS();
+                }
+
+                // Remove existing fill first to prevent drawing invalid polygons on some
+                // platforms
+                zone->UnFill();
+            };
+
+    for( ZONE* zone : zones )
+        prepareZone( zone, toFill );
 
     auto check_fill_dependency =
             [&]( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone ) -> bool
@@ -518,7 +537,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
                 // Check for any fill dependencies.  If our zone needs to be clipped by
                 // another zone then we can't fill until that zone is filled.
-                for( ZONE* otherZone : aZones )
+                for( ZONE* otherZone : zones )
                 {
                     if( otherZone == zone )
                         continue;
@@ -543,6 +562,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                     if( !zoneLock.owns_lock() )
                         return 0;
 
+                    // Scratch memory of the fill's vertex sets, freed at once when we're
+                    // done.  The knockout and fill polygons don't use it.
+                    GEOMETRY_ARENA arena;
                     SHAPE_POLY_SET fillPolys;
 
                     if( !fillSingleZone( zone, layer, fillPolys ) )
@@ -572,6 +594,8 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                     if( !zoneLock.owns_lock() )
                         return 0;
 
+                    GEOMETRY_ARENA arena;
+
                     zone->CacheTriangulation( layer );
                     zone->SetFillFlag( layer, true );
                 }
@@ -581,73 +605,128 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
     // Calculate the copper fills (NB: this is multi-threaded)
     //
-    std::vector<std::pair<std::future<int>, int>> returns;
-    returns.reserve( toFill.size() );
-    size_t finished = 0;
-    bool cancelled = false;
-
+    bool         cancelled = false;
     thread_pool& tp = GetKiCadThreadPool();
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
-        returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
+    auto runFills =
+            [&]( const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aFillItems )
+            {
+                std::vector<std::pair<std::future<int>, int>> returns;
+                returns.reserve( aFillItems.size() );
+                size_t finished = 0;
 
-    while( !cancelled && finished != 2 * toFill.size() )
-    {
-        for( size_t ii = 0; ii < returns.size(); ++ii )
-        {
-            auto& ret = returns[ii];
+                for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : aFillItems )
+                    returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
 
-            if( ret.second > 1 )
-                continue;
+                while( !cancelled && finished != 2 * aFillItems.size() )
+                {
+                    for( size_t ii = 0; ii < returns.size(); ++ii )
+                    {
+                        auto& ret = returns[ii];
 
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+                        if( ret.second > 1 )
+                            continue;
 
-            if( status == std::future_status::ready )
-            {
-                if( ret.first.get() )   // lambda completed
-                {
-                    ++finished;
-                    ret.second++;       // go to next step
-                }
+                        std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
 
-                if( !cancelled )
-                {
-                    // Queue the next step (will re-queue the existing step if it didn't complete)
-                    if( ret.second == 0 )
-                        returns[ii].first = tp.submit( fill_lambda, toFill[ii] );
-                    else if( ret.second == 1 )
-                        returns[ii].first = tp.submit( tesselate_lambda, toFill[ii] );
+                        if( status == std::future_status::ready )
+                        {
+                            if( ret.first.get() )   // lambda completed
+                            {
+                                ++finished;
+                                ret.second++;       // go to next step
+                            }
+
+                            if( !cancelled )
+                            {
+                                // Queue the next step (will re-queue the existing step if it
+                                // didn't complete)
+                                if( ret.second == 0 )
+                                    ret.first = tp.submit( fill_lambda, aFillItems[ii] );
+                                else if( ret.second == 1 )
+                                    ret.first = tp.submit( tesselate_lambda, aFillItems[ii] );
+                            }
+                        }
+                    }
+
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+
+                    if( m_progressReporter )
+                    {
+                        m_progressReporter->KeepRefreshing();
+
+                        if( m_progressReporter->IsCancelled() )
+                            cancelled = true;
+                    }
                 }
-            }
-        }
 
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                // Make sure that all futures have finished.
+                // This can happen when the user cancels the above operation
+                for( auto& ret : returns )
+                {
+                    if( ret.first.valid() )
+                    {
+                        std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
 
+                        while( status != std::future_status::ready )
+                        {
+                            if( m_progressReporter )
+                                m_progressReporter->KeepRefreshing();
 
-        if( m_progressReporter )
-        {
-            m_progressReporter->KeepRefreshing();
+                            status = ret.first.wait_for( std::chrono::milliseconds( 100 ) );
+                        }
+                    }
+                }
+            };
 
-            if( m_progressReporter->IsCancelled() )
-                cancelled = true;
-        }
-    }
+    runFills( toFill );
 
-    // Make sure that all futures have finished.
-    // This can happen when the user cancels the above operation
-    for( auto& ret : returns )
+    // Lower-priority zones on other nets are knocked out by the *fills* of the zones we just
+    // refilled.  When only some zones are being refilled (for instance after an edit), any such
+    // zone outside the set must be refilled as well -- but only if the fill it depends on
+    // actually changed.  Repeat until the fills settle.
+    if( !aCheck )
     {
-        if( ret.first.valid() )
+        std::set<ZONE*>                             filling( zones.begin(), zones.end() );
+        std::vector<std::pair<ZONE*, PCB_LAYER_ID>> lastPass = toFill;
+
+        while( !cancelled && !lastPass.empty() )
         {
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+            std::vector<std::pair<ZONE*, PCB_LAYER_ID>> nextPass;
 
-            while( status != std::future_status::ready )
+            for( const auto& [ zone, layer ] : lastPass )
             {
-                if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
+                zone->BuildHashValue( layer );
+
+                if( oldFillHashes[ { zone, layer } ] == zone->GetHashValue( layer ) )
+                    continue;
+
+                BOX2I inflatedBBox = zone->GetBoundingBox();
+                inflatedBBox.Inflate( m_worstClearance );
+
+                // Board and footprint zones alike, from the zone index
+                for( ZONE* candidate : queryZones( layer, inflatedBBox ) )
+                {
+                    if( filling.count( candidate ) )
+                        continue;
 
-                status = ret.first.wait_for( std::chrono::milliseconds( 100 ) );
+                    // Same test as check_fill_dependency(), which can't be used here as the
+                    // zone's fill flag is already set
+                    if( !candidate->GetIsRuleArea() && candidate->GetNumCorners() > 2
+                            && !candidate->HigherPriority( zone ) && !candidate->SameNet( zone )
+                            && candidate->Outline()->Collide( zone->Outline(), m_worstClearance ) )
+                    {
+                        filling.insert( candidate );
+                        zones.push_back( candidate );
+                        prepareZone( candidate, nextPass );
+                    }
+                }
             }
+
+            runFills( nextPass );
+            toFill.insert( toFill.end(), nextPass.begin(), nextPass.end() );
+            lastPass = std::move( nextPass );
         }
     }
 
@@ -671,7 +750,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    for( ZONE* zone : aZones )
+    for( ZONE* zone : zones )
     {
         // Keepout zones are not filled
         if( zone->GetIsRuleArea() )
@@ -746,9 +825,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, double>> polys_to_check;
 
     // rough estimate to save re-allocation time
-    polys_to_check.reserve( m_board->GetCopperLayerCount() * aZones.size() );
+    polys_to_check.reserve( m_board->GetCopperLayerCount() * zones.size() );
 
-    for( ZONE* zone : aZones )
+    for( ZONE* zone : zones )
     {
         // Don't check for connections on layers that only exist in the zone but
         // were disabled in the board
@@ -847,7 +926,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         }
     }
 
-    for( ZONE* zone : aZones )
+    for( ZONE* zone : zones )
         zone->CalculateFilledArea();
 
 
@@ -855,7 +934,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     {
         bool outOfDate = false;
 
-        for( ZONE* zone : aZones )
+        for( ZONE* zone : zones )
         {
             // Keepout zones are not filled
             if( zone->GetIsRuleArea() )
@@ -907,27 +986,24 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
  */
 void ZONE_FILLER::addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_POLY_SET& aHoles )
 {
-    if( aPad->GetShape() == PAD_SHAPE::CUSTOM )
+    // the pad shape in zone can be its convex hull or the shape itself
+    if( aPad->GetShape() == PAD_SHAPE::CUSTOM
+            && aPad->GetCustomShapeInZoneOpt() == PADSTACK::CUSTOM_SHAPE_ZONE_MODE::CONVEXHULL )
     {
         SHAPE_POLY_SET poly;
         aPad->TransformShapeToPolygon( poly, aLayer, aGap, m_maxError, ERROR_OUTSIDE );
 
-        // the pad shape in zone can be its convex hull or the shape itself
-        if( aPad->GetCustomShapeInZoneOpt() == PADSTACK::CUSTOM_SHAPE_ZONE_MODE::CONVEXHULL )
-        {
-            std::vector<VECTOR2I> convex_hull;
-            BuildConvexHull( convex_hull, poly );
+        std::vector<VECTOR2I> convex_hull;
+        BuildConvexHull( convex_hull, poly );
 
-            aHoles.NewOutline();
+        aHoles.NewOutline();
 
-            for( const VECTOR2I& pt : convex_hull )
-                aHoles.Append( pt );
-        }
-        else
-            aHoles.Append( poly );
+        for( const VECTOR2I& pt : convex_hull )
+            aHoles.Append( pt );
     }
     else
     {
+        // Shapes are appended straight to the knockouts rather than through a temporary set
         aPad->TransformShapeToPolygon( aHoles, aLayer, aGap, m_maxError, ERROR_OUTSIDE );
     }
 }
@@ -1450,22 +1526,23 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                         gap = std::max( gap, evalRulesForItems( CLEARANCE_CONSTRAINT,
                                                                 aZone, aKnockout, aLayer ) );
 
-                        SHAPE_POLY_SET poly;
-                        aKnockout->TransformShapeToPolygon( poly, aLayer, gap + extra_margin,
+                        aKnockout->TransformShapeToPolygon( aHoles, aLayer, gap + extra_margin,
                                                             m_maxError, ERROR_OUTSIDE );
-                        aHoles.Append( poly );
                     }
                 }
             };
 
-    for( ZONE* otherZone : m_board->Zones() )
+    for( ZONE* otherZone : queryZones( aLayer, zone_boundingbox ) )
     {
         if( checkForCancel( m_progressReporter ) )
             return;
 
         // Negative clearance permits zones to short
-        if( evalRulesForItems( CLEARANCE_CONSTRAINT, aZone, otherZone, aLayer ) < 0 )
+        if( !otherZone->GetParentFootprint()
+                && evalRulesForItems( CLEARANCE_CONSTRAINT, aZone, otherZone, aLayer ) < 0 )
+        {
             continue;
+        }
 
         if( otherZone->GetIsRuleArea() )
         {
@@ -1479,26 +1556,6 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
         }
     }
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        for( ZONE* otherZone : footprint->Zones() )
-        {
-            if( checkForCancel( m_progressReporter ) )
-                return;
-
-            if( otherZone->GetIsRuleArea() )
-            {
-                if( otherZone->GetDoNotAllowCopperPour() && !aZone->IsTeardropArea() )
-                    knockoutZoneClearance( otherZone );
-            }
-            else if( otherZone->HigherPriority( aZone ) )
-            {
-                if( !otherZone->SameNet( aZone ) )
-                    knockoutZoneClearance( otherZone );
-            }
-        }
-    }
-
     aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
 }
 
@@ -1531,34 +1588,90 @@ void ZONE_FILLER::subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID a
                 }
             };
 
-    for( ZONE* otherZone : m_board->Zones() )
+    for( ZONE* otherZone : queryZones( aLayer, zoneBBox ) )
     {
-        // Don't use the `HigherPriority()` check here because we _only_ want to knock out zones
-        // with explicitly higher priorities, not those with equal priorities
-        if( otherZone->SameNet( aZone )
-                && otherZone->GetAssignedPriority() > aZone->GetAssignedPriority() )
+        if( !otherZone->SameNet( aZone ) )
+            continue;
+
+        // Don't use the `HigherPriority()` check for board zones because we _only_ want to
+        // knock out zones with explicitly higher priorities, not those with equal priorities
+        if( otherZone->GetParentFootprint() ? otherZone->HigherPriority( aZone )
+                                            : otherZone->GetAssignedPriority()
+                                                      > aZone->GetAssignedPriority() )
         {
             // Do not remove teardrop area: it is not useful and not good
             if( !otherZone->IsTeardropArea() )
                 knockoutZoneOutline( otherZone );
         }
     }
+}
+
+
+void ZONE_FILLER::buildZoneIndex()
+{
+    m_indexedZones.clear();
+    m_zoneIndex.clear();
+
+    for( ZONE* zone : m_board->Zones() )
+        m_indexedZones.push_back( zone );
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
-        for( ZONE* otherZone : footprint->Zones() )
-        {
-            if( otherZone->SameNet( aZone ) && otherZone->HigherPriority( aZone ) )
-            {
-                // Do not remove teardrop area: it is not useful and not good
-                if( !otherZone->IsTeardropArea() )
-                    knockoutZoneOutline( otherZone );
-            }
-        }
+        for( ZONE* zone : footprint->Zones() )
+            m_indexedZones.push_back( zone );
+    }
+
+    for( int ii = 0; ii < (int) m_indexedZones.size(); ++ii )
+    {
+        ZONE*       zone = m_indexedZones[ii];
+        const BOX2I bbox = zone->GetBoundingBox();
+        const int   mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int   mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        zone->GetLayerSet().RunOnLayers(
+                [&]( PCB_LAYER_ID layer )
+                {
+                    std::unique_ptr<ZONE_RTREE>& tree = m_zoneIndex[ layer ];
+
+                    if( !tree )
+                        tree = std::make_unique<ZONE_RTREE>();
+
+                    tree->Insert( mmin, mmax, ii );
+                } );
     }
 }
 
 
+std::vector<ZONE*> ZONE_FILLER::queryZones( PCB_LAYER_ID aLayer, const BOX2I& aBBox ) const
+{
+    std::vector<ZONE*> result;
+    auto               it = m_zoneIndex.find( aLayer );
+
+    if( it == m_zoneIndex.end() )
+        return result;
+
+    const int   mmin[2] = { aBBox.GetX(), aBBox.GetY() };
+    const int   mmax[2] = { aBBox.GetRight(), aBBox.GetBottom() };
+    std::vector<int> hits;
+
+    it->second->Search( mmin, mmax,
+            [&]( const int& aIndex )
+            {
+                hits.push_back( aIndex );
+                return true;
+            } );
+
+    // Keep the results in board order so that ties are resolved as they always were
+    std::sort( hits.begin(), hits.end() );
+    result.reserve( hits.size() );
+
+    for( int idx : hits )
+        result.push_back( m_indexedZones[idx] );
+
+    return result;
+}
+
+
 void ZONE_FILLER::connect_nearby_polys( SHAPE_POLY_SET& aPolys, double aDistance )
 {
     if( aPolys.OutlineCount() < 1 )
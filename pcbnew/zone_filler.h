@@ -26,7 +26,10 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <map>
+#include <memory>
 #include <vector>
+#include <geometry/rtree.h>
 #include <zone.h>
 
 class PROGRESS_REPORTER;
@@ -54,6 +57,9 @@ public:
      * installed.
      *
      * Caller is also responsible for re-building connectivity afterwards.
+     *
+     * Unless \a aCheck is set, zones outside of \a aZones whose fills are knocked out by a fill
+     * which changed are refilled as well (and added to the commit).
      */
     bool Fill( const std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
@@ -79,6 +85,18 @@ private:
     void subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                       SHAPE_POLY_SET& aRawFill );
 
+    /**
+     * Build a per-layer spatial index of the board and footprint zones (rule areas included)
+     * from their cached bounding boxes.
+     */
+    void buildZoneIndex();
+
+    /**
+     * Return the indexed zones on \a aLayer whose bounding boxes intersect \a aBBox, in board
+     * order (board zones first, then footprint zones).
+     */
+    std::vector<ZONE*> queryZones( PCB_LAYER_ID aLayer, const BOX2I& aBBox ) const;
+
     /**
      * Function fillCopperZone
      * Add non copper areas polygons (pads and tracks with clearance)
@@ -145,6 +163,11 @@ private:
     int                   m_worstClearance;
 
     bool                  m_debugZoneFiller;
+
+    using ZONE_RTREE = RTree<int, int, 2, double>;
+
+    std::vector<ZONE*>                                  m_indexedZones;
+    std::map<PCB_LAYER_ID, std::unique_ptr<ZONE_RTREE>> m_zoneIndex;
 };
 
 #endif
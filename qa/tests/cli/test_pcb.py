@@ -25,6 +25,8 @@ import utils
 from pathlib import Path
 import pytest
 import re
+import os
+import shutil
 from typing import List, Tuple
 from conftest import KiTestFixture
 import sys
@@ -139,3 +141,89 @@ def test_pcb_export_gerber( kitest: KiTestFixture,
         # Comparison DPI = 5080 => 1px == 5um. I.e. allowable error of 15 um after eroding
         assert utils.gerbers_are_equivalent( str( generated_gerber_path ), gbr_source_path, 5080,
                                              originInches, windowsizeInches )
+
+
+def plot_dirs_are_identical( dir1: Path, dir2: Path ) -> bool:
+    """Compare two directories of plot files byte for byte, except for their creation dates"""
+    dated_lines = [ b'CreationDate', b'G04 Created by KiCad', b'; DRILL file {', b'created on',
+                    b'<title>SVG Image created as' ]
+
+    def read_undated( path: Path ) -> bytes:
+        with open( path, 'rb' ) as f:
+            return b''.join( line for line in f.readlines()
+                             if not any( dated in line for dated in dated_lines ) )
+
+    names1 = sorted( os.listdir( dir1 ) )
+    names2 = sorted( os.listdir( dir2 ) )
+
+    if names1 != names2 or len( names1 ) == 0:
+        return False
+
+    return all( read_undated( dir1 / name ) == read_undated( dir2 / name ) for name in names1 )
+
+
+@pytest.mark.parametrize("test_file",
+                         [
+                            "cli/artwork_generation_regressions/ZoneFill-4.0.7.kicad_pcb",
+                            "cli/artwork_generation_regressions/ZoneFill-Legacy.brd"
+                         ])
+def test_pcb_export_gerbers_parallel( kitest: KiTestFixture,
+                                      test_file: str ):
+
+    input_file = kitest.get_data_file_path( test_file )
+    output_dir = kitest.get_output_path( "cli/export_gerbers_parallel/{}/".format( Path( input_file ).stem ) )
+    parallel_dir = output_dir / "parallel"
+    serial_dir = output_dir / "serial"
+
+    # Plot the drawing sheet and a common layer on every layer, so that the layers share items
+    for plot_dir, extra_args in [ ( parallel_dir, [] ), ( serial_dir, ["--sequential"] ) ]:
+        shutil.rmtree( plot_dir, ignore_errors=True )
+        os.makedirs( plot_dir )
+
+        command = ["kicad-cli", "pcb", "export", "gerbers", "--ibt", "--cl", "Edge.Cuts",
+                   *extra_args, "-o", str( plot_dir ) + "/", input_file]
+
+        stdout, stderr, exitcode = utils.run_and_capture( command )
+        assert exitcode == 0
+
+    assert plot_dirs_are_identical( parallel_dir, serial_dir )
+
+
+def test_pcb_batch_matches_individual_runs( kitest: KiTestFixture ):
+
+    input_file = kitest.get_data_file_path( "cli/artwork_generation_regressions/ZoneFill-4.0.7.kicad_pcb" )
+    output_dir = kitest.get_output_path( "cli/batch/" )
+    batch_dir = output_dir / "batch"
+    single_dir = output_dir / "single"
+
+    # The variable override of the first job must not leak into the jobs that follow it, and the
+    # read-only jobs in between must not be reordered around the plotters
+    jobs = [ ( "gerbers_var", "export gerbers --ibt -D BATCH_TEST_VAR=first -o {}/" ),
+             ( "drill", "export drill -o {}/" ),
+             ( "pos", "export pos -o {}/board.pos" ),
+             ( "svg", "export svg --layers F.Cu,Edge.Cuts -o {}/board.svg" ),
+             ( "gerbers", "export gerbers --ibt -o {}/" ) ]
+
+    for run_dir in [ batch_dir, single_dir ]:
+        shutil.rmtree( run_dir, ignore_errors=True )
+
+        for name, _ in jobs:
+            os.makedirs( run_dir / name )
+
+    jobs_file = output_dir / "jobs.txt"
+
+    with open( jobs_file, 'w' ) as f:
+        for name, job in jobs:
+            f.write( job.format( batch_dir / name ) + "\n" )
+
+    command = ["kicad-cli", "pcb", "batch", "--jobs", str( jobs_file ), input_file]
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode == 0
+
+    for name, job in jobs:
+        command = ["kicad-cli", "pcb", *job.format( single_dir / name ).split(), input_file]
+        stdout, stderr, exitcode = utils.run_and_capture( command )
+        assert exitcode == 0
+
+    for name, _ in jobs:
+        assert plot_dirs_are_identical( batch_dir / name, single_dir / name )
@@ -126,4 +126,55 @@ BOOST_AUTO_TEST_CASE( DecompressAndDecode_ChecksumError )
     BOOST_CHECK_EQUAL(result, EMBEDDED_FILES::RETURN_CODE::CHECKSUM_ERROR);
 }
 
+BOOST_AUTO_TEST_CASE( ParseEmbedded_Deferred )
+{
+    EMBEDDED_FILES files;
+    EMBEDDED_FILES::EMBEDDED_FILE* file = new EMBEDDED_FILES::EMBEDDED_FILE();
+    file->name = "test_file";
+    std::string data = "Hello, World!";
+    file->decompressedData.assign( data.begin(), data.end() );
+
+    BOOST_CHECK_EQUAL( EMBEDDED_FILES::CompressAndEncode( *file ),
+                       EMBEDDED_FILES::RETURN_CODE::OK );
+    files.AddFile( file );
+
+    STRING_FORMATTER formatter;
+    files.WriteEmbeddedFiles( formatter, 0, true );
+
+    // Skip the opening parenthesis and token, as the board and schematic parsers do
+    STRING_LINE_READER    reader( formatter.GetString(), "test" );
+    EMBEDDED_FILES_PARSER parser( &reader );
+    EMBEDDED_FILES        loaded;
+
+    parser.NeedLEFT();
+    parser.NextTok();
+    parser.ParseEmbedded( &loaded );
+
+    EMBEDDED_FILES::EMBEDDED_FILE* loadedFile = loaded.GetEmbeddedFile( "test_file" );
+    BOOST_REQUIRE( loadedFile );
+
+    // The payload is only decoded when first used
+    BOOST_CHECK( loadedFile->is_compressed_only );
+    BOOST_CHECK( loadedFile->decompressedData.empty() );
+
+    // And written back as it was read
+    STRING_FORMATTER rewritten;
+    loaded.WriteEmbeddedFiles( rewritten, 0, true );
+    BOOST_CHECK_EQUAL( rewritten.GetString(), formatter.GetString() );
+
+    BOOST_CHECK( loadedFile->EnsureDecompressed() );
+    BOOST_CHECK( !loadedFile->is_compressed_only );
+    BOOST_CHECK( std::string( loadedFile->decompressedData.begin(),
+                              loadedFile->decompressedData.end() ) == data );
+
+    // A corrupted payload is caught when decoded
+    EMBEDDED_FILES::EMBEDDED_FILE corrupted = *loadedFile;
+    corrupted.decompressedData.clear();
+    corrupted.data_sha[0] = corrupted.data_sha[0] == 'x' ? 'y' : 'x';
+    corrupted.is_compressed_only = true;
+
+    BOOST_CHECK( !corrupted.EnsureDecompressed() );
+    BOOST_CHECK( !corrupted.is_valid );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
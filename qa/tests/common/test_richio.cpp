@@ -30,6 +30,11 @@
 
 // Code under test
 #include <richio.h>
+#include <dsnlexer.h>
+
+#include <fstream>
+
+#include <wx/filename.h>
 
 /**
  * Declare the test suite
@@ -80,4 +85,152 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+/**
+ * A mapped file must read the same lines and lex the same tokens as a #FILE_LINE_READER,
+ * including an unterminated last line.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    const std::string content = "(kicad_pcb (version 20240108)\n"
+                                "\n"
+                                "  (segment (start 1.5 -2.25e1) (end 3 4) (width 0.2) (net 12)\n"
+                                "    (uuid \"3b1f6b0e-9d3c-4e0a\") (locked yes))\n"
+                                "  (gr_text \"a \\\"quoted\\\" (string)\" (layer \"F.SilkS\"))\n"
+                                ")";
+
+    wxString fileName = wxFileName::CreateTempFileName( wxT( "kicad_qa_richio" ) );
+
+    {
+        std::ofstream out( fileName.fn_str(), std::ios::binary );
+        out << content;
+    }
+
+    {
+        FILE_LINE_READER        fileReader( fileName );
+        MAPPED_FILE_LINE_READER mappedReader( fileName );
+
+        BOOST_CHECK_EQUAL( mappedReader.CountLines(), 6 );
+
+        while( fileReader.ReadLine() )
+        {
+            BOOST_REQUIRE( mappedReader.ReadLine() );
+            BOOST_CHECK_EQUAL( std::string( mappedReader.Line() ), fileReader.Line() );
+            BOOST_CHECK_EQUAL( mappedReader.LineNumber(), fileReader.LineNumber() );
+        }
+
+        BOOST_CHECK( !mappedReader.ReadLine() );
+
+        mappedReader.Rewind();
+        fileReader.Rewind();
+
+        DSNLEXER fileLexer( nullptr, 0, nullptr, &fileReader );
+        DSNLEXER mappedLexer( nullptr, 0, nullptr, &mappedReader );
+        int      tok;
+
+        do
+        {
+            tok = fileLexer.NextTok();
+
+            BOOST_REQUIRE_EQUAL( mappedLexer.NextTok(), tok );
+            BOOST_CHECK_EQUAL( mappedLexer.CurStr(), fileLexer.CurStr() );
+            BOOST_CHECK( mappedLexer.CurView() == fileLexer.CurView() );
+            BOOST_CHECK_EQUAL( mappedLexer.CurLineNumber(), fileLexer.CurLineNumber() );
+            BOOST_CHECK_EQUAL( mappedLexer.CurOffset(), fileLexer.CurOffset() );
+        } while( tok != DSN_EOF );
+    }
+
+    wxRemoveFile( fileName );
+}
+
+
+/**
+ * An empty file maps to nothing at all; it must still read as having no lines.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReaderEmpty )
+{
+    wxString fileName = wxFileName::CreateTempFileName( wxT( "kicad_qa_richio" ) );
+
+    {
+        std::ofstream out( fileName.fn_str(), std::ios::binary );
+    }
+
+    {
+        MAPPED_FILE_LINE_READER mappedReader( fileName );
+
+        BOOST_CHECK_EQUAL( mappedReader.CountLines(), 0 );
+        BOOST_CHECK( mappedReader.ReadLineView().empty() );
+        BOOST_CHECK( !mappedReader.ReadLine() );
+        BOOST_CHECK_EQUAL( mappedReader.LineNumber(), 2 );
+
+        DSNLEXER lexer( nullptr, 0, nullptr, &mappedReader );
+
+        BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_EOF );
+    }
+
+    wxRemoveFile( fileName );
+}
+
+
+/**
+ * A list read raw must lex to the same tokens, on the same lines, as the original text and
+ * leave the lexer just after the list.
+ */
+BOOST_AUTO_TEST_CASE( ReadRawList )
+{
+    const std::string content = "(kicad_pcb\n"
+                                "  (footprint \"a (b\" (pad \"\\\")\" 1)\n"
+                                "# ) a comment (\n"
+                                "    (at 1 2)) (zone)\n"
+                                ")\n";
+
+    STRING_LINE_READER reader( content, wxT( "raw list" ) );
+    STRING_LINE_READER reference( content, wxT( "raw list" ) );
+    DSNLEXER           lexer( nullptr, 0, nullptr, &reader );
+    DSNLEXER           refLexer( nullptr, 0, nullptr, &reference );
+
+    for( int ii = 0; ii < 4; ++ii )
+    {
+        lexer.NextTok();
+        refLexer.NextTok();
+    }
+
+    BOOST_REQUIRE_EQUAL( lexer.CurStr(), "footprint" );
+
+    std::string text;
+    int         lineNumber = lexer.ReadRawList( text );
+
+    BOOST_CHECK_EQUAL( lineNumber, 2 );
+    BOOST_CHECK_EQUAL( lexer.CurTok(), DSN_RIGHT );
+
+    STRING_LINE_READER listReader( std::move( text ), wxT( "raw list" ), lineNumber );
+    DSNLEXER           listLexer( nullptr, 0, nullptr, &listReader );
+
+    BOOST_CHECK_EQUAL( listLexer.NextTok(), DSN_LEFT );
+    BOOST_CHECK_EQUAL( listLexer.NextTok(), refLexer.CurTok() );
+    BOOST_CHECK_EQUAL( listLexer.CurOffset(), refLexer.CurOffset() );
+
+    for( int depth = 1; depth > 0; )
+    {
+        int tok = refLexer.NextTok();
+
+        BOOST_REQUIRE_EQUAL( listLexer.NextTok(), tok );
+        BOOST_CHECK_EQUAL( listLexer.CurStr(), refLexer.CurStr() );
+        BOOST_CHECK_EQUAL( listLexer.CurLineNumber(), refLexer.CurLineNumber() );
+        BOOST_CHECK_EQUAL( listLexer.CurOffset(), refLexer.CurOffset() );
+
+        if( tok == DSN_LEFT )
+            ++depth;
+        else if( tok == DSN_RIGHT )
+            --depth;
+    }
+
+    BOOST_CHECK_EQUAL( listLexer.NextTok(), DSN_EOF );
+
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_EQUAL( lexer.CurStr(), "zone" );
+    BOOST_CHECK_EQUAL( lexer.CurLineNumber(), 4 );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
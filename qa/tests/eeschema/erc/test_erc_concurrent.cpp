@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <schematic_utils/schematic_file_util.h>
+
+#include <core/thread_pool.h>
+#include <schematic.h>
+#include <sch_marker.h>
+#include <sch_screen.h>
+#include <erc/erc_settings.h>
+#include <erc/erc.h>
+#include <settings/settings_manager.h>
+#include <units_provider.h>
+#include <locale_io.h>
+
+
+struct ERC_CONCURRENT_TEST_FIXTURE
+{
+    ERC_CONCURRENT_TEST_FIXTURE() : m_settingsManager( true /* headless */ ) {}
+
+    /**
+     * Load a schematic, run all the ERC tests on it and describe the resulting markers, sheet
+     * by sheet, in the order they were added to the screens.
+     */
+    std::vector<wxString> runERC( const wxString& aSchematic )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, aSchematic, m_schematic );
+
+        ERC_TESTER tester( m_schematic.get() );
+        tester.RunTests( nullptr, nullptr, nullptr, &m_schematic->Prj(), nullptr );
+
+        UNITS_PROVIDER            unitsProvider( schIUScale, EDA_UNITS::MILLIMETRES );
+        ERC_SETTINGS&             settings = m_schematic->ErcSettings();
+        SCH_SHEET_LIST            sheetList = m_schematic->BuildSheetListSortedByPageNumbers();
+        std::map<KIID, EDA_ITEM*> itemMap;
+        std::vector<wxString>     markers;
+
+        sheetList.FillItemMap( itemMap );
+
+        for( const SCH_SHEET_PATH& sheet : sheetList )
+        {
+            for( SCH_ITEM* item : sheet.LastScreen()->Items().OfType( SCH_MARKER_T ) )
+            {
+                SCH_MARKER* marker = static_cast<SCH_MARKER*>( item );
+                RC_ITEM*    rcItem = marker->GetRCItem().get();
+
+                if( marker->GetMarkerType() != MARKER_BASE::MARKER_ERC )
+                    continue;
+
+                markers.push_back( sheet.PathHumanReadable() + wxS( ": " )
+                                   + rcItem->ShowReport( &unitsProvider,
+                                                         settings.GetSeverity(
+                                                                 rcItem->GetErrorCode() ),
+                                                         itemMap ) );
+            }
+        }
+
+        return markers;
+    }
+
+    SETTINGS_MANAGER           m_settingsManager;
+    std::unique_ptr<SCHEMATIC> m_schematic;
+};
+
+
+/**
+ * The ERC tests which only read the schematic run on the thread pool, and TestPinToPin() tests
+ * the nets there.  Their markers must come out as when everything runs on a single thread:
+ * the same markers, in the same order.
+ */
+BOOST_FIXTURE_TEST_CASE( ERCConcurrentMatchesSingleThread, ERC_CONCURRENT_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    std::vector<wxString> tests = { "issue10926_1",
+                                    "ERC_dynamic_power_symbol_test",
+                                    "netlists/complex_hierarchy/complex_hierarchy",
+                                    "netlists/complex_hierarchy_shared/complex_hierarchy",
+                                    "netlists/video/video" };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         threadCount = tp.get_thread_count();
+
+    for( const wxString& test : tests )
+    {
+        BOOST_TEST_CONTEXT( test.ToStdString() )
+        {
+            tp.reset( 1 );
+            std::vector<wxString> serial = runERC( test );
+            tp.reset( threadCount );
+            std::vector<wxString> concurrent = runERC( test );
+
+            BOOST_CHECK_EQUAL_COLLECTIONS( concurrent.begin(), concurrent.end(), serial.begin(),
+                                           serial.end() );
+        }
+    }
+}
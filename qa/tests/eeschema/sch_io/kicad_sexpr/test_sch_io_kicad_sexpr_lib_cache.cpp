@@ -0,0 +1,239 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+/**
+ * @file test_sch_io_kicad_sexpr_lib_cache.cpp
+ * Test suite for the lazy loading of #SCH_IO_KICAD_SEXPR_LIB_CACHE
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <lib_symbol.h>
+#include <richio.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+
+
+/**
+ * Write a symbol library of root, power and derived symbols, with a symbol which cannot be
+ * parsed if \a aBroken is set.
+ */
+static wxString writeLibrary( const std::string& aFileName, bool aBroken )
+{
+    auto rootSymbol =
+            []( const std::string& aName, bool aPower, bool aBrokenPin )
+            {
+                return "  (symbol \"" + aName + "\"" + ( aPower ? " (power)" : "" )
+                       + " (in_bom yes) (on_board yes)\n"
+                       + "    (property \"Reference\" \"" + ( aPower ? "#PWR" : "U" )
+                       + "\" (at 0 0 0)\n"
+                       + "      (effects (font (size 1.27 1.27)))\n"
+                       + "    )\n"
+                       + "    (property \"Value\" \"" + aName + "\" (at 0 0 0)\n"
+                       + "      (effects (font (size 1.27 1.27)))\n"
+                       + "    )\n"
+                       + "    (symbol \"" + aName + "_1_1\"\n"
+                       + "      (pin power_in line (at 0 0 0) (length "
+                       + ( aBrokenPin ? "oops" : "2.54" ) + ")\n"
+                       + "        (name \"P\" (effects (font (size 1.27 1.27))))\n"
+                       + "        (number \"1\" (effects (font (size 1.27 1.27))))\n"
+                       + "      )\n"
+                       + "    )\n"
+                       + "  )\n";
+            };
+
+    auto derivedSymbol =
+            []( const std::string& aName, const std::string& aParent )
+            {
+                return "  (symbol \"" + aName + "\" (extends \"" + aParent + "\")\n"
+                       + "    (property \"Reference\" \"U\" (at 0 0 0)\n"
+                       + "      (effects (font (size 1.27 1.27)))\n"
+                       + "    )\n"
+                       + "    (property \"Value\" \"" + aName + "\" (at 0 0 0)\n"
+                       + "      (effects (font (size 1.27 1.27)))\n"
+                       + "    )\n"
+                       + "  )\n";
+            };
+
+    std::string text = "(kicad_symbol_lib (version 20231120) (generator \"kicad_symbol_editor\") "
+                       "(generator_version \"8.0\")\n";
+
+    // Names which don't sort in file order, with derived symbols of power and other symbols
+    for( int ii = 40; ii > 0; --ii )
+    {
+        std::string name = "SYM_" + std::to_string( ii );
+
+        if( ii % 3 == 0 )
+            text += derivedSymbol( name, "SYM_" + std::to_string( ii + 1 ) );
+        else
+            text += rootSymbol( name, ii % 5 == 0 || ii % 5 == 1, false );
+    }
+
+    if( aBroken )
+    {
+        text += rootSymbol( "BROKEN", false, true );
+        text += derivedSymbol( "BROKEN_CHILD", "BROKEN" );
+    }
+
+    text += ")\n";
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / aFileName;
+    std::ofstream         file( path, std::ios::binary );
+
+    file << text;
+    file.close();
+
+    return wxString( path.string() );
+}
+
+
+static std::string formatSymbol( LIB_SYMBOL* aSymbol )
+{
+    STRING_FORMATTER formatter;
+
+    SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( aSymbol, formatter );
+    return formatter.GetString();
+}
+
+
+BOOST_AUTO_TEST_SUITE( SchIoKicadSexprLibCache )
+
+
+BOOST_AUTO_TEST_CASE( LazyLoadMatchesFullLoad )
+{
+    wxString fileName = writeLibrary( "lazy_symbol_lib_tst.kicad_sym", false );
+
+    SCH_IO_KICAD_SEXPR_LIB_CACHE full( fileName );
+    SCH_IO_KICAD_SEXPR_LIB_CACHE lazy( fileName );
+
+    full.Load();
+    lazy.SetLazyLoading( true );
+    lazy.Load();
+
+    // Only the first symbol is parsed, which checks the library was indexed
+    BOOST_CHECK_EQUAL( lazy.GetSymbolMap().size(), 1 );
+
+    for( bool powerOnly : { false, true } )
+    {
+        wxArrayString fullNames;
+        wxArrayString lazyNames;
+
+        full.GetSymbolNames( fullNames, powerOnly );
+        lazy.GetSymbolNames( lazyNames, powerOnly );
+
+        BOOST_CHECK( fullNames == lazyNames );
+        BOOST_CHECK_EQUAL( lazy.GetSymbolMap().size(), 1 );
+    }
+
+    wxArrayString names;
+    full.GetSymbolNames( names, false );
+
+    BOOST_CHECK_EQUAL( names.size(), 40 );
+
+    for( const wxString& name : names )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            LIB_SYMBOL* fullSymbol = full.GetSymbol( name );
+            LIB_SYMBOL* lazySymbol = lazy.GetSymbol( name );
+
+            BOOST_REQUIRE( fullSymbol );
+            BOOST_REQUIRE( lazySymbol );
+
+            BOOST_CHECK_EQUAL( lazySymbol->IsPower(), fullSymbol->IsPower() );
+            BOOST_CHECK_EQUAL( lazySymbol->IsRoot(), fullSymbol->IsRoot() );
+
+            if( !fullSymbol->IsRoot() )
+            {
+                BOOST_REQUIRE( lazySymbol->GetParent().lock() );
+                BOOST_CHECK_EQUAL( lazySymbol->GetParent().lock()->GetName(),
+                                   fullSymbol->GetParent().lock()->GetName() );
+            }
+
+            BOOST_CHECK_EQUAL( formatSymbol( lazySymbol ), formatSymbol( fullSymbol ) );
+        }
+    }
+
+    BOOST_CHECK_EQUAL( lazy.GetSymbolMap().size(), full.GetSymbolMap().size() );
+}
+
+
+BOOST_AUTO_TEST_CASE( LazyLoadParseErrors )
+{
+    wxString fileName = writeLibrary( "lazy_symbol_lib_error_tst.kicad_sym", true );
+    int      errorLine = 0;
+    int      errorOffset = 0;
+
+    SCH_IO_KICAD_SEXPR_LIB_CACHE full( fileName );
+
+    try
+    {
+        full.Load();
+        BOOST_FAIL( "The broken library was loaded" );
+    }
+    catch( const PARSE_ERROR& error )
+    {
+        errorLine = error.lineNumber;
+        errorOffset = error.byteIndex;
+    }
+
+    BOOST_REQUIRE_GT( errorLine, 1 );
+
+    SCH_IO_KICAD_SEXPR_LIB_CACHE lazy( fileName );
+
+    lazy.SetLazyLoading( true );
+    lazy.Load();
+
+    wxArrayString names;
+    lazy.GetSymbolNames( names, false );
+
+    BOOST_CHECK_EQUAL( names.size(), 42 );
+
+    // The broken symbol stays in the library, so requesting it again, or a symbol derived
+    // from it, reports the same error.
+    for( const wxString& name : { wxString( "BROKEN" ), wxString( "BROKEN" ),
+                                  wxString( "BROKEN_CHILD" ) } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            try
+            {
+                lazy.GetSymbol( name );
+                BOOST_FAIL( "The broken symbol was loaded" );
+            }
+            catch( const PARSE_ERROR& error )
+            {
+                BOOST_CHECK_EQUAL( error.lineNumber, errorLine );
+                BOOST_CHECK_EQUAL( error.byteIndex, errorOffset );
+            }
+        }
+    }
+
+    names.clear();
+    lazy.GetSymbolNames( names, false );
+
+    BOOST_CHECK_EQUAL( names.size(), 42 );
+    BOOST_CHECK( lazy.GetSymbol( "SYM_12" ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
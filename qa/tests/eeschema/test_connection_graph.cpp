@@ -0,0 +1,229 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <schematic_utils/schematic_file_util.h>
+
+#include <connection_graph.h>
+#include <core/profile.h>
+#include <core/thread_pool.h>
+#include <schematic.h>
+#include <sch_connection.h>
+#include <sch_label.h>
+#include <sch_line.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <settings/settings_manager.h>
+#include <locale_io.h>
+
+struct CONNECTION_GRAPH_TEST_FIXTURE
+{
+    CONNECTION_GRAPH_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /**
+     * Rebuild the connection graph from scratch and describe its nets: the subgraphs of each
+     * net, with their sheet, driver and size, in the order the graph lists them.
+     *
+     * @param aMsecs if not null, receives the time the rebuild took.
+     */
+    std::vector<std::string> describeNets( double* aMsecs = nullptr )
+    {
+        SCH_SHEET_LIST    sheets = m_schematic->BuildSheetListSortedByPageNumbers();
+        CONNECTION_GRAPH* graph = m_schematic->ConnectionGraph();
+        PROF_TIMER        timer;
+
+        graph->Recalculate( sheets, true );
+
+        if( aMsecs )
+            *aMsecs = timer.msecs();
+
+        std::vector<std::string> nets;
+
+        for( const auto& [key, subgraphs] : graph->GetNetMap() )
+        {
+            std::string net = std::to_string( key.Netcode ) + " " + key.Name.ToStdString() + ":";
+
+            for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
+            {
+                const SCH_CONNECTION* driver = subgraph->GetDriverConnection();
+
+                net += " [" + subgraph->GetSheet().PathHumanReadable().ToStdString() + " "
+                       + ( driver ? driver->Name().ToStdString() : std::string( "<none>" ) )
+                       + " " + subgraph->GetNetName().ToStdString() + " "
+                       + std::to_string( subgraph->GetItems().size() ) + "]";
+            }
+
+            nets.push_back( net );
+        }
+
+        // The net map is unordered
+        std::sort( nets.begin(), nets.end() );
+
+        return nets;
+    }
+
+    SETTINGS_MANAGER           m_settingsManager;
+    std::unique_ptr<SCHEMATIC> m_schematic;
+};
+
+
+/**
+ * The sheets of different screens are updated, and their subgraphs built, on the thread pool.
+ * The graph must come out as when everything runs one step after the other.
+ *
+ * Both runs go through the same code, with the pool reset to a single thread for the serial
+ * one, so this checks that the scheduling doesn't matter.  The comparison with the results of
+ * the earlier, fully serial code is made by the netlist exporter tests against their golden
+ * netlists.
+ */
+BOOST_FIXTURE_TEST_CASE( ParallelBuildMatchesSerial, CONNECTION_GRAPH_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    std::vector<wxString> tests = { "bus_connection",
+                                    "bus_entries",
+                                    "complex_hierarchy",
+                                    "hierarchy_aliases",
+                                    "issue16003",
+                                    "legacy_power",
+                                    "multinetclasses",
+                                    "noconnects",
+                                    "test_global_promotion",
+                                    "test_hier_renaming",
+                                    "test_multiunit_reannotate",
+                                    "top_level_hier_pins",
+                                    "video",
+                                    "weak_vector_bus_disambiguation" };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         threadCount = tp.get_thread_count();
+
+    for( const wxString& test : tests )
+    {
+        BOOST_TEST_CONTEXT( test )
+        {
+            KI_TEST::LoadSchematic( m_settingsManager, "netlists/" + test + "/" + test,
+                                    m_schematic );
+
+            std::vector<std::string> parallel = describeNets();
+
+            tp.reset( 1 );
+            std::vector<std::string> serial = describeNets();
+            tp.reset( threadCount );
+
+            BOOST_CHECK( !parallel.empty() );
+            BOOST_CHECK_EQUAL_COLLECTIONS( parallel.begin(), parallel.end(), serial.begin(),
+                                           serial.end() );
+        }
+    }
+}
+
+
+/**
+ * Time the graph rebuild of a large synthetic hierarchy on a single thread and on the whole
+ * pool, once with a screen of its own for each sheet and once with every sheet sharing the
+ * same screen.  The second case is handled by a single task, so it isn't expected to gain
+ * anything.  The timings are reported as messages (run with --log_level=message).
+ */
+BOOST_FIXTURE_TEST_CASE( LargeHierarchyTimings, CONNECTION_GRAPH_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    const int sheetCount = 100;
+    const int netCount = 200;
+    const int pitch = schIUScale.MilsToIU( 100 );
+
+    auto populate =
+            [&]( SCH_SCREEN* aScreen )
+            {
+                for( int ii = 0; ii < netCount; ++ii )
+                {
+                    VECTOR2I  start( 0, ii * pitch );
+                    VECTOR2I  end( 10 * pitch, ii * pitch );
+                    SCH_LINE* wire = new SCH_LINE( start, LAYER_WIRE );
+
+                    wire->SetEndPoint( end );
+                    aScreen->Append( wire );
+                    aScreen->Append( new SCH_LABEL( start, wxString::Format( wxS( "N%d" ), ii ) ) );
+
+                    // Tie some of the nets together across the sheets
+                    if( ii % 10 == 0 )
+                    {
+                        aScreen->Append( new SCH_GLOBALLABEL( end,
+                                                              wxString::Format( wxS( "G%d" ),
+                                                                                ii ) ) );
+                    }
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         threadCount = tp.get_thread_count();
+
+    for( bool sharedScreen : { false, true } )
+    {
+        BOOST_TEST_CONTEXT( ( sharedScreen ? "shared screen" : "screen per sheet" ) )
+        {
+            KI_TEST::LoadSchematic( m_settingsManager, "netlists/noconnects/noconnects",
+                                    m_schematic );
+
+            SCH_SCREEN* shared = nullptr;
+
+            for( int ii = 0; ii < sheetCount; ++ii )
+            {
+                SCH_SCREEN* screen = shared;
+
+                if( !screen )
+                {
+                    screen = new SCH_SCREEN( m_schematic.get() );
+                    screen->SetFileName( wxString::Format( wxS( "synthetic_%d.kicad_sch" ), ii ) );
+                    populate( screen );
+
+                    if( sharedScreen )
+                        shared = screen;
+                }
+
+                SCH_SHEET* sheet = new SCH_SHEET( &m_schematic->Root(),
+                                                  VECTOR2I( ii * 20 * pitch, -20 * pitch ) );
+
+                sheet->SetScreen( screen );
+                sheet->SetFileName( screen->GetFileName() );
+                m_schematic->RootScreen()->Append( sheet );
+            }
+
+            double serialTime = 0.0;
+            double parallelTime = 0.0;
+
+            tp.reset( 1 );
+            std::vector<std::string> serial = describeNets( &serialTime );
+            tp.reset( threadCount );
+            std::vector<std::string> parallel = describeNets( &parallelTime );
+
+            BOOST_TEST_MESSAGE( ( sharedScreen ? "Shared screen" : "Screen per sheet" )
+                                << ": " << sheetCount << " sheets, " << serialTime
+                                << " ms on 1 thread, " << parallelTime << " ms on "
+                                << threadCount << " threads" );
+
+            BOOST_CHECK_EQUAL_COLLECTIONS( parallel.begin(), parallel.end(), serial.begin(),
+                                           serial.end() );
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/geometry_arena.h>
+#include <geometry/shape_poly_set.h>
+
+
+/**
+ * Triangulate an outline with a grid of holes, large enough to be partitioned into cells.
+ */
+static SHAPE_POLY_SET triangulatedGrid( bool aPartition )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( 0, 0 );
+    poly.Append( 50000000, 0 );
+    poly.Append( 50000000, 30000000 );
+    poly.Append( 0, 30000000 );
+
+    for( int x = 1000000; x < 50000000; x += 2000000 )
+    {
+        for( int y = 1000000; y < 30000000; y += 2000000 )
+        {
+            SHAPE_LINE_CHAIN hole( { VECTOR2I( x, y ), VECTOR2I( x + 500000, y ),
+                                     VECTOR2I( x + 500000, y + 700000 ) },
+                                   true );
+
+            poly.AddHole( hole );
+        }
+    }
+
+    poly.CacheTriangulation( aPartition );
+
+    return poly;
+}
+
+
+BOOST_AUTO_TEST_SUITE( GeometryArena )
+
+
+BOOST_AUTO_TEST_CASE( Nesting )
+{
+    BOOST_CHECK( GEOMETRY_ARENA::Current() == std::pmr::new_delete_resource() );
+
+    {
+        GEOMETRY_ARENA             outer;
+        std::pmr::memory_resource* outerResource = GEOMETRY_ARENA::Current();
+
+        BOOST_CHECK( outerResource != std::pmr::new_delete_resource() );
+
+        {
+            GEOMETRY_ARENA inner;
+
+            BOOST_CHECK( GEOMETRY_ARENA::Current() != outerResource );
+        }
+
+        BOOST_CHECK( GEOMETRY_ARENA::Current() == outerResource );
+    }
+
+    BOOST_CHECK( GEOMETRY_ARENA::Current() == std::pmr::new_delete_resource() );
+}
+
+
+/**
+ * The triangulation doesn't depend on where its vertices are allocated, and its results
+ * outlive the arena.
+ */
+BOOST_AUTO_TEST_CASE( Triangulation )
+{
+    for( bool partition : { false, true } )
+    {
+        BOOST_TEST_CONTEXT( "Partition: " << partition )
+        {
+            SHAPE_POLY_SET expected = triangulatedGrid( partition );
+            SHAPE_POLY_SET actual;
+
+            {
+                GEOMETRY_ARENA arena;
+
+                actual = triangulatedGrid( partition );
+            }
+
+            BOOST_REQUIRE_EQUAL( actual.TriangulatedPolyCount(),
+                                 expected.TriangulatedPolyCount() );
+
+            for( unsigned ii = 0; ii < expected.TriangulatedPolyCount(); ++ii )
+            {
+                const auto* expectedTris = expected.TriangulatedPolygon( ii );
+                const auto* actualTris = actual.TriangulatedPolygon( ii );
+
+                BOOST_REQUIRE_EQUAL( actualTris->GetTriangleCount(),
+                                     expectedTris->GetTriangleCount() );
+
+                for( size_t jj = 0; jj < expectedTris->GetTriangleCount(); ++jj )
+                {
+                    VECTOR2I a1, b1, c1, a2, b2, c2;
+
+                    expectedTris->GetTriangle( jj, a1, b1, c1 );
+                    actualTris->GetTriangle( jj, a2, b2, c2 );
+
+                    BOOST_CHECK( a1 == a2 && b1 == b2 && c1 == c2 );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <climits>
+#include <random>
+#include <set>
+
+#include <geometry/rtree.h>
+
+
+using TEST_RTREE = RTree<intptr_t, int, 2, double>;
+using ENTRY = std::pair<TEST_RTREE::Rect, intptr_t>;
+
+
+static std::set<intptr_t> search( const TEST_RTREE& aTree, const TEST_RTREE::Rect& aRect )
+{
+    std::set<intptr_t> found;
+
+    auto visitor =
+            [&]( const intptr_t& aData ) -> bool
+            {
+                found.insert( aData );
+                return true;
+            };
+
+    aTree.Search( aRect.m_min, aRect.m_max, visitor );
+    return found;
+}
+
+
+BOOST_AUTO_TEST_SUITE( RTreeBulkLoad )
+
+
+/**
+ * A bulk-loaded tree must answer queries exactly like one built by repeated insertion, both
+ * when loaded into an empty tree and when merged with existing contents, and must stay
+ * editable afterwards.
+ */
+BOOST_AUTO_TEST_CASE( MatchesIncrementalInsert )
+{
+    std::mt19937 rng( 1 );
+
+    for( int count : { 0, 1, 8, 9, 64, 65, 5000 } )
+    {
+        BOOST_TEST_CONTEXT( count << " entries" )
+        {
+            TEST_RTREE         bulk;
+            TEST_RTREE         incremental;
+            std::vector<ENTRY> entries;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                int x = rng() % 100000;
+                int y = rng() % 100000;
+
+                TEST_RTREE::Rect rect = { { x, y }, { x + int( rng() % 500 ),
+                                                      y + int( rng() % 500 ) } };
+
+                incremental.Insert( rect.m_min, rect.m_max, ii );
+
+                // Seed the bulk tree with a third of the entries to exercise merging
+                if( ii % 3 == 0 )
+                    bulk.Insert( rect.m_min, rect.m_max, ii );
+                else
+                    entries.emplace_back( rect, ii );
+            }
+
+            bulk.BulkLoad( entries );
+
+            BOOST_CHECK_EQUAL( bulk.Count(), count );
+
+            for( int ii = 0; ii < 100; ++ii )
+            {
+                int              x = rng() % 100000;
+                int              y = rng() % 100000;
+                TEST_RTREE::Rect query = { { x, y }, { x + 2000, y + 2000 } };
+
+                BOOST_CHECK( search( bulk, query ) == search( incremental, query ) );
+            }
+
+            for( const ENTRY& entry : entries )
+            {
+                bulk.Remove( entry.first.m_min, entry.first.m_max, entry.second );
+                incremental.Remove( entry.first.m_min, entry.first.m_max, entry.second );
+            }
+
+            TEST_RTREE::Rect all = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
+
+            BOOST_CHECK_EQUAL( bulk.Count(), incremental.Count() );
+            BOOST_CHECK( search( bulk, all ) == search( incremental, all ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
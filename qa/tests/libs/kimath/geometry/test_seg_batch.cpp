@@ -0,0 +1,219 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <random>
+#include <vector>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+#include <math/util.h>
+
+
+/**
+ * The ray casting of SHAPE_LINE_CHAIN_BASE::PointInside(), one segment at a time, over
+ * segments aFirst to aLast - 1.
+ */
+static int referenceRayCrossings( const VECTOR2I& aP, const std::vector<VECTOR2I>& aPts,
+                                  int aFirst, int aLast )
+{
+    int crossings = 0;
+
+    for( int i = aFirst; i < aLast; ++i )
+    {
+        const VECTOR2I& p1 = aPts[i];
+        const VECTOR2I& p2 = aPts[i + 1 == (int) aPts.size() ? 0 : i + 1];
+        const VECTOR2I  diff = p2 - p1;
+
+        if( diff.y != 0 )
+        {
+            const int d = rescale( diff.x, ( aP.y - p1.y ), diff.y );
+
+            if( ( ( p1.y > aP.y ) != ( p2.y > aP.y ) ) && ( aP.x - p1.x < d ) )
+                crossings++;
+        }
+    }
+
+    return crossings;
+}
+
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+
+/**
+ * Compare the batch kernels with the per-segment tests over random point sequences, random
+ * segment ranges and coordinate ranges from a few nm (lots of shared coordinates) up to a
+ * quarter of the int range, where the coordinate differences still fit in an int.
+ */
+BOOST_AUTO_TEST_CASE( MatchesPerSegmentTests )
+{
+    std::mt19937 rng( 1 );
+    const int    ranges[] = { 20, 100000, 10000000, 500000000 };
+
+    for( int iter = 0; iter < 2000; ++iter )
+    {
+        std::uniform_int_distribution<int> coord( -ranges[iter % 4], ranges[iter % 4] );
+        std::vector<VECTOR2I>              pts( rng() % 300 );
+        int                                count = pts.size();
+
+        for( VECTOR2I& pt : pts )
+            pt = VECTOR2I( coord( rng ), coord( rng ) );
+
+        for( int query = 0; query < 20; ++query )
+        {
+            VECTOR2I pt( coord( rng ), coord( rng ) );
+
+            // Points level with a vertex are the awkward case for the ray casting
+            if( count && query % 4 == 0 )
+                pt.y = pts[rng() % count].y;
+
+            int first = 0;
+            int last = count;
+
+            if( query % 2 )
+            {
+                first = rng() % ( count + 1 );
+                last = first + rng() % ( count - first + 1 );
+            }
+
+            BOOST_CHECK_EQUAL( CountRayCrossings( pt, pts.data(), count, first, last ),
+                               referenceRayCrossings( pt, pts, first, last ) );
+
+            SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+            int         nearest = -1;
+
+            for( int i = first; i < last; ++i )
+            {
+                SEG         seg( pts[i], pts[i + 1 == count ? 0 : i + 1] );
+                SEG::ecoord d = seg.SquaredDistance( pt );
+
+                if( d < best )
+                {
+                    best = d;
+                    nearest = i;
+                }
+            }
+
+            int batchNearest = -1;
+
+            BOOST_CHECK_EQUAL( MinSegmentSquaredDistance( pt, pts.data(), count, first, last,
+                                                          &batchNearest ),
+                               best );
+            BOOST_CHECK_EQUAL( batchNearest, nearest );
+        }
+    }
+}
+
+
+/**
+ * On a chain which wanders in small steps, queried near its own vertices, most segments are
+ * rejected by the box test of the distance kernel.  The result must still be that of testing
+ * them all, including segments just outside the best distance so far.
+ */
+BOOST_AUTO_TEST_CASE( DistanceNearWanderingChain )
+{
+    std::mt19937 rng( 2 );
+
+    for( int iter = 0; iter < 500; ++iter )
+    {
+        const int                          step = iter % 2 ? 1000 : 3;
+        std::uniform_int_distribution<int> delta( -step, step );
+        std::vector<VECTOR2I>              pts( 1 + rng() % 500 );
+        int                                count = pts.size();
+
+        for( int i = 1; i < count; ++i )
+            pts[i] = pts[i - 1] + VECTOR2I( delta( rng ), delta( rng ) );
+
+        for( int query = 0; query < 20; ++query )
+        {
+            VECTOR2I pt = pts[rng() % count] + VECTOR2I( delta( rng ), delta( rng ) );
+
+            SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+            int         nearest = -1;
+
+            for( int i = 0; i < count; ++i )
+            {
+                SEG         seg( pts[i], pts[i + 1 == count ? 0 : i + 1] );
+                SEG::ecoord d = seg.SquaredDistance( pt );
+
+                if( d < best )
+                {
+                    best = d;
+                    nearest = i;
+                }
+            }
+
+            int batchNearest = -1;
+
+            BOOST_CHECK_EQUAL( MinSegmentSquaredDistance( pt, pts.data(), count, 0, count,
+                                                          &batchNearest ),
+                               best );
+            BOOST_CHECK_EQUAL( batchNearest, nearest );
+        }
+    }
+}
+
+
+/**
+ * SHAPE_LINE_CHAIN uses the kernels on its point array; the base class still goes through
+ * GetPoint() and GetSegment() one at a time.
+ */
+BOOST_AUTO_TEST_CASE( LineChainMatchesBase )
+{
+    std::mt19937                       rng( 2 );
+    std::uniform_int_distribution<int> coord( -1000, 1000 );
+
+    for( int iter = 0; iter < 500; ++iter )
+    {
+        SHAPE_LINE_CHAIN chain;
+        int              count = 3 + rng() % 100;
+
+        for( int ii = 0; ii < count; ++ii )
+            chain.Append( VECTOR2I( coord( rng ), coord( rng ) ), true );
+
+        chain.SetClosed( iter % 4 != 0 );
+
+        const SHAPE_LINE_CHAIN_BASE& base = chain;
+
+        for( int query = 0; query < 50; ++query )
+        {
+            VECTOR2I pt( coord( rng ), coord( rng ) );
+
+            if( query % 4 == 0 )
+                pt = chain.CPoint( rng() % chain.PointCount() );
+
+            BOOST_CHECK_EQUAL( chain.PointInside( pt ),
+                               base.SHAPE_LINE_CHAIN_BASE::PointInside( pt ) );
+            BOOST_CHECK_EQUAL( chain.PointInside( pt, 10 ),
+                               base.SHAPE_LINE_CHAIN_BASE::PointInside( pt, 10 ) );
+            BOOST_CHECK_EQUAL( chain.SquaredDistance( pt ),
+                               base.SHAPE_LINE_CHAIN_BASE::SquaredDistance( pt ) );
+            BOOST_CHECK_EQUAL( chain.SquaredDistance( pt, true ),
+                               base.SHAPE_LINE_CHAIN_BASE::SquaredDistance( pt, true ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -124,4 +124,76 @@ BOOST_AUTO_TEST_CASE( Collide_NoClearance )
     BOOST_CHECK_MESSAGE( actual == 0, "Expected: " << 0 << " Actual: " << actual );
 }
 
+/**
+ * Long chains answer the queries from a segment index.  Check that the answers are the same as
+ * the linear scans of SHAPE_LINE_CHAIN_BASE, including after the chain has been changed.
+ */
+BOOST_AUTO_TEST_CASE( Collide_LongChainMatchesLinearScan )
+{
+    SHAPE_LINE_CHAIN chain;
+    const int        count = 2000;
+
+    // A closed star-like outline with an irregular radius
+    for( int ii = 0; ii < count; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / count;
+        double radius = 1000000.0 + 400000.0 * ( ( ii * 7919 ) % 101 ) / 100.0;
+
+        chain.Append( VECTOR2I( KiROUND( radius * cos( angle ) ),
+                                KiROUND( radius * sin( angle ) ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    auto checkQueries =
+            [&]()
+            {
+                const SHAPE_LINE_CHAIN_BASE& base = chain;
+
+                for( int x = -1500000; x <= 1500000; x += 37123 )
+                {
+                    for( int y = -1500000; y <= 1500000; y += 41017 )
+                    {
+                        VECTOR2I pt( x, y );
+
+                        BOOST_CHECK_EQUAL( chain.PointInside( pt ),
+                                           base.SHAPE_LINE_CHAIN_BASE::PointInside( pt ) );
+                        BOOST_CHECK_EQUAL( chain.PointInside( pt, 20000 ),
+                                           base.SHAPE_LINE_CHAIN_BASE::PointInside( pt, 20000 ) );
+                        BOOST_CHECK_EQUAL(
+                                chain.SquaredDistance( pt, true ),
+                                base.SHAPE_LINE_CHAIN_BASE::SquaredDistance( pt, true ) );
+
+                        int      actual = 0;
+                        int      baseActual = 0;
+                        VECTOR2I location;
+                        VECTOR2I baseLocation;
+
+                        BOOST_CHECK_EQUAL( chain.Collide( pt, 50000, &actual, &location ),
+                                           base.SHAPE_LINE_CHAIN_BASE::Collide( pt, 50000,
+                                                                                &baseActual,
+                                                                                &baseLocation ) );
+                        BOOST_CHECK_EQUAL( actual, baseActual );
+                        BOOST_CHECK_EQUAL( location, baseLocation );
+
+                        SEG seg( pt, pt + VECTOR2I( 30000, -20000 ) );
+
+                        BOOST_CHECK_EQUAL( chain.Collide( seg, 10000, &actual, &location ),
+                                           base.SHAPE_LINE_CHAIN_BASE::Collide( seg, 10000,
+                                                                                &baseActual,
+                                                                                &baseLocation ) );
+                        BOOST_CHECK_EQUAL( actual, baseActual );
+                        BOOST_CHECK_EQUAL( location, baseLocation );
+                    }
+                }
+            };
+
+    checkQueries();
+
+    // Changing the chain must drop the index
+    chain.SetPoint( 0, VECTOR2I( 0, 0 ) );
+    chain.Move( VECTOR2I( 12345, -6789 ) );
+    checkQueries();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
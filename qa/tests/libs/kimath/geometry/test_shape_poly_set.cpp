@@ -15,6 +15,8 @@
  *
  */
 
+#include <convert_basic_shapes_to_polygon.h>
+#include <core/thread_pool.h>
 #include <geometry/shape_poly_set.h>
 #include <trigo.h>
 
@@ -64,4 +66,214 @@ BOOST_AUTO_TEST_CASE( RemoveNullSegments )
 
 }
 
+/**
+ * Boolean ops on inputs large enough to be split into tiles.  The squares are axis-aligned so
+ * the cuts at the tile edges don't round anything, and the results are exact.
+ */
+BOOST_AUTO_TEST_CASE( LargeBooleanOps )
+{
+    const int width = 200000000;
+    const int height = 100000000;
+    const int pitch = 1000000;
+    const int size = 400000;
+
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET squares;
+
+    board.NewOutline();
+    board.Append( 0, 0 );
+    board.Append( width, 0 );
+    board.Append( width, height );
+    board.Append( 0, height );
+
+    // Some squares overhang the board edges
+    int inside = 0;
+
+    for( int x = -pitch / 4; x < width + pitch; x += pitch )
+    {
+        for( int y = -pitch / 4; y < height + pitch; y += pitch )
+        {
+            squares.NewOutline();
+            squares.Append( x, y );
+            squares.Append( x + size, y );
+            squares.Append( x + size, y + size );
+            squares.Append( x, y + size );
+
+            if( x > 0 && y > 0 && x + size < width && y + size < height )
+                inside++;
+        }
+    }
+
+    BOOST_REQUIRE_GT( squares.FullPointCount(), 50000 );
+
+    double squaresArea = squares.Area();
+    double overlap = 0.0;
+
+    for( int ii = 0; ii < squares.OutlineCount(); ++ii )
+    {
+        BOX2I bbox = squares.COutline( ii ).BBox();
+        int64_t w = std::min( bbox.GetRight(), width ) - std::max( bbox.GetLeft(), 0 );
+        int64_t h = std::min( bbox.GetBottom(), height ) - std::max( bbox.GetTop(), 0 );
+
+        if( w > 0 && h > 0 )
+            overlap += double( w ) * h;
+    }
+
+    SHAPE_POLY_SET result = board;
+    result.BooleanSubtract( squares, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( result.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( result.HoleCount( 0 ), inside );
+    BOOST_CHECK_EQUAL( result.Area(), double( width ) * height - overlap );
+
+    result = board;
+    result.BooleanIntersection( squares, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( result.Area(), overlap );
+    BOOST_CHECK( !result.HasHoles() );
+
+    result = squares;
+    result.BooleanAdd( board, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( result.Area(), double( width ) * height + squaresArea - overlap );
+}
+
+
+/**
+ * Boolean ops on rotated and curved shapes, whose edges are cut at the tile boundaries and
+ * rounded there, against the same ops without tiles.
+ */
+BOOST_AUTO_TEST_CASE( TiledBooleanOpsMatchUntiled )
+{
+    const int radius = 40000000;
+    const int pitch = 2000000;
+
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET shapes;
+
+    TransformCircleToPolygon( board, VECTOR2I( 0, 0 ), radius, 1000, ERROR_INSIDE );
+
+    // Rotated squares and circles, which overlap each other and the board edge.  The sizes are
+    // chosen so that no vertex lands exactly on another shape's edge.
+    for( int x = -radius; x <= radius; x += pitch )
+    {
+        for( int y = -radius; y <= radius; y += pitch )
+        {
+            VECTOR2I center( x + ( y / pitch ) * 37000, y + ( x / pitch ) * 23000 );
+
+            if( ( x / pitch + y / pitch ) % 2 )
+            {
+                TransformCircleToPolygon( shapes, center, pitch * 2 / 5 + 1234, 2000, ERROR_INSIDE );
+            }
+            else
+            {
+                EDA_ANGLE angle( ( x / pitch * 7 + y / pitch * 13 ) % 90 + 0.5, DEGREES_T );
+
+                shapes.NewOutline();
+
+                for( VECTOR2I corner : { VECTOR2I( -1, -1 ), VECTOR2I( 1, -1 ), VECTOR2I( 1, 1 ),
+                                         VECTOR2I( -1, 1 ) } )
+                {
+                    corner = corner * ( pitch * 3 / 5 + 567 );
+                    RotatePoint( corner, angle );
+                    shapes.Append( center + corner );
+                }
+            }
+        }
+    }
+
+    using BOOLEAN_OP = void ( SHAPE_POLY_SET::* )( const SHAPE_POLY_SET&,
+                                                   SHAPE_POLY_SET::POLYGON_MODE );
+
+    auto run =
+            []( int aMinVertices, BOOLEAN_OP aOp, const SHAPE_POLY_SET& aShape,
+                const SHAPE_POLY_SET& aOther )
+            {
+                SHAPE_POLY_SET result = aShape;
+
+                SHAPE_POLY_SET::SetTiledBooleanMinVertices( aMinVertices );
+                ( result.*aOp )( aOther, SHAPE_POLY_SET::PM_FAST );
+                SHAPE_POLY_SET::SetTiledBooleanMinVertices( -1 );
+
+                return result;
+            };
+
+    auto holeCount =
+            []( const SHAPE_POLY_SET& aPolySet )
+            {
+                int holes = 0;
+
+                for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+                    holes += aPolySet.HoleCount( ii );
+
+                return holes;
+            };
+
+    // IsSelfIntersecting() mistakes the closing segments of holes for intersections
+    auto isSimple =
+            []( const SHAPE_POLY_SET& aPolySet )
+            {
+                for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+                {
+                    if( aPolySet.COutline( ii ).SelfIntersecting() )
+                        return false;
+
+                    for( int jj = 0; jj < aPolySet.HoleCount( ii ); ++jj )
+                    {
+                        if( aPolySet.CHole( ii, jj ).SelfIntersecting() )
+                            return false;
+                    }
+                }
+
+                return true;
+            };
+
+    auto perimeter =
+            []( const SHAPE_POLY_SET& aPolySet )
+            {
+                double length = 0.0;
+
+                for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+                {
+                    length += aPolySet.COutline( ii ).Length();
+
+                    for( int jj = 0; jj < aPolySet.HoleCount( ii ); ++jj )
+                        length += aPolySet.CHole( ii, jj ).Length();
+                }
+
+                return length;
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         threadCount = tp.get_thread_count();
+
+    const BOOLEAN_OP ops[] = { &SHAPE_POLY_SET::BooleanSubtract,
+                               &SHAPE_POLY_SET::BooleanIntersection,
+                               &SHAPE_POLY_SET::BooleanAdd };
+
+    for( BOOLEAN_OP op : ops )
+    {
+        SHAPE_POLY_SET tiled = run( 1, op, board, shapes );
+        SHAPE_POLY_SET untiled = run( 0, op, board, shapes );
+
+        BOOST_CHECK_GT( untiled.Area(), 1e14 );
+        BOOST_CHECK_EQUAL( tiled.OutlineCount(), untiled.OutlineCount() );
+        BOOST_CHECK_EQUAL( holeCount( tiled ), holeCount( untiled ) );
+        BOOST_CHECK( isSimple( tiled ) );
+
+        // Only edges cut by the tile boundaries may have their intersections rounded
+        // differently, which moves them by a nanometre at most
+        SHAPE_POLY_SET difference = run( 0, &SHAPE_POLY_SET::BooleanXor, tiled, untiled );
+
+        BOOST_CHECK_LT( difference.Area(), perimeter( untiled ) );
+
+        // The tiles don't depend on the number of threads, and neither does the result
+        tp.reset( 1 );
+        SHAPE_POLY_SET serial = run( 1, op, board, shapes );
+        tp.reset( threadCount );
+
+        BOOST_CHECK( serial.Format() == tiled.Format() );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
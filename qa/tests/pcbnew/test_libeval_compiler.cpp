@@ -146,6 +146,31 @@ BOOST_AUTO_TEST_CASE( SimpleExpressions )
 }
 
 
+BOOST_AUTO_TEST_CASE( ConstantFolding )
+{
+    for( const auto& expr : simpleExpressions )
+    {
+        if( expr.expectError )
+            continue;
+
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  context( NULL_CONSTRAINT, UNDEFINED_LAYER );
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_TEST_MESSAGE( "Expr: '" << expr.expression.c_str() << "'" );
+        BOOST_REQUIRE( compiler.Compile( expr.expression, &ucode, &preflightContext ) );
+
+        ucode.Optimize();
+
+        // Purely constant expressions should fold down to a single push
+        BOOST_CHECK_EQUAL( ucode.Dump().Trim().Freq( '\n' ), 0 );
+        BOOST_CHECK_CLOSE( ucode.Run( &context )->AsDouble(), expr.expectedResult.AsDouble(),
+                           1e-9 );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE( IntrospectedProperties )
 {
     PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
@@ -181,4 +206,32 @@ BOOST_AUTO_TEST_CASE( IntrospectedProperties )
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( MemoizableExpressions )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    propMgr.Rebuild();
+
+    const std::vector<std::pair<wxString, bool>> exprs = {
+        { "A.NetClass == 'HV'", true },
+        { "A.Type == 'Pad' && B.NetClass != 'HV'", true },
+        { "A.NetClass == B.NetClass", true },
+        { "A.NetName == '/VCC'", false },
+        { "A.Type == 'Track' && A.Layer == 'F.Cu'", false },
+        { "A.Type == 'Via' && A.isMicroVia()", false },
+        { "A.insideArea('Zone1')", false }
+    };
+
+    for( const auto& [ expr, memoizable ] : exprs )
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_TEST_MESSAGE( "Expr: '" << expr.c_str() << "'" );
+        BOOST_CHECK( compiler.Compile( expr, &ucode, &preflightContext ) );
+        BOOST_CHECK_EQUAL( ucode.IsMemoizable(), memoizable );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
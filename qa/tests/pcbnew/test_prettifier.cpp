@@ -140,3 +140,51 @@ BOOST_FIXTURE_TEST_CASE( BoardAndFootprintPrettifier, PRETTIFIER_TEST_FIXTURE )
 
     std::filesystem::remove_all( tempLibPath );
 }
+
+
+/**
+ * Feeding the prettifier in small pieces, as PRETTIFIED_FILE_OUTPUTFORMATTER does, must give
+ * the same result as prettifying the whole text at once.
+ */
+BOOST_AUTO_TEST_CASE( StreamingPrettifier )
+{
+    std::vector<std::string> cases = {
+        "Reverb_BTDR-1V.kicad_mod",
+        "Samtec_HLE-133-02-xx-DV-PE-LC_2x33_P2.54mm_Horizontal.kicad_mod",
+        "group_and_image.kicad_pcb"
+    };
+
+    for( const std::string& testCase : cases )
+    {
+        BOOST_TEST_CONTEXT( testCase )
+        {
+            std::ifstream inFp( fmt::format( "{}prettifier/{}", KI_TEST::GetPcbnewTestDataDir(),
+                                             testCase ) );
+            BOOST_REQUIRE( inFp.is_open() );
+
+            std::stringstream inBuf;
+            inBuf << inFp.rdbuf();
+            std::string inData = inBuf.str();
+            std::string expected = inData;
+
+            KICAD_FORMAT::Prettify( expected );
+
+            for( size_t chunk : { 1, 3, 7, 64 } )
+            {
+                KICAD_FORMAT::PRETTIFIER prettifier;
+                std::string              streamed;
+
+                for( size_t ii = 0; ii < inData.length(); ii += chunk )
+                {
+                    prettifier.Feed( inData.data() + ii, std::min( chunk, inData.length() - ii ),
+                                     streamed );
+                }
+
+                prettifier.Finish( streamed );
+
+                BOOST_CHECK_MESSAGE( streamed == expected,
+                                     fmt::format( "Mismatch with {} byte chunks", chunk ) );
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <random>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_data.h>
+#include <connectivity/connectivity_algo.h>
+#include <ratsnest/ratsnest_data.h>
+
+
+BOOST_AUTO_TEST_SUITE( Ratsnest )
+
+
+/**
+ * Total length of the ratsnest of a net.  The minimum spanning tree may differ between two
+ * equally short candidates, but its length is unique.
+ */
+static double ratsnestLength( RN_NET* aNet, size_t& aEdgeCount )
+{
+    double length = 0.0;
+
+    aEdgeCount = aNet->GetEdges().size();
+
+    for( const CN_EDGE& edge : aNet->GetEdges() )
+        length += VECTOR2D( edge.GetTargetPos() - edge.GetSourcePos() ).EuclideanNorm();
+
+    return length;
+}
+
+
+BOOST_AUTO_TEST_CASE( IncrementalMatchesFullRebuild )
+{
+    // Unconnected vias on one net, some of which are moved at each step.  The moves are small
+    // enough for the ratsnest to be patched rather than rebuilt, and each one includes a via
+    // together with its nearest neighbours, so that neighbouring anchors are removed together.
+    const int viaCount = 400;
+    const int extent = pcbIUScale.mmToIU( 100 );
+
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( 0, extent );
+
+    BOARD         board;
+    NETINFO_ITEM* net = new NETINFO_ITEM( &board, wxT( "NET1" ), 1 );
+    board.Add( net );
+
+    std::vector<PCB_VIA*> vias;
+
+    for( int ii = 0; ii < viaCount; ++ii )
+    {
+        PCB_VIA* via = new PCB_VIA( &board );
+
+        via->SetPosition( VECTOR2I( coord( rng ), coord( rng ) ) );
+        via->SetLayerPair( F_Cu, B_Cu );
+        via->SetWidth( pcbIUScale.mmToIU( 0.1 ) );
+        via->SetDrill( pcbIUScale.mmToIU( 0.05 ) );
+        via->SetNet( net );
+
+        board.Add( via );
+        vias.push_back( via );
+    }
+
+    board.BuildConnectivity();
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = board.GetConnectivity();
+
+    for( int step = 0; step < 20; ++step )
+    {
+        PCB_VIA*              center = vias[ rng() % vias.size() ];
+        std::vector<PCB_VIA*> moved = vias;
+
+        std::sort( moved.begin(), moved.end(),
+                   [&]( PCB_VIA* a, PCB_VIA* b )
+                   {
+                       return ( a->GetPosition() - center->GetPosition() ).SquaredEuclideanNorm()
+                              < ( b->GetPosition() - center->GetPosition() ).SquaredEuclideanNorm();
+                   } );
+
+        moved.resize( 8 );
+        moved.push_back( vias[ rng() % vias.size() ] );
+        moved.push_back( vias[ rng() % vias.size() ] );
+
+        for( PCB_VIA* via : moved )
+        {
+            via->SetPosition( VECTOR2I( coord( rng ), coord( rng ) ) );
+            connectivity->Update( via );
+        }
+
+        connectivity->RecalculateRatsnest();
+
+        CONNECTIVITY_DATA full;
+        full.Build( &board );
+
+        size_t incrementalEdges = 0;
+        size_t fullEdges = 0;
+        double incrementalLength = ratsnestLength( connectivity->GetRatsnestForNet( 1 ),
+                                                   incrementalEdges );
+        double fullLength = ratsnestLength( full.GetRatsnestForNet( 1 ), fullEdges );
+
+        BOOST_CHECK_EQUAL( incrementalEdges, fullEdges );
+        BOOST_CHECK_CLOSE( incrementalLength, fullLength, 1e-9 );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,11 +22,17 @@
  */
 
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <board.h>
+#include <footprint.h>
+#include <pcb_dimension.h>
+#include <pcb_text.h>
+#include <core/thread_pool.h>
 #include <settings/settings_manager.h>
 
 
@@ -64,3 +70,68 @@ BOOST_FIXTURE_TEST_CASE( RegressionSaveLoadTests, SAVE_LOAD_TEST_FIXTURE )
     }
 }
 
+
+BOOST_FIXTURE_TEST_CASE( ParallelParseMatchesSerial, SAVE_LOAD_TEST_FIXTURE )
+{
+    // Footprints are parsed on the thread pool.  Footprint dimensions and texts look up fonts
+    // while they are parsed, so give them plenty of both and check that the result doesn't
+    // depend on the number of threads.
+    m_board = std::make_unique<BOARD>();
+
+    for( int ii = 0; ii < 200; ++ii )
+    {
+        FOOTPRINT* footprint = new FOOTPRINT( m_board.get() );
+        VECTOR2I   pos( pcbIUScale.mmToIU( 10 * ( ii % 20 ) ),
+                        pcbIUScale.mmToIU( 10 * ( ii / 20 ) ) );
+
+        footprint->SetReference( wxString::Format( wxT( "U%d" ), ii + 1 ) );
+        footprint->SetPosition( pos );
+
+        PCB_TEXT* text = new PCB_TEXT( footprint );
+        text->SetText( wxString::Format( wxT( "text %d" ), ii ) );
+        text->SetLayer( F_SilkS );
+        text->SetPosition( pos + VECTOR2I( 0, pcbIUScale.mmToIU( 2 ) ) );
+        footprint->Add( text );
+
+        PCB_DIM_ALIGNED* dim = new PCB_DIM_ALIGNED( footprint );
+        dim->SetLayer( F_Fab );
+        dim->SetStart( pos );
+        dim->SetEnd( pos + VECTOR2I( pcbIUScale.mmToIU( 1 + ii % 7 ), 0 ) );
+        dim->SetHeight( pcbIUScale.mmToIU( 1 ) );
+        dim->Update();
+        footprint->Add( dim );
+
+        m_board->Add( footprint );
+    }
+
+    auto path = std::filesystem::temp_directory_path() / "parallel_parse_tst.kicad_pcb";
+    KI_TEST::DumpBoardToFile( *m_board, path.string() );
+
+    auto roundTrip =
+            [&]( const std::string& aName ) -> std::string
+            {
+                std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( path.string() );
+                BOOST_REQUIRE( board );
+                BOOST_CHECK_EQUAL( board->Footprints().size(), m_board->Footprints().size() );
+
+                auto outPath = std::filesystem::temp_directory_path() / aName;
+                KI_TEST::DumpBoardToFile( *board, outPath.string() );
+
+                std::ifstream     file( outPath.string() );
+                std::stringstream contents;
+                contents << file.rdbuf();
+                return contents.str();
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         threadCount = tp.get_thread_count();
+
+    // Parallel first, so that the fonts are first used from the workers
+    std::string parallel = roundTrip( "parallel_parse_tst_par.kicad_pcb" );
+
+    tp.reset( 1 );
+    std::string serial = roundTrip( "parallel_parse_tst_ser.kicad_pcb" );
+    tp.reset( threadCount );
+
+    BOOST_CHECK( parallel == serial );
+}
@@ -29,6 +29,8 @@
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_filler.h>
+#include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <settings/settings_manager.h>
 
@@ -299,3 +301,173 @@ BOOST_FIXTURE_TEST_CASE( RegressionTeardropFill, ZONE_FILL_TEST_FIXTURE )
     }
 }
 
+
+BOOST_FIXTURE_TEST_CASE( LargeSyntheticZoneFill, ZONE_FILL_TEST_FIXTURE )
+{
+    // A checkerboard of overlapping zones on alternating nets, with the NET1 zones at the higher
+    // priority, each holding four conditionally-flashed vias (two on each net).  Every zone and
+    // via lookup goes through the zone index.
+    //
+    // The vias sit well inside the zones, away from the overlaps, so each zone must fill as a
+    // single outline with one hole for each of its two other-net vias.
+    const int gridSize = 10;
+    const int zonePitch = pcbIUScale.mmToIU( 5 );
+    const int overlap = pcbIUScale.mmToIU( 0.5 );
+    const int viaOffsets[2] = { pcbIUScale.mmToIU( 2 ), pcbIUScale.mmToIU( 3.5 ) };
+
+    m_board = std::make_unique<BOARD>();
+
+    auto drcEngine = std::make_shared<DRC_ENGINE>( m_board.get(), &m_board->GetDesignSettings() );
+    drcEngine->InitEngine( wxFileName() );
+    m_board->GetDesignSettings().m_DRCEngine = drcEngine;
+
+    NETINFO_ITEM* nets[2];
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        nets[ii] = new NETINFO_ITEM( m_board.get(), wxString::Format( "NET%d", ii + 1 ), ii + 1 );
+        m_board->Add( nets[ii] );
+    }
+
+    for( int row = 0; row < gridSize; ++row )
+    {
+        for( int col = 0; col < gridSize; ++col )
+        {
+            ZONE*    zone = new ZONE( m_board.get() );
+            VECTOR2I origin( col * zonePitch, row * zonePitch );
+            int      size = zonePitch + overlap;
+            int      netIdx = ( row + col ) % 2;
+
+            zone->SetLayer( F_Cu );
+            zone->SetNet( nets[ netIdx ] );
+            zone->SetAssignedPriority( netIdx == 0 ? 1 : 0 );
+            zone->AppendCorner( origin, -1 );
+            zone->AppendCorner( origin + VECTOR2I( size, 0 ), -1 );
+            zone->AppendCorner( origin + VECTOR2I( size, size ), -1 );
+            zone->AppendCorner( origin + VECTOR2I( 0, size ), -1 );
+
+            m_board->Add( zone );
+
+            for( int ii = 0; ii < 2; ++ii )
+            {
+                for( int jj = 0; jj < 2; ++jj )
+                {
+                    PCB_VIA* via = new PCB_VIA( m_board.get() );
+
+                    via->SetPosition( origin + VECTOR2I( viaOffsets[ii], viaOffsets[jj] ) );
+                    via->SetLayerPair( F_Cu, B_Cu );
+                    via->SetWidth( pcbIUScale.mmToIU( 0.6 ) );
+                    via->SetDrill( pcbIUScale.mmToIU( 0.3 ) );
+                    via->SetNet( nets[ ( ii + jj ) % 2 ] );
+                    via->SetRemoveUnconnected( true );
+
+                    m_board->Add( via );
+                }
+            }
+        }
+    }
+
+    m_board->BuildListOfNets();
+    m_board->BuildConnectivity();
+
+    KI_TEST::FillZones( m_board.get() );
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        std::shared_ptr<SHAPE_POLY_SET> fill = zone->GetFilledPolysList( F_Cu );
+
+        BOOST_CHECK( zone->IsFilled() );
+        BOOST_REQUIRE_EQUAL( fill->OutlineCount(), 1 );
+        BOOST_CHECK_EQUAL( fill->HoleCount( 0 ), 2 );
+    }
+
+    // Each via lies in exactly one zone; it is flashed only if the zone is on its net
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+        ZONE*    zone = nullptr;
+
+        for( ZONE* candidate : m_board->Zones() )
+        {
+            if( candidate->Outline()->Contains( via->GetPosition() ) )
+            {
+                zone = candidate;
+                break;
+            }
+        }
+
+        BOOST_REQUIRE( zone );
+        BOOST_CHECK_EQUAL( via->FlashLayer( F_Cu ), via->GetNetCode() == zone->GetNetCode() );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DependentZoneRefill, ZONE_FILL_TEST_FIXTURE )
+{
+    // Zone A knocks out the lower-priority zones B (on the board) and C (in a footprint).
+    // Refilling only A after moving it must refill B and C too, to the same result as refilling
+    // everything.
+    m_board = std::make_unique<BOARD>();
+
+    auto drcEngine = std::make_shared<DRC_ENGINE>( m_board.get(), &m_board->GetDesignSettings() );
+    drcEngine->InitEngine( wxFileName() );
+    m_board->GetDesignSettings().m_DRCEngine = drcEngine;
+
+    NETINFO_ITEM* net1 = new NETINFO_ITEM( m_board.get(), wxT( "NET1" ), 1 );
+    NETINFO_ITEM* net2 = new NETINFO_ITEM( m_board.get(), wxT( "NET2" ), 2 );
+    m_board->Add( net1 );
+    m_board->Add( net2 );
+
+    auto makeZone =
+            [&]( BOARD_ITEM_CONTAINER* aParent, NETINFO_ITEM* aNet, int aPriority,
+                 const VECTOR2I& aOrigin ) -> ZONE*
+            {
+                const int size = pcbIUScale.mmToIU( 10 );
+                ZONE*     zone = new ZONE( aParent );
+
+                zone->SetLayer( F_Cu );
+                zone->SetNet( aNet );
+                zone->SetAssignedPriority( aPriority );
+                zone->AppendCorner( aOrigin, -1 );
+                zone->AppendCorner( aOrigin + VECTOR2I( size, 0 ), -1 );
+                zone->AppendCorner( aOrigin + VECTOR2I( size, size ), -1 );
+                zone->AppendCorner( aOrigin + VECTOR2I( 0, size ), -1 );
+                return zone;
+            };
+
+    ZONE* zoneA = makeZone( m_board.get(), net1, 1, VECTOR2I( 0, 0 ) );
+    ZONE* zoneB = makeZone( m_board.get(), net2, 0, VECTOR2I( pcbIUScale.mmToIU( 5 ), 0 ) );
+    m_board->Add( zoneA );
+    m_board->Add( zoneB );
+
+    FOOTPRINT* footprint = new FOOTPRINT( m_board.get() );
+    ZONE*      zoneC = makeZone( footprint, net2, 0, VECTOR2I( 0, pcbIUScale.mmToIU( 5 ) ) );
+    footprint->Add( zoneC );
+    m_board->Add( footprint );
+
+    m_board->BuildListOfNets();
+    m_board->BuildConnectivity();
+
+    ZONE_FILLER filler( m_board.get(), nullptr );
+
+    BOOST_REQUIRE( filler.Fill( { zoneA, zoneB, zoneC } ) );
+
+    double areaB = zoneB->GetFilledPolysList( F_Cu )->Area();
+    double areaC = zoneC->GetFilledPolysList( F_Cu )->Area();
+
+    zoneA->Move( VECTOR2I( pcbIUScale.mmToIU( 2 ), pcbIUScale.mmToIU( 2 ) ) );
+
+    BOOST_REQUIRE( filler.Fill( { zoneA } ) );
+
+    double partialAreaB = zoneB->GetFilledPolysList( F_Cu )->Area();
+    double partialAreaC = zoneC->GetFilledPolysList( F_Cu )->Area();
+
+    // A now covers more of both B and C
+    BOOST_CHECK_LT( partialAreaB, areaB );
+    BOOST_CHECK_LT( partialAreaC, areaC );
+
+    BOOST_REQUIRE( filler.Fill( { zoneA, zoneB, zoneC } ) );
+
+    BOOST_CHECK_EQUAL( partialAreaB, zoneB->GetFilledPolysList( F_Cu )->Area() );
+    BOOST_CHECK_EQUAL( partialAreaC, zoneC->GetFilledPolysList( F_Cu )->Area() );
+}
@@ -0,0 +1,267 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/filename.h>
+#include <wx/string.h>
+
+#include <base_units.h>
+#include <plotters/plotter_gerber.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include <qa_utils/utility_registry.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+struct BENCH_REPORT
+{
+    /// Number of apertures in the plotter at the end of the benchmark
+    unsigned apertureCount;
+
+    /// Accumulated D-Codes, to prevent the lookups being optimised away
+    unsigned dcodeAcc;
+
+    std::chrono::milliseconds benchDurMs;
+};
+
+
+using BENCH_FUNC = std::function<void( GERBER_PLOTTER&, int, int, BENCH_REPORT& )>;
+
+
+struct BENCHMARK
+{
+    char       triggerChar;
+    BENCH_FUNC func;
+    wxString   name;
+};
+
+
+/**
+ * A free polygon (4 corners, as a trapezoid pad) different for each aIdx.
+ */
+static std::vector<VECTOR2I> benchPolygon( int aIdx )
+{
+    int w = pcbIUScale.mmToIU( 0.5 ) + aIdx * 100;
+    int h = pcbIUScale.mmToIU( 0.3 ) + ( aIdx % 7 ) * 100;
+
+    return { VECTOR2I( -w, -h ), VECTOR2I( w, -h ), VECTOR2I( w + 50, h ), VECTOR2I( -w, h ) };
+}
+
+
+/**
+ * Benchmark GetOrCreateAperture() for apertures defined by a size, with aCount different
+ * apertures looked up aReps times each.
+ */
+static void bench_size_apertures( GERBER_PLOTTER& aPlotter, int aCount, int aReps,
+                                  BENCH_REPORT& aReport )
+{
+    for( int rep = 0; rep < aReps; ++rep )
+    {
+        for( int ii = 0; ii < aCount; ++ii )
+        {
+            VECTOR2I size( pcbIUScale.mmToIU( 0.2 ) + ii * 100, pcbIUScale.mmToIU( 0.4 ) );
+            int      idx = aPlotter.GetOrCreateAperture( size, 0, ANGLE_0, APERTURE::AT_RECT, 0 );
+
+            aReport.dcodeAcc += idx;
+        }
+    }
+}
+
+
+/**
+ * Benchmark GetOrCreateAperture() for apertures defined by a corner list (this also looks
+ * up the free polygon aperture macros), with aCount different apertures looked up aReps
+ * times each.
+ */
+static void bench_poly_apertures( GERBER_PLOTTER& aPlotter, int aCount, int aReps,
+                                  BENCH_REPORT& aReport )
+{
+    std::vector<std::vector<VECTOR2I>> polygons;
+
+    for( int ii = 0; ii < aCount; ++ii )
+        polygons.push_back( benchPolygon( ii ) );
+
+    for( int rep = 0; rep < aReps; ++rep )
+    {
+        for( const std::vector<VECTOR2I>& poly : polygons )
+        {
+            int idx = aPlotter.GetOrCreateAperture( poly, ANGLE_0, APERTURE::AM_FREE_POLYGON, 0 );
+
+            aReport.dcodeAcc += idx;
+        }
+    }
+}
+
+
+/**
+ * Benchmark a full plot to a file: aCount pads of different sizes and tracks of different
+ * widths, flashed or drawn aReps times each.
+ */
+static void bench_plot( GERBER_PLOTTER& aPlotter, int aCount, int aReps, BENCH_REPORT& aReport )
+{
+    wxString filename = wxFileName::CreateTempFileName( wxT( "gbrbench" ) );
+
+    if( !aPlotter.OpenFile( filename ) || !aPlotter.StartPlot( wxT( "1" ) ) )
+    {
+        std::cerr << "Cannot create " << filename << std::endl;
+        return;
+    }
+
+    for( int rep = 0; rep < aReps; ++rep )
+    {
+        for( int ii = 0; ii < aCount; ++ii )
+        {
+            VECTOR2I pos( rep * pcbIUScale.mmToIU( 1.0 ), ii * pcbIUScale.mmToIU( 1.0 ) );
+            VECTOR2I size( pcbIUScale.mmToIU( 0.2 ) + ii * 100, pcbIUScale.mmToIU( 0.4 ) );
+            int      width = pcbIUScale.mmToIU( 0.1 ) + ( ii % 16 ) * 100;
+
+            aPlotter.FlashPadRect( pos, size, ANGLE_0, FILLED, nullptr );
+            aPlotter.FlashPadCircle( pos, size.x, FILLED, nullptr );
+            aPlotter.ThickSegment( pos, pos + VECTOR2I( size.x, size.y ), width, FILLED, nullptr );
+        }
+    }
+
+    aPlotter.EndPlot();
+    ::wxRemoveFile( filename );
+}
+
+
+/**
+ * List of available benchmarks
+ */
+static std::vector<BENCHMARK> benchmarkList =
+{
+    { 's', bench_size_apertures, "Size apertures lookup" },
+    { 'p', bench_poly_apertures, "Polygon apertures lookup" },
+    { 'f', bench_plot, "Plot to file" },
+};
+
+
+/**
+ * Construct string of all flags used for specifying benchmarks on the command line
+ */
+static wxString getBenchFlags()
+{
+    wxString flags;
+
+    for( BENCHMARK& bmark : benchmarkList )
+        flags << bmark.triggerChar;
+
+    return flags;
+}
+
+
+/**
+ * Usage description of a benchmark spec
+ */
+static wxString getBenchDescriptions()
+{
+    wxString desc;
+
+    for( BENCHMARK& bmark : benchmarkList )
+        desc << "    " << bmark.triggerChar << ": " << bmark.name << "\n";
+
+    return desc;
+}
+
+
+static BENCH_REPORT executeBenchMark( const BENCHMARK& aBenchmark, int aCount, int aReps )
+{
+    BENCH_REPORT   report = {};
+    GERBER_PLOTTER plotter;
+
+    plotter.SetViewport( VECTOR2I( 0, 0 ), pcbIUScale.IU_PER_MILS / 10, 1.0, false );
+    plotter.SetGerberCoordinatesFormat( 6 );
+
+    TIME_PT start = CLOCK::now();
+    aBenchmark.func( plotter, aCount, aReps, report );
+    TIME_PT end = CLOCK::now();
+
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    report.benchDurMs = duration_cast<milliseconds>( end - start );
+
+    // A new aperture is given the next index, i.e. the number of apertures created so far
+    report.apertureCount = plotter.GetOrCreateAperture( VECTOR2I( 1, 1 ), 1, ANGLE_0,
+                                                        APERTURE::AT_PLOTTING, -1 );
+
+    return report;
+}
+
+
+int gerber_plot_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <APERTURES> <REPS> [" << getBenchFlags() << "]\n\n";
+        os << "Benchmarks:\n";
+        os << getBenchDescriptions();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long count = 0;
+    long reps = 0;
+    wxString( argv[1] ).ToLong( &count );
+    wxString( argv[2] ).ToLong( &reps );
+
+    // get the benchmark to do, or all of them if nothing given
+    wxString bench;
+
+    if( argc == 4 )
+        bench = argv[3];
+
+    os << "Gerber Plot Bench Mark Util" << std::endl;
+
+    os << "  Apertures:   " << (int) count << std::endl;
+    os << "  Repetitions: " << (int) reps << std::endl;
+    os << std::endl;
+
+    for( BENCHMARK& bmark : benchmarkList )
+    {
+        if( bench.size() && !bench.Contains( bmark.triggerChar ) )
+            continue;
+
+        BENCH_REPORT report = executeBenchMark( bmark, count, reps );
+
+        os << wxString::Format( "%-30s %u apertures, acc: %u in %u ms", bmark.name,
+                                report.apertureCount, report.dcodeAcc,
+                                (int) report.benchDurMs.count() )
+           << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "gerber_plot_benchmark",
+        "Benchmark the Gerber plotter aperture lookups and file output",
+        gerber_plot_benchmark_func,
+} );
@@ -22,6 +22,7 @@
  */
 
 #include <wx/wx.h>
+#include <dsnlexer.h>
 #include <richio.h>
 
 #include <chrono>
@@ -156,6 +157,48 @@ static void bench_line_reader_reuse( const wxFileName& aFile, int aReps, BENCH_R
 }
 
 
+/**
+ * Benchmark using MAPPED_FILE_LINE_READER::ReadLineView(), which returns lines
+ * straight from the mapped file without copying them.
+ * The reader is recreated (and the file remapped) for each cycle.
+ */
+static void bench_mapped_view( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    for( int i = 0; i < aReps; ++i)
+    {
+        MAPPED_FILE_LINE_READER fstr( aFile.GetFullPath() );
+
+        for( std::string_view line = fstr.ReadLineView(); !line.empty();
+             line = fstr.ReadLineView() )
+        {
+            report.linesRead++;
+            report.charAcc += (unsigned char) line[0];
+        }
+    }
+}
+
+
+/**
+ * Benchmark tokenizing the whole file with a DSNLEXER fed by a given LINE_READER
+ * implementation.  This is the s-expression parsers' view of the IO.
+ * The LINE_READER is recreated for each cycle.
+ */
+template<typename LR>
+static void bench_dsnlexer( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    for( int i = 0; i < aReps; ++i)
+    {
+        LR       fstr( aFile.GetFullPath() );
+        DSNLEXER lexer( nullptr, 0, nullptr, &fstr );
+
+        while( lexer.NextTok() != DSN_EOF )
+            report.charAcc += (unsigned char) lexer.CurView()[0];
+
+        report.linesRead += lexer.CurLineNumber() - 1;
+    }
+}
+
+
 /**
  * Benchmark using STRING_LINE_READER on string data read into memory from a file
  * using std::ifstream, but read the data fresh from the file each time
@@ -312,6 +355,11 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'F', bench_fstream_reuse, "std::fstream, reused" },
     { 'r', bench_line_reader<FILE_LINE_READER>, "RichIO FILE_L_R" },
     { 'R', bench_line_reader_reuse<FILE_LINE_READER>, "RichIO FILE_L_R, reused" },
+    { 'm', bench_line_reader<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_FILE_L_R" },
+    { 'M', bench_line_reader_reuse<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_FILE_L_R, reused" },
+    { 'v', bench_mapped_view, "RichIO MAPPED_FILE_L_R, views" },
+    { 'x', bench_dsnlexer<FILE_LINE_READER>, "DSNLEXER, FILE_L_R" },
+    { 'X', bench_dsnlexer<MAPPED_FILE_LINE_READER>, "DSNLEXER, MAPPED_FILE_L_R" },
     { 'n', bench_line_reader<IFSTREAM_LINE_READER>, "std::ifstream L_R" },
     { 'N', bench_line_reader_reuse<IFSTREAM_LINE_READER>, "std::ifstream L_R, reused" },
     { 's', bench_string_lr, "RichIO STRING_L_R"},
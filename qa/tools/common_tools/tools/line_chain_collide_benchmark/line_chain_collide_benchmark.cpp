@@ -0,0 +1,275 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/string.h>
+
+#include <geometry/shape_line_chain.h>
+#include <math/util.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+#include <qa_utils/utility_registry.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+struct BENCH_REPORT
+{
+    /// Number of queries which hit the chain, to prevent them being optimised away
+    unsigned hits;
+
+    std::chrono::milliseconds benchDurMs;
+};
+
+
+/**
+ * A benchmark runs aQueries queries against aChain.  aLinear selects the linear scans of
+ * SHAPE_LINE_CHAIN_BASE rather than the indexed queries of SHAPE_LINE_CHAIN.
+ */
+using BENCH_FUNC = std::function<void( const SHAPE_LINE_CHAIN&, int, bool, BENCH_REPORT& )>;
+
+
+struct BENCHMARK
+{
+    char       triggerChar;
+    BENCH_FUNC func;
+    wxString   name;
+};
+
+
+/**
+ * A closed outline with aCount vertices and an irregular radius, like a zone outline.
+ */
+static SHAPE_LINE_CHAIN benchChain( int aCount )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aCount;
+        double radius = 1e8 + 4e7 * ( ( ii * 7919 ) % 101 ) / 100.0;
+
+        chain.Append( VECTOR2I( KiROUND( radius * cos( angle ) ),
+                                KiROUND( radius * sin( angle ) ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+/**
+ * The aIdx-th query point, spread over the bounding box of the chain.
+ */
+static VECTOR2I benchPoint( int aIdx )
+{
+    return VECTOR2I( int( ( aIdx * 7001LL ) % 300000 ) * 1000 - 150000000,
+                     int( ( aIdx * 3001LL ) % 300000 ) * 1000 - 150000000 );
+}
+
+
+static void bench_point_inside( const SHAPE_LINE_CHAIN& aChain, int aQueries, bool aLinear,
+                                BENCH_REPORT& aReport )
+{
+    const SHAPE_LINE_CHAIN_BASE& base = aChain;
+
+    for( int ii = 0; ii < aQueries; ++ii )
+    {
+        VECTOR2I pt = benchPoint( ii );
+
+        if( aLinear ? base.SHAPE_LINE_CHAIN_BASE::PointInside( pt ) : aChain.PointInside( pt ) )
+            aReport.hits++;
+    }
+}
+
+
+static void bench_collide_point( const SHAPE_LINE_CHAIN& aChain, int aQueries, bool aLinear,
+                                 BENCH_REPORT& aReport )
+{
+    const SHAPE_LINE_CHAIN_BASE& base = aChain;
+    int                          actual;
+
+    for( int ii = 0; ii < aQueries; ++ii )
+    {
+        VECTOR2I pt = benchPoint( ii );
+        bool     hit = aLinear ? base.SHAPE_LINE_CHAIN_BASE::Collide( pt, 200000, &actual )
+                               : aChain.Collide( pt, 200000, &actual );
+
+        if( hit )
+            aReport.hits++;
+    }
+}
+
+
+static void bench_collide_seg( const SHAPE_LINE_CHAIN& aChain, int aQueries, bool aLinear,
+                               BENCH_REPORT& aReport )
+{
+    const SHAPE_LINE_CHAIN_BASE& base = aChain;
+    int                          actual;
+
+    for( int ii = 0; ii < aQueries; ++ii )
+    {
+        VECTOR2I pt = benchPoint( ii );
+        SEG      seg( pt, pt + VECTOR2I( 500000, 250000 ) );
+        bool     hit = aLinear ? base.SHAPE_LINE_CHAIN_BASE::Collide( seg, 200000, &actual )
+                               : aChain.Collide( seg, 200000, &actual );
+
+        if( hit )
+            aReport.hits++;
+    }
+}
+
+
+static void bench_distance( const SHAPE_LINE_CHAIN& aChain, int aQueries, bool aLinear,
+                            BENCH_REPORT& aReport )
+{
+    const SHAPE_LINE_CHAIN_BASE& base = aChain;
+
+    for( int ii = 0; ii < aQueries; ++ii )
+    {
+        VECTOR2I    pt = benchPoint( ii );
+        SEG::ecoord dist = aLinear ? base.SHAPE_LINE_CHAIN_BASE::SquaredDistance( pt, true )
+                                   : aChain.SquaredDistance( pt, true );
+
+        if( dist < SEG::Square( 1000000 ) )
+            aReport.hits++;
+    }
+}
+
+
+/**
+ * List of available benchmarks
+ */
+static std::vector<BENCHMARK> benchmarkList =
+{
+    { 'i', bench_point_inside, "PointInside" },
+    { 'p', bench_collide_point, "Collide point" },
+    { 's', bench_collide_seg, "Collide segment" },
+    { 'd', bench_distance, "SquaredDistance" },
+};
+
+
+/**
+ * Construct string of all flags used for specifying benchmarks on the command line
+ */
+static wxString getBenchFlags()
+{
+    wxString flags;
+
+    for( BENCHMARK& bmark : benchmarkList )
+        flags << bmark.triggerChar;
+
+    return flags;
+}
+
+
+/**
+ * Usage description of a benchmark spec
+ */
+static wxString getBenchDescriptions()
+{
+    wxString desc;
+
+    for( BENCHMARK& bmark : benchmarkList )
+        desc << "    " << bmark.triggerChar << ": " << bmark.name << "\n";
+
+    return desc;
+}
+
+
+static BENCH_REPORT executeBenchMark( const BENCHMARK& aBenchmark, const SHAPE_LINE_CHAIN& aChain,
+                                      int aQueries, bool aLinear )
+{
+    BENCH_REPORT report = {};
+
+    TIME_PT start = CLOCK::now();
+    aBenchmark.func( aChain, aQueries, aLinear, report );
+    TIME_PT end = CLOCK::now();
+
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    report.benchDurMs = duration_cast<milliseconds>( end - start );
+
+    return report;
+}
+
+
+int line_chain_collide_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <VERTICES> <QUERIES> [" << getBenchFlags() << "]\n\n";
+        os << "Benchmarks:\n";
+        os << getBenchDescriptions();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long vertices = 0;
+    long queries = 0;
+    wxString( argv[1] ).ToLong( &vertices );
+    wxString( argv[2] ).ToLong( &queries );
+
+    // get the benchmark to do, or all of them if nothing given
+    wxString bench;
+
+    if( argc == 4 )
+        bench = argv[3];
+
+    os << "Line Chain Collision Bench Mark Util" << std::endl;
+
+    os << "  Vertices: " << (int) vertices << std::endl;
+    os << "  Queries:  " << (int) queries << std::endl;
+    os << std::endl;
+
+    SHAPE_LINE_CHAIN chain = benchChain( vertices );
+
+    for( BENCHMARK& bmark : benchmarkList )
+    {
+        if( bench.size() && !bench.Contains( bmark.triggerChar ) )
+            continue;
+
+        BENCH_REPORT linear = executeBenchMark( bmark, chain, queries, true );
+        BENCH_REPORT indexed = executeBenchMark( bmark, chain, queries, false );
+
+        os << wxString::Format( "%-20s linear: %u hits in %u ms, indexed: %u hits in %u ms",
+                                bmark.name, linear.hits, (int) linear.benchDurMs.count(),
+                                indexed.hits, (int) indexed.benchDurMs.count() )
+           << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "line_chain_collide_benchmark",
+        "Benchmark the SHAPE_LINE_CHAIN collision queries against the linear scans",
+        line_chain_collide_benchmark_func,
+} );
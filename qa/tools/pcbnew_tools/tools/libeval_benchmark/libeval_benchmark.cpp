@@ -0,0 +1,223 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <pcbexpr_evaluator.h>
+#include <reporter.h>
+#include <core/profile.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_rule_condition.h>
+#include <drc/drc_rule_parser.h>
+
+#include <wx/cmdline.h>
+#include <wx/ffile.h>
+#include <wx/msgout.h>
+
+#include <iostream>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "n", "iterations", _( "item pairs evaluated per rule" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board file" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "custom rules file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum LIBEVAL_BENCHMARK_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * Time \a aIterations evaluations of \a aFunc over pairs drawn from \a aItems.
+ *
+ * @return the number of evaluations which returned true, so the caller can check that the
+ *         compared implementations agree.
+ */
+static int timePairs( const std::vector<BOARD_ITEM*>& aItems, long aIterations,
+                      const std::function<bool( BOARD_ITEM*, BOARD_ITEM* )>& aFunc,
+                      double& aMsecs )
+{
+    int        hits = 0;
+    PROF_TIMER timer;
+
+    for( long ii = 0; ii < aIterations; ++ii )
+    {
+        BOARD_ITEM* a = aItems[ ii % aItems.size() ];
+        BOARD_ITEM* b = aItems[ ( ii * 7 + 1 ) % aItems.size() ];
+
+        if( aFunc( a, b ) )
+            hits++;
+    }
+
+    aMsecs = timer.msecs();
+    return hits;
+}
+
+
+int libeval_benchmark_main( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "Compare the plain and optimized rule condition interpreters by "
+                               "evaluating the conditions of a custom rules file against the "
+                               "items of a board." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    long iterations = 100000;
+    cl_parser.Found( "iterations", &iterations );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            cl_parser.GetParam( 0 ).ToStdString() );
+
+    if( !board )
+        return LIBEVAL_BENCHMARK_RET_CODES::LOAD_FAILED;
+
+    std::vector<std::shared_ptr<DRC_RULE>> rules;
+    wxString                               rulesPath = cl_parser.GetParam( 1 );
+    wxFFile                                rulesFile( rulesPath, "rb" );
+    wxString                               rulesText;
+
+    if( !rulesFile.IsOpened() || !rulesFile.ReadAll( &rulesText ) )
+        return LIBEVAL_BENCHMARK_RET_CODES::LOAD_FAILED;
+
+    try
+    {
+        DRC_RULES_PARSER parser( rulesText, rulesPath );
+        parser.Parse( rules, &NULL_REPORTER::GetInstance() );
+    }
+    catch( const PARSE_ERROR& pe )
+    {
+        std::cerr << pe.What().ToStdString() << std::endl;
+        return LIBEVAL_BENCHMARK_RET_CODES::LOAD_FAILED;
+    }
+
+    std::vector<BOARD_ITEM*> items;
+
+    for( PCB_TRACK* track : board->Tracks() )
+        items.push_back( track );
+
+    for( FOOTPRINT* footprint : board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            items.push_back( pad );
+    }
+
+    if( items.empty() )
+        return LIBEVAL_BENCHMARK_RET_CODES::LOAD_FAILED;
+
+    double totalPlain = 0.0;
+    double totalOptimized = 0.0;
+    double totalCondition = 0.0;
+
+    for( const std::shared_ptr<DRC_RULE>& rule : rules )
+    {
+        if( !rule->m_Condition || rule->m_Condition->GetExpression().IsEmpty() )
+            continue;
+
+        wxString         expr = rule->m_Condition->GetExpression();
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    plain;
+        PCBEXPR_UCODE    optimized;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, F_Cu );
+
+        if( !compiler.Compile( expr, &plain, &preflightContext )
+                || !compiler.Compile( expr, &optimized, &preflightContext ) )
+        {
+            std::cerr << "Skipping rule '" << rule->m_Name.ToStdString()
+                      << "': condition failed to compile" << std::endl;
+            continue;
+        }
+
+        optimized.Optimize();
+
+        auto runUCode =
+                [&]( PCBEXPR_UCODE& aUCode )
+                {
+                    return [&aUCode]( BOARD_ITEM* a, BOARD_ITEM* b )
+                           {
+                               PCBEXPR_CONTEXT ctx( CLEARANCE_CONSTRAINT, F_Cu );
+                               ctx.SetItems( a, b );
+                               return aUCode.Run( &ctx )->AsDouble() != 0.0;
+                           };
+                };
+
+        double plainMs, optimizedMs, conditionMs;
+
+        int plainHits = timePairs( items, iterations, runUCode( plain ), plainMs );
+        int optimizedHits = timePairs( items, iterations, runUCode( optimized ), optimizedMs );
+
+        // The full condition path (as compiled by the parser): optimized ucode, both item
+        // orders, plus memoization
+        timePairs( items, iterations,
+                   [&]( BOARD_ITEM* a, BOARD_ITEM* b )
+                   {
+                       return rule->m_Condition->EvaluateFor( a, b, CLEARANCE_CONSTRAINT, F_Cu );
+                   },
+                   conditionMs );
+
+        std::cout << rule->m_Name.ToStdString() << ": " << expr.ToStdString() << std::endl;
+        std::cout << wxString::Format( "    plain %.2f ms, optimized %.2f ms, condition %.2f ms",
+                                       plainMs, optimizedMs, conditionMs ).ToStdString();
+
+        if( plainHits != optimizedHits )
+            std::cout << "  (MISMATCH: " << plainHits << " vs " << optimizedHits << ")";
+
+        std::cout << std::endl;
+
+        totalPlain += plainMs;
+        totalOptimized += optimizedMs;
+        totalCondition += conditionMs;
+    }
+
+    std::cout << wxString::Format( "Total: plain %.2f ms, optimized %.2f ms, condition %.2f ms",
+                                   totalPlain, totalOptimized, totalCondition ).ToStdString()
+              << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "libeval_benchmark",
+        "Benchmark custom rule condition evaluation against a board",
+        libeval_benchmark_main,
+} );
@@ -149,6 +149,14 @@ public:
                  const ELEMTYPE     a_max[NUMDIMS],
                  const DATATYPE&    a_dataId );
 
+    /// Bulk load entries using Sort-Tile-Recursive packing.  Any data already in the tree is
+    /// repacked together with the new entries.  This is much faster than inserting the entries
+    /// one at a time and produces fully packed nodes with little overlap.
+    /// Nodes are allocated from a single block, level by level, so that the children of each
+    /// node are adjacent in memory.  The tree may still be modified afterwards.
+    /// \param a_entries Bounding rects and data Ids to load
+    void BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries );
+
     /// Remove entry
     /// \param a_min Min of bounding rect
     /// \param a_max Max of bounding rect
@@ -605,6 +613,9 @@ protected:
 
     void    RemoveAllRec( Node* a_node ) const;
     void    Reset() const;
+    void    FreePackedNodes();
+    void    CollectBranches( const Node* a_node, std::vector<Branch>& a_branches ) const;
+    void    TileBranches( Branch* a_begin, Branch* a_end, int a_axis ) const;
     void    CountRec( const Node* a_node, int& a_count ) const;
 
     bool    SaveRec( const Node* a_node, RTFileStream& a_stream ) const;
@@ -612,6 +623,8 @@ protected:
 
     Node*           m_root;                         ///< Root of tree
     ELEMTYPEREAL    m_unitSphereVolume;             ///< Unit sphere constant for required number of dimensions
+    Node*           m_packedNodes;                  ///< Node block allocated by BulkLoad()
+    size_t          m_packedCount;                  ///< Number of nodes in m_packedNodes
 };
 
 
@@ -718,6 +731,9 @@ RTREE_TEMPLATE RTREE_QUAL::RTree()
         0.082146f, 0.046622f, 0.025807f,    // Dimension  18,19,20
     };
 
+    m_packedNodes = nullptr;
+    m_packedCount = 0;
+
     m_root = AllocNode();
     m_root->m_level     = 0;
     m_unitSphereVolume  = (ELEMTYPEREAL) UNIT_SPHERE_VOLUMES[NUMDIMS];
@@ -727,6 +743,7 @@ RTREE_TEMPLATE RTREE_QUAL::RTree()
 RTREE_TEMPLATE
 RTREE_QUAL::~RTree() {
     Reset(); // Free, or reset node memory
+    FreePackedNodes();
 }
 
 
@@ -756,6 +773,129 @@ void RTREE_QUAL::Insert( const ELEMTYPE     a_min[NUMDIMS],
 }
 
 
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries )
+{
+    std::vector<Branch> branches;
+
+    CollectBranches( m_root, branches );
+    branches.reserve( branches.size() + a_entries.size() );
+
+    for( const std::pair<Rect, DATATYPE>& entry : a_entries )
+    {
+        Branch branch;
+        branch.m_rect = entry.first;
+        branch.m_data = entry.second;
+        branches.push_back( branch );
+    }
+
+    Reset();
+    FreePackedNodes();
+
+    if( branches.empty() )
+    {
+        m_root = AllocNode();
+        m_root->m_level = 0;
+        return;
+    }
+
+    // Size the node block up front: every level needs ceil( n / MAXNODES ) nodes
+    for( size_t count = branches.size(); ; )
+    {
+        count = ( count + MAXNODES - 1 ) / MAXNODES;
+        m_packedCount += count;
+
+        if( count == 1 )
+            break;
+    }
+
+    m_packedNodes = new Node[m_packedCount];
+
+    size_t nextNode = 0;
+    int    level = 0;
+
+    for( ;; )
+    {
+        TileBranches( branches.data(), branches.data() + branches.size(), 0 );
+
+        size_t              total = branches.size();
+        size_t              nodeCount = ( total + MAXNODES - 1 ) / MAXNODES;
+        size_t              pos = 0;
+        std::vector<Branch> parents( nodeCount );
+
+        for( size_t ii = 0; ii < nodeCount; ++ii )
+        {
+            // Spread the branches evenly so that no node falls below MINNODES
+            size_t count = total / nodeCount + ( ii < total % nodeCount ? 1 : 0 );
+            Node*  node = &m_packedNodes[nextNode++];
+
+            InitNode( node );
+            node->m_level = level;
+
+            for( size_t jj = 0; jj < count; ++jj )
+                node->m_branch[node->m_count++] = branches[pos++];
+
+            parents[ii].m_rect = NodeCover( node );
+            parents[ii].m_child = node;
+        }
+
+        if( nodeCount == 1 )
+        {
+            m_root = parents[0].m_child;
+            break;
+        }
+
+        branches = std::move( parents );
+        ++level;
+    }
+
+    ASSERT( nextNode == m_packedCount );
+}
+
+
+RTREE_TEMPLATE
+void RTREE_QUAL::CollectBranches( const Node* a_node, std::vector<Branch>& a_branches ) const
+{
+    ASSERT( a_node );
+    ASSERT( a_node->m_level >= 0 );
+
+    for( int index = 0; index < a_node->m_count; ++index )
+    {
+        if( a_node->IsInternalNode() )
+            CollectBranches( a_node->m_branch[index].m_child, a_branches );
+        else
+            a_branches.push_back( a_node->m_branch[index] );
+    }
+}
+
+
+// Sort-Tile-Recursive ordering: sort by the centre along one axis, cut the run into slabs
+// holding a whole number of nodes and repeat along the next axis within each slab.
+RTREE_TEMPLATE
+void RTREE_QUAL::TileBranches( Branch* a_begin, Branch* a_end, int a_axis ) const
+{
+    std::sort( a_begin, a_end,
+               [a_axis]( const Branch& a, const Branch& b )
+               {
+                   // Sum in ELEMTYPEREAL as the integer extents may overflow
+                   return (ELEMTYPEREAL) a.m_rect.m_min[a_axis] + a.m_rect.m_max[a_axis]
+                          < (ELEMTYPEREAL) b.m_rect.m_min[a_axis] + b.m_rect.m_max[a_axis];
+               } );
+
+    if( a_axis == NUMDIMS - 1 )
+        return;
+
+    size_t count = a_end - a_begin;
+    size_t nodeCount = ( count + MAXNODES - 1 ) / MAXNODES;
+    size_t slabCount = (size_t) std::ceil( std::pow( (double) nodeCount,
+                                                     1.0 / ( NUMDIMS - a_axis ) ) );
+    size_t slabSize = MAXNODES * ( ( nodeCount + slabCount - 1 ) / slabCount );
+
+    for( size_t start = 0; start < count; start += slabSize )
+        TileBranches( a_begin + start, a_begin + std::min( start + slabSize, count ), a_axis + 1 );
+}
+
+
 RTREE_TEMPLATE
 bool RTREE_QUAL::Remove( const ELEMTYPE     a_min[NUMDIMS],
                          const ELEMTYPE     a_max[NUMDIMS],
@@ -1120,6 +1260,7 @@ void RTREE_QUAL::RemoveAll()
 {
     // Delete all existing nodes
     Reset();
+    FreePackedNodes();
 
     m_root = AllocNode();
     m_root->m_level = 0;
@@ -1139,6 +1280,15 @@ void RTREE_QUAL::Reset() const
 }
 
 
+RTREE_TEMPLATE
+void RTREE_QUAL::FreePackedNodes()
+{
+    delete[] m_packedNodes;
+    m_packedNodes = nullptr;
+    m_packedCount = 0;
+}
+
+
 RTREE_TEMPLATE
 void RTREE_QUAL::RemoveAllRec( Node* a_node ) const
 {
@@ -1177,6 +1327,13 @@ void RTREE_QUAL::FreeNode( Node* a_node ) const
 {
     ASSERT( a_node );
 
+    // Nodes created by BulkLoad() live in m_packedNodes and are released with it
+    if( m_packedNodes && !std::less<const Node*>()( a_node, m_packedNodes )
+            && std::less<const Node*>()( a_node, m_packedNodes + m_packedCount ) )
+    {
+        return;
+    }
+
 #ifdef RTREE_DONT_USE_MEMPOOLS
     delete a_node;
 #else       // RTREE_DONT_USE_MEMPOOLS